@@ -0,0 +1,327 @@
+#include "samplecodec.h"
+
+#include <QTest>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace {
+
+// Every encoded field of @p info in wire order, links included up to linkCount.
+std::vector<uint64_t> wireFields(const Nl80211StationInfo &info)
+{
+    std::vector<uint64_t> fields;
+    SampleCodec::forEachField(info, [&fields](const auto &field) {
+        fields.push_back(static_cast<uint64_t>(static_cast<int64_t>(field)));
+    });
+    for (int link = 0; link < info.linkCount; ++link) {
+        SampleCodec::forEachLinkField(info.links[link], [&fields](const auto &field) {
+            fields.push_back(static_cast<uint64_t>(static_cast<int64_t>(field)));
+        });
+    }
+    return fields;
+}
+
+Nl80211StationInfo fullSample()
+{
+    Nl80211StationInfo info;
+    info.valid = true;
+    info.signalDbm = -48;
+    info.signalAvgDbm = -50;
+    info.chainCount = 2;
+    info.chainSignal[0] = -49;
+    info.chainSignal[1] = -53;
+    info.chainSignalAvg[0] = -50;
+    info.chainSignalAvg[1] = -54;
+    info.rxBitrate = 24019;
+    info.txBitrate = 17294;
+    info.rxMcs = 11;
+    info.txMcs = 9;
+    info.rxNss = 2;
+    info.txNss = 2;
+    info.rxChannelWidth = 3;
+    info.txChannelWidth = 3;
+    info.rxMode = Nl80211StationInfo::WifiMode::HE;
+    info.txMode = Nl80211StationInfo::WifiMode::HE;
+    info.rxGuardInterval = Nl80211StationInfo::GuardInterval::Gi0_8;
+    info.txGuardInterval = Nl80211StationInfo::GuardInterval::Gi1_6;
+    info.rxBytes = 123456789;
+    info.txBytes = 23456789;
+    info.rxPackets = 98765;
+    info.txPackets = 45678;
+    info.txRetries = 321;
+    info.txFailed = 4;
+    info.beaconRx = 1000;
+    info.connectedTime = 3600;
+    info.inactiveTime = 12;
+    info.hasAckSignal = true;
+    info.ackSignal = -47;
+    info.ackSignalAvg = -48;
+    return info;
+}
+
+Nl80211StationInfo::Link link(uint8_t id, uint32_t frequencyMhz, int32_t signalDbm)
+{
+    Nl80211StationInfo::Link link;
+    link.linkId = id;
+    link.address[0] = 0x02;
+    link.address[5] = id;
+    link.frequencyMhz = frequencyMhz;
+    link.signalDbm = signalDbm;
+    link.signalAvgDbm = signalDbm - 1;
+    link.rxBitrate = 28823;
+    link.txBitrate = 20000;
+    link.rxMcs = 13;
+    link.txMcs = 11;
+    link.rxNss = 2;
+    link.txNss = 2;
+    link.rxChannelWidth = 5;
+    link.txChannelWidth = 5;
+    link.rxMode = Nl80211StationInfo::WifiMode::EHT;
+    link.txMode = Nl80211StationInfo::WifiMode::EHT;
+    link.rxBytes = 1000000;
+    link.txBytes = 500000;
+    link.rxPackets = 1000;
+    link.txPackets = 500;
+    return link;
+}
+
+// Encodes @p samples one second apart with @p keyframeInterval, decodes them
+// back and checks every record reproduces its sample. Returns the stream.
+std::vector<uint8_t> roundTrip(const std::vector<Nl80211StationInfo> &samples, int keyframeInterval = 60)
+{
+    std::vector<uint8_t> stream(samples.size() * SampleCodec::maxRecordSize);
+    SampleCodec::Encoder encoder(keyframeInterval);
+    size_t size = 0;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        size += encoder.encode(1000000 * (i + 1), samples[i], stream.data() + size);
+    }
+    stream.resize(size);
+
+    SampleCodec::Decoder decoder;
+    size_t offset = 0;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        uint64_t timestampUs = 0;
+        Nl80211StationInfo decoded;
+        const size_t used = decoder.decode(stream.data() + offset, stream.size() - offset, timestampUs, decoded);
+        if (used == 0) {
+            qWarning("decode failed at record %zu", i);
+            return {};
+        }
+        offset += used;
+        if (timestampUs != 1000000 * (i + 1) || wireFields(decoded) != wireFields(samples[i])) {
+            qWarning("record %zu does not round-trip", i);
+            return {};
+        }
+    }
+    if (offset != stream.size()) {
+        qWarning("%zu bytes left over", stream.size() - offset);
+        return {};
+    }
+    return stream;
+}
+
+} // namespace
+
+class SampleCodecTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void varint();
+    void keyframesAndDeltas();
+    void joinAtKeyframe();
+    void counterWrapAndRegression();
+    void missingFields();
+    void mloLinks();
+    void truncatedRecord();
+};
+
+void SampleCodecTest::varint()
+{
+    const uint64_t values[] = {0, 1, 127, 128, 300, uint64_t(1) << 35, std::numeric_limits<uint64_t>::max()};
+    for (uint64_t value : values) {
+        uint8_t buffer[10];
+        const size_t written = SampleCodec::writeVarint(buffer, value);
+        uint64_t read = 0;
+        QCOMPARE(SampleCodec::readVarint(buffer, written, read), written);
+        QCOMPARE(read, value);
+        QCOMPARE(SampleCodec::readVarint(buffer, written - 1, read), size_t(0));
+    }
+    for (int64_t value : {int64_t(0), int64_t(-1), int64_t(1), std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()}) {
+        QCOMPARE(SampleCodec::zigzagDecode(SampleCodec::zigzagEncode(value)), value);
+    }
+}
+
+void SampleCodecTest::keyframesAndDeltas()
+{
+    std::vector<Nl80211StationInfo> samples;
+    Nl80211StationInfo info = fullSample();
+    for (int i = 0; i < 10; ++i) {
+        info.rxBytes += 1500000;
+        info.txBytes += 300000;
+        info.rxPackets += 1000;
+        info.signalDbm = -48 - (i % 3);
+        samples.push_back(info);
+    }
+
+    const std::vector<uint8_t> stream = roundTrip(samples, 4);
+    QVERIFY(!stream.empty());
+
+    // Records 0, 4 and 8 are keyframes; a delta record of a steady link is
+    // far smaller than a keyframe.
+    SampleCodec::Encoder encoder(4);
+    uint8_t record[SampleCodec::maxRecordSize];
+    size_t keyframeSize = 0;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        const size_t size = encoder.encode(1000000 * (i + 1), samples[i], record);
+        QCOMPARE(bool(record[0] & SampleCodec::keyframeFlag), i % 4 == 0);
+        if (i == 0) {
+            keyframeSize = size;
+        } else if (i % 4 != 0) {
+            QVERIFY(size < keyframeSize / 2);
+        }
+    }
+}
+
+void SampleCodecTest::joinAtKeyframe()
+{
+    SampleCodec::Encoder encoder(3);
+    std::vector<std::vector<uint8_t>> records;
+    std::vector<Nl80211StationInfo> samples;
+    Nl80211StationInfo info = fullSample();
+    for (int i = 0; i < 6; ++i) {
+        info.rxBytes += 1000 * i;
+        samples.push_back(info);
+        std::vector<uint8_t> record(SampleCodec::maxRecordSize);
+        record.resize(encoder.encode(1000000 * (i + 1), info, record.data()));
+        records.push_back(record);
+    }
+
+    // A decoder joining part-way through skips deltas until a keyframe.
+    SampleCodec::Decoder decoder;
+    uint64_t timestampUs = 0;
+    Nl80211StationInfo decoded;
+    QCOMPARE(decoder.decode(records[1].data(), records[1].size(), timestampUs, decoded), size_t(0));
+    QCOMPARE(decoder.decode(records[2].data(), records[2].size(), timestampUs, decoded), size_t(0));
+    for (int i = 3; i < 6; ++i) {
+        QCOMPARE(decoder.decode(records[i].data(), records[i].size(), timestampUs, decoded), records[i].size());
+        QCOMPARE(timestampUs, uint64_t(1000000 * (i + 1)));
+        QVERIFY(wireFields(decoded) == wireFields(samples[i]));
+    }
+}
+
+void SampleCodecTest::counterWrapAndRegression()
+{
+    Nl80211StationInfo info = fullSample();
+    std::vector<Nl80211StationInfo> samples;
+
+    info.rxBytes = std::numeric_limits<uint64_t>::max() - 1000;
+    info.rxPackets = std::numeric_limits<uint32_t>::max() - 5;
+    samples.push_back(info);
+    // 64- and 32-bit counters wrap.
+    info.rxBytes += 5000;
+    info.rxPackets += 10;
+    samples.push_back(info);
+    // The driver resets its counters, e.g. after a reassociation.
+    info.txBytes = 0;
+    info.txPackets = 0;
+    info.txRetries = 0;
+    info.connectedTime = 1;
+    samples.push_back(info);
+    // Values that fall: signal drops by 40 dB, rates collapse.
+    info.signalDbm = -88;
+    info.rxBitrate = 65;
+    info.rxMcs = 0;
+    info.rxNss = 1;
+    samples.push_back(info);
+
+    QVERIFY(!roundTrip(samples).empty());
+}
+
+void SampleCodecTest::missingFields()
+{
+    std::vector<Nl80211StationInfo> samples;
+    // A failed query, then a full sample, then one without the optional
+    // attributes (no chains, no ACK signal, unknown rates).
+    samples.push_back(Nl80211StationInfo{});
+    samples.push_back(fullSample());
+    Nl80211StationInfo sparse;
+    sparse.valid = true;
+    sparse.signalDbm = -61;
+    sparse.rxBytes = 200000000;
+    samples.push_back(sparse);
+    samples.push_back(fullSample());
+
+    QVERIFY(!roundTrip(samples).empty());
+}
+
+void SampleCodecTest::mloLinks()
+{
+    std::vector<Nl80211StationInfo> samples;
+    Nl80211StationInfo info = fullSample();
+    info.linkCount = 2;
+    info.links[0] = link(0, 5955, -45);
+    info.links[1] = link(1, 5200, -58);
+    samples.push_back(info);
+
+    // Traffic on both links.
+    info.links[0].rxBytes += 3000000;
+    info.links[1].txBytes += 700000;
+    samples.push_back(info);
+
+    // A third link comes up.
+    info.linkCount = 3;
+    info.links[2] = link(2, 2437, -67);
+    samples.push_back(info);
+
+    // Two drop, the survivor moves into slot 0 with different fields.
+    info.linkCount = 1;
+    info.links[0] = link(2, 2437, -70);
+    samples.push_back(info);
+
+    // Back to a single-link association.
+    info.linkCount = 0;
+    samples.push_back(info);
+
+    // All links at once.
+    info.linkCount = Nl80211StationInfo::maxLinks;
+    for (int i = 0; i < Nl80211StationInfo::maxLinks; ++i) {
+        info.links[i] = link(static_cast<uint8_t>(i), 5180 + 20 * i, -50 - i);
+    }
+    samples.push_back(info);
+
+    QVERIFY(!roundTrip(samples).empty());
+    QVERIFY(!roundTrip(samples, 2).empty());
+}
+
+void SampleCodecTest::truncatedRecord()
+{
+    SampleCodec::Encoder encoder;
+    uint8_t first[SampleCodec::maxRecordSize];
+    uint8_t second[SampleCodec::maxRecordSize];
+    Nl80211StationInfo info = fullSample();
+    info.linkCount = 1;
+    info.links[0] = link(0, 5955, -45);
+    const size_t firstSize = encoder.encode(1000000, info, first);
+    info.rxBytes += 12345;
+    info.links[0].rxBytes += 6789;
+    const size_t secondSize = encoder.encode(2000000, info, second);
+
+    SampleCodec::Decoder decoder;
+    uint64_t timestampUs = 0;
+    Nl80211StationInfo decoded;
+    QCOMPARE(decoder.decode(first, firstSize, timestampUs, decoded), firstSize);
+    // A cut-off record is rejected and must not disturb the decoder state.
+    for (size_t size = 0; size < secondSize; ++size) {
+        QCOMPARE(decoder.decode(second, size, timestampUs, decoded), size_t(0));
+    }
+    QCOMPARE(decoder.decode(second, secondSize, timestampUs, decoded), secondSize);
+    QCOMPARE(timestampUs, uint64_t(2000000));
+    QVERIFY(wireFields(decoded) == wireFields(info));
+}
+
+QTEST_GUILESS_MAIN(SampleCodecTest)
+
+#include "samplecodectest.moc"
@@ -0,0 +1,139 @@
+#include "statsbackend.h"
+#include "wifimonitor.h"
+
+#include <QTest>
+
+#include <cstdint>
+#include <memory>
+
+#ifdef __GLIBC__
+// Heap allocation counter. Defining malloc, calloc and realloc here routes
+// every such call in the process, Qt and libnl included, through the counter
+// before glibc's allocator. Only the test thread is counted: the D-Bus thread
+// started by PowerMonitor allocates on its own schedule.
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+}
+
+namespace {
+thread_local bool t_counting = false;
+thread_local quint64 t_allocations = 0;
+}
+
+extern "C" void *malloc(size_t size)
+{
+    t_allocations += t_counting ? 1 : 0;
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size)
+{
+    t_allocations += t_counting ? 1 : 0;
+    return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *ptr, size_t size)
+{
+    t_allocations += t_counting ? 1 : 0;
+    return __libc_realloc(ptr, size);
+}
+#endif
+
+namespace {
+
+/**
+ * A steady link: every field filled, nothing changing but the traffic
+ * counters, so the detectors stay quiet and no link events are published.
+ */
+class SteadyBackend : public StatsBackend
+{
+public:
+    [[nodiscard]] const char *name() const override { return "steady"; }
+    [[nodiscard]] uint32_t fields() const override { return AllFields; }
+    [[nodiscard]] QString lastError() const override { return {}; }
+
+    [[nodiscard]] Nl80211StationInfo sample(const char *, const uint8_t *) override
+    {
+        Nl80211StationInfo info;
+        info.valid = true;
+        info.signalDbm = -52;
+        info.signalAvgDbm = -52;
+        info.chainCount = 2;
+        info.chainSignal[0] = -54;
+        info.chainSignal[1] = -55;
+        info.rxBitrate = 12010;
+        info.txBitrate = 8647;
+        info.rxMcs = 11;
+        info.txMcs = 9;
+        info.rxNss = 2;
+        info.txNss = 2;
+        info.rxChannelWidth = 2;
+        info.txChannelWidth = 2;
+        info.rxMode = Nl80211StationInfo::WifiMode::HE;
+        info.txMode = Nl80211StationInfo::WifiMode::HE;
+        info.rxBytes = m_bytes += 1500000;
+        info.txBytes = m_bytes / 4;
+        info.rxPackets = static_cast<uint32_t>(m_bytes / 1500);
+        info.txPackets = static_cast<uint32_t>(m_bytes / 6000);
+        return info;
+    }
+
+private:
+    uint64_t m_bytes = 0;
+};
+
+// Reads what QML binds to after each tick, dropping each copy again like a
+// binding that re-evaluates.
+void readProperties(const WifiMonitor &monitor)
+{
+    (void)monitor.snapshot();
+    (void)monitor.rxChart();
+    (void)monitor.txChart();
+    (void)monitor.rxHistory();
+    (void)monitor.txHistory();
+    (void)monitor.chartMaxRate();
+}
+
+} // namespace
+
+class TickAllocationTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void steadyTickAllocatesNothing();
+};
+
+void TickAllocationTest::steadyTickAllocatesNothing()
+{
+#ifndef __GLIBC__
+    QSKIP("Counting allocations needs glibc");
+#else
+    WifiMonitor monitor(std::make_unique<SteadyBackend>(), 1000, 0);
+    monitor.setChartColumns(300);
+
+    // Warm-up: fills the one-minute windows and the chart ring, after which
+    // the storage they use has reached its final size.
+    for (int i = 0; i < 4 * monitor.historySize(); ++i) {
+        monitor.sampleNow();
+        readProperties(monitor);
+    }
+
+    constexpr int ticks = 1000;
+    t_allocations = 0;
+    t_counting = true;
+    for (int i = 0; i < ticks; ++i) {
+        monitor.sampleNow();
+        readProperties(monitor);
+    }
+    t_counting = false;
+
+    QCOMPARE(t_allocations, quint64(0));
+#endif
+}
+
+QTEST_GUILESS_MAIN(TickAllocationTest)
+
+#include "tickallocationtest.moc"
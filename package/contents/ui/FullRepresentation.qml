@@ -22,18 +22,23 @@ PlasmaExtras.Representation {
     collapseMarginsHint: true
 
     property bool isConnected: WifiMonitor.connected
+    // One consistent copy of the per-tick statistics
+    readonly property var snapshot: WifiMonitor.snapshot
 
     // Shared width for left-side labels (column 1) across all sections
     property real leftLabelWidth: Math.max(
         rxLabelMetrics.width,
         mcsLabelMetrics.width,
+        maxLabelMetrics.width,
+        radioLabelMetrics.width,
         freqLabelMetrics.width,
         rxBytesLabelMetrics.width,
         rxPktsLabelMetrics.width,
         retriesLabelMetrics.width,
         droppedLabelMetrics.width,
         ackSigLabelMetrics.width,
-        rxTimeLabelMetrics.width
+        rxTimeLabelMetrics.width,
+        chainsLabelMetrics.width
     ) + Kirigami.Units.smallSpacing
 
     // Shared width for right-side labels (column 3) across all sections
@@ -41,13 +46,16 @@ PlasmaExtras.Representation {
     property real rightLabelWidth: Math.max(
         txLabelMetrics.width,
         mimoLabelMetrics.width,
+        effLabelMetrics.width,
+        upToLabelMetrics.width,
         securityLabelMetrics.width,
         txBytesLabelMetrics.width,
         txPktsLabelMetrics.width,
         failedLabelMetrics.width,
         bcnLossLabelMetrics.width,
         ackAvgLabelMetrics.width,
-        txTimeLabelMetrics.width
+        txTimeLabelMetrics.width,
+        imbalanceLabelMetrics.width
     ) + Kirigami.Units.smallSpacing
 
     // Fixed width for value columns (column 2 and 4) to ensure consistent centerline
@@ -63,6 +71,8 @@ PlasmaExtras.Representation {
     // TextMetrics for all left-side labels (column 1)
     TextMetrics { id: rxLabelMetrics; text: i18nc("Receive rate label", "RX"); font.pointSize: Kirigami.Theme.smallFont.pointSize }
     TextMetrics { id: mcsLabelMetrics; text: i18nc("Modulation coding scheme", "MCS"); font.pointSize: Kirigami.Theme.smallFont.pointSize }
+    TextMetrics { id: maxLabelMetrics; text: i18nc("Maximum PHY rate for the negotiated link", "Max"); font.pointSize: Kirigami.Theme.smallFont.pointSize }
+    TextMetrics { id: radioLabelMetrics; text: i18nc("Local radio capabilities", "Radio"); font.pointSize: Kirigami.Theme.smallFont.pointSize }
     TextMetrics { id: freqLabelMetrics; text: i18nc("Radio frequency", "Freq"); font.pointSize: Kirigami.Theme.smallFont.pointSize }
     TextMetrics { id: rxBytesLabelMetrics; text: i18nc("Received bytes", "RX Bytes"); font.pointSize: Kirigami.Theme.smallFont.pointSize }
     TextMetrics { id: rxPktsLabelMetrics; text: i18nc("Received packets", "RX Pkts"); font.pointSize: Kirigami.Theme.smallFont.pointSize }
@@ -70,10 +80,13 @@ PlasmaExtras.Representation {
     TextMetrics { id: droppedLabelMetrics; text: i18nc("Dropped packets", "Dropped"); font.pointSize: Kirigami.Theme.smallFont.pointSize }
     TextMetrics { id: ackSigLabelMetrics; text: i18nc("ACK signal strength", "ACK Sig"); font.pointSize: Kirigami.Theme.smallFont.pointSize }
     TextMetrics { id: rxTimeLabelMetrics; text: i18nc("Receive duration", "RX Time"); font.pointSize: Kirigami.Theme.smallFont.pointSize }
+    TextMetrics { id: chainsLabelMetrics; text: i18nc("Per-antenna chain signal", "Chains"); font.pointSize: Kirigami.Theme.smallFont.pointSize }
 
     // TextMetrics for all right-side labels (column 3)
     TextMetrics { id: txLabelMetrics; text: i18nc("Transmit rate label", "TX"); font.pointSize: Kirigami.Theme.smallFont.pointSize }
     TextMetrics { id: mimoLabelMetrics; text: i18nc("MIMO spatial streams", "MIMO"); font.pointSize: Kirigami.Theme.smallFont.pointSize }
+    TextMetrics { id: effLabelMetrics; text: i18nc("Link efficiency, current rate as share of maximum", "Eff."); font.pointSize: Kirigami.Theme.smallFont.pointSize }
+    TextMetrics { id: upToLabelMetrics; text: i18nc("Maximum rate the local radio supports", "Up to"); font.pointSize: Kirigami.Theme.smallFont.pointSize }
     TextMetrics { id: securityLabelMetrics; text: i18nc("Security protocol", "Security"); font.pointSize: Kirigami.Theme.smallFont.pointSize }
     TextMetrics { id: txBytesLabelMetrics; text: i18nc("Transmitted bytes", "TX Bytes"); font.pointSize: Kirigami.Theme.smallFont.pointSize }
     TextMetrics { id: txPktsLabelMetrics; text: i18nc("Transmitted packets", "TX Pkts"); font.pointSize: Kirigami.Theme.smallFont.pointSize }
@@ -81,6 +94,7 @@ PlasmaExtras.Representation {
     TextMetrics { id: bcnLossLabelMetrics; text: i18nc("Beacon loss count", "Bcn Loss"); font.pointSize: Kirigami.Theme.smallFont.pointSize }
     TextMetrics { id: ackAvgLabelMetrics; text: i18nc("ACK signal average", "ACK Avg"); font.pointSize: Kirigami.Theme.smallFont.pointSize }
     TextMetrics { id: txTimeLabelMetrics; text: i18nc("Transmit duration", "TX Time"); font.pointSize: Kirigami.Theme.smallFont.pointSize }
+    TextMetrics { id: imbalanceLabelMetrics; text: i18nc("Chain signal imbalance", "Imbalance"); font.pointSize: Kirigami.Theme.smallFont.pointSize }
 
     function formatBytes(bytes: real): string {
         var b = bytes || 0;
@@ -104,6 +118,41 @@ PlasmaExtras.Representation {
         return "***.***.***.***";
     }
 
+    function linkMetricName(metric: string): string {
+        switch (metric) {
+        case "signal": return i18nc("Link event metric", "Signal");
+        case "retryRatio": return i18nc("Link event metric", "Retry ratio");
+        case "beaconLoss": return i18nc("Link event metric", "Beacon loss");
+        case "ackSignal": return i18nc("Link event metric", "ACK signal");
+        }
+        return metric;
+    }
+
+    function timelineText(event: var): string {
+        switch (event.kind) {
+        case "connected": return i18nc("Timeline event", "Connected to %1 (%2 MHz)", event.detail, event.value);
+        case "roamed": return i18nc("Timeline event", "Roamed to %1 (%2 MHz)", event.detail, event.value);
+        case "disconnected": return i18nc("Timeline event", "Disconnected");
+        case "availability": return event.value ? i18nc("Timeline event", "Adapter available") : i18nc("Timeline event", "Adapter unavailable");
+        case "samplingMode": return i18nc("Timeline event", "Sampling: %1", event.detail);
+        case "wiphyChanged": return i18nc("Timeline event", "Radio %1 changed", event.value);
+        case "interfaceChanged": return i18nc("Timeline event", "Interface %1 changed", event.value);
+        case "error": return i18nc("Timeline event", "Error: %1", event.detail);
+        case "linkEvent": return event.value ? i18nc("Timeline event", "%1 degraded", linkMetricName(event.detail))
+                                             : i18nc("Timeline event", "%1 recovered", linkMetricName(event.detail));
+        case "sample": return i18nc("Timeline event", "%1 dBm, %2 retries", event.value, event.value2);
+        // value: 0 stopped, 1 ready, 2 backing off
+        case "session": return event.value === 2
+            ? i18nc("Timeline event", "nl80211 unavailable (%1), retry in %2 s", event.detail, Math.ceil(event.value2 / 1000))
+            : event.value === 1 ? i18nc("Timeline event", "nl80211 ready") : i18nc("Timeline event", "nl80211 stopped");
+        // value: 1 started (value2 interval ms), 0 finished (value2 samples)
+        case "burst": return event.value
+            ? i18nc("Timeline event", "Burst capture started (%1, every %2 ms)", event.detail, event.value2)
+            : i18nc("Timeline event", "Burst capture finished, %1 samples", event.value2);
+        }
+        return event.kind;
+    }
+
     function formatNumber(num: real): string {
         var n = num || 0;
         if (n >= 1000000000) return i18n("%1M", (n / 1000000).toLocaleString(Qt.locale(), 'f', 1));
@@ -125,7 +174,7 @@ PlasmaExtras.Representation {
 
             // Disconnected placeholder
             PlasmaExtras.PlaceholderMessage {
-                visible: !fullRoot.isConnected
+                visible: !fullRoot.isConnected && !WifiMonitor.hostingStations
                 Layout.fillWidth: true
                 Layout.fillHeight: true
                 Layout.minimumHeight: Kirigami.Units.gridUnit * 8
@@ -157,7 +206,7 @@ PlasmaExtras.Representation {
                     PlasmaComponents3.Label {
                         id: genLabel
                         anchors.centerIn: parent
-                        text: WifiMonitor.wifiGeneration
+                        text: fullRoot.snapshot.wifiGeneration
                         font.pointSize: Kirigami.Theme.smallFont.pointSize
                         color: Kirigami.Theme.highlightedTextColor
                     }
@@ -177,27 +226,29 @@ PlasmaExtras.Representation {
                     spacing: Kirigami.Units.largeSpacing
 
                     PlasmaComponents3.Label {
-                        text: i18n("%1 dBm", WifiMonitor.signalDbm)
-                        color: WifiMonitor.statusColor
+                        text: i18n("%1 dBm", fullRoot.snapshot.signalDbm)
+                        color: fullRoot.snapshot.statusColor
                         font.bold: true
                     }
 
                     PlasmaComponents3.Label {
-                        text: WifiMonitor.signalQuality
-                        color: WifiMonitor.statusColor
+                        text: fullRoot.snapshot.signalQuality
+                        color: fullRoot.snapshot.statusColor
                     }
 
                     Item { Layout.fillWidth: true }
 
                     PlasmaComponents3.Label {
                         visible: Plasmoid.configuration.showChannelInfo
-                        text: i18n("%1 MHz", WifiMonitor.channelWidth)
+                        text: i18n("%1 MHz", fullRoot.snapshot.channelWidth)
                         opacity: 0.75
                     }
 
                     PlasmaComponents3.Label {
                         visible: Plasmoid.configuration.showChannelInfo
-                        text: i18nc("WiFi channel number", "CH %1", WifiMonitor.channel)
+                        text: WifiMonitor.band
+                              ? i18nc("WiFi channel number and band", "CH %1 · %2", WifiMonitor.channel, WifiMonitor.band)
+                              : i18nc("WiFi channel number", "CH %1", WifiMonitor.channel)
                         opacity: 0.75
                     }
                 }
@@ -224,6 +275,25 @@ PlasmaExtras.Representation {
                         font.bold: true
                     }
 
+                    PlasmaComponents3.ComboBox {
+                        textRole: "text"
+                        valueRole: "value"
+                        model: [
+                            { text: i18nc("Chart time span", "1 min"), value: WifiMonitor.ChartMinute },
+                            { text: i18nc("Chart time span", "1 hour"), value: WifiMonitor.ChartHour },
+                            { text: i18nc("Chart time span", "24 hours"), value: WifiMonitor.ChartDay },
+                            { text: i18nc("Chart time span", "Last burst"), value: WifiMonitor.ChartBurst }
+                        ]
+                        Component.onCompleted: {
+                            WifiMonitor.chartWindow = Plasmoid.configuration.chartWindow
+                            currentIndex = indexOfValue(WifiMonitor.chartWindow)
+                        }
+                        onActivated: {
+                            WifiMonitor.chartWindow = currentValue
+                            Plasmoid.configuration.chartWindow = currentValue
+                        }
+                    }
+
                     Item { Layout.fillWidth: true }
 
                     Rectangle {
@@ -256,14 +326,20 @@ PlasmaExtras.Representation {
                 Canvas {
                     id: rateChart
 
-                    property var rxData: WifiMonitor.rxHistory
-                    property var txData: WifiMonitor.txHistory
-                    property real maxRate: WifiMonitor.maxHistoryRate
+                    // Flattened [x, y, ...] pairs, already reduced to one or two points per pixel column.
+                    property var rxData: WifiMonitor.rxChart
+                    property var txData: WifiMonitor.txChart
+                    property real maxRate: WifiMonitor.chartMaxRate
                     property bool paintScheduled: false
+                    // Plot width in pixels: the canvas minus the axis labels and right padding.
+                    readonly property int plotColumns: Math.max(1, Math.floor(width - 40))
 
                     Layout.fillWidth: true
                     Layout.fillHeight: true
 
+                    onPlotColumnsChanged: WifiMonitor.chartColumns = plotColumns
+                    Component.onCompleted: WifiMonitor.chartColumns = plotColumns
+
                     function schedulePaint(): void {
                         if (paintScheduled) return;
                         paintScheduled = true;
@@ -316,18 +392,16 @@ PlasmaExtras.Representation {
                     }
 
                     function drawLine(ctx: var, data: var, color: color, leftPadding: real, chartWidth: real, chartHeight: real, maxRate: real, topPadding: real): void {
-                        if (!data || data.length < 2 || !maxRate || maxRate <= 0) return;
+                        if (!data || data.length < 4 || !maxRate || maxRate <= 0) return;
 
                         ctx.strokeStyle = color;
                         ctx.lineWidth = 2;
                         ctx.lineJoin = "round";
                         ctx.lineCap = "round";
                         ctx.beginPath();
-                        var denom = Math.max(1, data.length - 1);
-                        var step = chartWidth / denom;
-                        for (var j = 0; j < data.length; j++) {
-                            var x = leftPadding + j * step;
-                            var y = topPadding + chartHeight - (data[j] / maxRate) * chartHeight;
+                        for (var j = 0; j + 1 < data.length; j += 2) {
+                            var x = leftPadding + data[j] * chartWidth;
+                            var y = topPadding + chartHeight - (data[j + 1] / maxRate) * chartHeight;
                             if (j === 0)
                                 ctx.moveTo(x, y);
                             else
@@ -340,12 +414,12 @@ PlasmaExtras.Representation {
 
             // Rate details section
             Kirigami.Separator {
-                visible: fullRoot.isConnected && (Plasmoid.configuration.showRxTxRate || Plasmoid.configuration.showMcs || Plasmoid.configuration.showMimo)
+                visible: fullRoot.isConnected && (Plasmoid.configuration.showRxTxRate || Plasmoid.configuration.showMcs || Plasmoid.configuration.showMimo || Plasmoid.configuration.showLinkEfficiency)
                 Layout.fillWidth: true
             }
 
             GridLayout {
-                visible: fullRoot.isConnected && (Plasmoid.configuration.showRxTxRate || Plasmoid.configuration.showMcs || Plasmoid.configuration.showMimo)
+                visible: fullRoot.isConnected && (Plasmoid.configuration.showRxTxRate || Plasmoid.configuration.showMcs || Plasmoid.configuration.showMimo || Plasmoid.configuration.showLinkEfficiency)
                 Layout.fillWidth: true
                 Layout.margins: Kirigami.Units.smallSpacing
                 columns: 4
@@ -363,7 +437,7 @@ PlasmaExtras.Representation {
 
                 PlasmaComponents3.Label {
                     visible: Plasmoid.configuration.showRxTxRate
-                    text: i18n("%1 Mbps", WifiMonitor.rxRate.toFixed(1))
+                    text: i18n("%1 Mbps", fullRoot.snapshot.rxRate.toFixed(1))
                     font.bold: true
                     Layout.preferredWidth: fullRoot.valueColumnWidth
                 }
@@ -378,7 +452,7 @@ PlasmaExtras.Representation {
 
                 PlasmaComponents3.Label {
                     visible: Plasmoid.configuration.showRxTxRate
-                    text: i18n("%1 Mbps", WifiMonitor.txRate.toFixed(1))
+                    text: i18n("%1 Mbps", fullRoot.snapshot.txRate.toFixed(1))
                     font.bold: true
                     Layout.fillWidth: true
                 }
@@ -394,7 +468,7 @@ PlasmaExtras.Representation {
 
                 PlasmaComponents3.Label {
                     visible: Plasmoid.configuration.showMcs
-                    text: WifiMonitor.mcsIndex.toString()
+                    text: fullRoot.snapshot.mcsIndex.toString()
                     font.bold: true
                     Layout.preferredWidth: fullRoot.valueColumnWidth
                 }
@@ -409,12 +483,74 @@ PlasmaExtras.Representation {
 
                 PlasmaComponents3.Label {
                     visible: Plasmoid.configuration.showMimo
-                    text: WifiMonitor.mimoStreams > 0 ? i18n("%1x%1", WifiMonitor.mimoStreams) : "N/A"
+                    text: fullRoot.snapshot.mimoStreams > 0 ? i18n("%1x%1", fullRoot.snapshot.mimoStreams) : "N/A"
                     font.bold: true
                     Layout.fillWidth: true
                 }
 
-                // Row 3: Freq / Security
+                // Row 3: theoretical max rate / efficiency
+                PlasmaComponents3.Label {
+                    visible: Plasmoid.configuration.showLinkEfficiency
+                    text: i18nc("Maximum PHY rate for the negotiated link", "Max")
+                    font.pointSize: Kirigami.Theme.smallFont.pointSize
+                    opacity: 0.6
+                    Layout.preferredWidth: fullRoot.leftLabelWidth
+                }
+
+                PlasmaComponents3.Label {
+                    visible: Plasmoid.configuration.showLinkEfficiency
+                    text: fullRoot.snapshot.rxMaxRate > 0 ? i18n("%1 Mbps", fullRoot.snapshot.rxMaxRate.toFixed(0)) : i18n("N/A")
+                    Layout.preferredWidth: fullRoot.valueColumnWidth
+                }
+
+                PlasmaComponents3.Label {
+                    visible: Plasmoid.configuration.showLinkEfficiency
+                    text: i18nc("Link efficiency, current rate as share of maximum", "Eff.")
+                    font.pointSize: Kirigami.Theme.smallFont.pointSize
+                    opacity: 0.6
+                    Layout.preferredWidth: fullRoot.rightLabelWidth
+                }
+
+                PlasmaComponents3.Label {
+                    visible: Plasmoid.configuration.showLinkEfficiency
+                    text: fullRoot.snapshot.linkEfficiency > 0 ? i18n("%1%", Math.round(fullRoot.snapshot.linkEfficiency * 100)) : i18n("N/A")
+                    color: fullRoot.snapshot.belowCapability ? Kirigami.Theme.neutralTextColor : Kirigami.Theme.textColor
+                    font.bold: fullRoot.snapshot.belowCapability
+                    Layout.fillWidth: true
+                }
+
+                // Row 4: what the local radio could negotiate on this band
+                PlasmaComponents3.Label {
+                    visible: Plasmoid.configuration.showLinkEfficiency && WifiMonitor.clientMaxNss > 0
+                    text: i18nc("Local radio capabilities", "Radio")
+                    font.pointSize: Kirigami.Theme.smallFont.pointSize
+                    opacity: 0.6
+                    Layout.preferredWidth: fullRoot.leftLabelWidth
+                }
+
+                PlasmaComponents3.Label {
+                    visible: Plasmoid.configuration.showLinkEfficiency && WifiMonitor.clientMaxNss > 0
+                    text: i18nc("Radio generation, spatial streams, channel width", "%1 · %2x%2 · %3 MHz",
+                                WifiMonitor.clientMaxGeneration, WifiMonitor.clientMaxNss, WifiMonitor.clientMaxWidth)
+                    elide: Text.ElideRight
+                    Layout.preferredWidth: fullRoot.valueColumnWidth
+                }
+
+                PlasmaComponents3.Label {
+                    visible: Plasmoid.configuration.showLinkEfficiency && WifiMonitor.clientMaxNss > 0
+                    text: i18nc("Maximum rate the local radio supports", "Up to")
+                    font.pointSize: Kirigami.Theme.smallFont.pointSize
+                    opacity: 0.6
+                    Layout.preferredWidth: fullRoot.rightLabelWidth
+                }
+
+                PlasmaComponents3.Label {
+                    visible: Plasmoid.configuration.showLinkEfficiency && WifiMonitor.clientMaxNss > 0
+                    text: i18n("%1 Mbps", WifiMonitor.clientMaxRate.toFixed(0))
+                    Layout.fillWidth: true
+                }
+
+                // Row 5: Freq / Security
                 PlasmaComponents3.Label {
                     text: i18nc("Radio frequency", "Freq")
                     font.pointSize: Kirigami.Theme.smallFont.pointSize
@@ -464,7 +600,7 @@ PlasmaExtras.Representation {
                 }
 
                 PlasmaComponents3.Label {
-                    text: fullRoot.formatBytes(WifiMonitor.rxBytes)
+                    text: fullRoot.formatBytes(fullRoot.snapshot.rxBytes)
                     Layout.preferredWidth: fullRoot.valueColumnWidth
                 }
 
@@ -476,7 +612,7 @@ PlasmaExtras.Representation {
                 }
 
                 PlasmaComponents3.Label {
-                    text: fullRoot.formatBytes(WifiMonitor.txBytes)
+                    text: fullRoot.formatBytes(fullRoot.snapshot.txBytes)
                     Layout.fillWidth: true
                 }
 
@@ -489,7 +625,7 @@ PlasmaExtras.Representation {
                 }
 
                 PlasmaComponents3.Label {
-                    text: fullRoot.formatNumber(WifiMonitor.rxPackets)
+                    text: fullRoot.formatNumber(fullRoot.snapshot.rxPackets)
                     Layout.preferredWidth: fullRoot.valueColumnWidth
                 }
 
@@ -501,7 +637,7 @@ PlasmaExtras.Representation {
                 }
 
                 PlasmaComponents3.Label {
-                    text: fullRoot.formatNumber(WifiMonitor.txPackets)
+                    text: fullRoot.formatNumber(fullRoot.snapshot.txPackets)
                     Layout.fillWidth: true
                 }
             }
@@ -529,7 +665,7 @@ PlasmaExtras.Representation {
                 }
 
                 PlasmaComponents3.Label {
-                    text: fullRoot.formatNumber(WifiMonitor.txRetries)
+                    text: fullRoot.formatNumber(fullRoot.snapshot.txRetries)
                     Layout.preferredWidth: fullRoot.valueColumnWidth
                 }
 
@@ -541,8 +677,8 @@ PlasmaExtras.Representation {
                 }
 
                 PlasmaComponents3.Label {
-                    text: fullRoot.formatNumber(WifiMonitor.txFailed)
-                    color: (WifiMonitor.txFailed || 0) > 0 ? Kirigami.Theme.negativeTextColor : Kirigami.Theme.textColor
+                    text: fullRoot.formatNumber(fullRoot.snapshot.txFailed)
+                    color: (fullRoot.snapshot.txFailed || 0) > 0 ? Kirigami.Theme.negativeTextColor : Kirigami.Theme.textColor
                     Layout.fillWidth: true
                 }
 
@@ -555,8 +691,8 @@ PlasmaExtras.Representation {
                 }
 
                 PlasmaComponents3.Label {
-                    text: fullRoot.formatNumber(WifiMonitor.rxDropped)
-                    color: (WifiMonitor.rxDropped || 0) > 0 ? Kirigami.Theme.negativeTextColor : Kirigami.Theme.textColor
+                    text: fullRoot.formatNumber(fullRoot.snapshot.rxDropped)
+                    color: (fullRoot.snapshot.rxDropped || 0) > 0 ? Kirigami.Theme.negativeTextColor : Kirigami.Theme.textColor
                     Layout.preferredWidth: fullRoot.valueColumnWidth
                 }
 
@@ -569,9 +705,426 @@ PlasmaExtras.Representation {
 
                 PlasmaComponents3.Label {
                     opacity: Plasmoid.configuration.showBeaconStats ? 1 : 0
-                    text: fullRoot.formatNumber(WifiMonitor.beaconLoss)
-                    color: (WifiMonitor.beaconLoss || 0) > 0 ? Kirigami.Theme.negativeTextColor : Kirigami.Theme.textColor
+                    text: fullRoot.formatNumber(fullRoot.snapshot.beaconLoss)
+                    color: (fullRoot.snapshot.beaconLoss || 0) > 0 ? Kirigami.Theme.negativeTextColor : Kirigami.Theme.textColor
+                    Layout.fillWidth: true
+                }
+            }
+
+            // Wi-Fi 7 multi-link operation: one row per affiliated link
+            Kirigami.Separator {
+                visible: fullRoot.isConnected && WifiMonitor.mloLinks.count > 0
+                Layout.fillWidth: true
+            }
+
+            ColumnLayout {
+                visible: fullRoot.isConnected && WifiMonitor.mloLinks.count > 0
+                Layout.fillWidth: true
+                Layout.margins: Kirigami.Units.smallSpacing
+                spacing: Kirigami.Units.smallSpacing
+
+                PlasmaComponents3.Label {
+                    text: i18np("Multi-link: %1 link, %2 Mbps combined", "Multi-link: %1 links, %2 Mbps combined",
+                                WifiMonitor.mloLinks.count, fullRoot.snapshot.rxRate.toFixed(0))
+                    font.bold: true
+                    Layout.fillWidth: true
+                }
+
+                Repeater {
+                    model: WifiMonitor.mloLinks
+
+                    delegate: RowLayout {
+                        id: linkRow
+
+                        required property string band
+                        required property int channel
+                        required property int signal
+                        required property real rxRate
+                        required property real txRate
+                        required property int channelWidth
+                        required property real rxShare
+
+                        Layout.fillWidth: true
+                        spacing: Kirigami.Units.largeSpacing
+
+                        PlasmaComponents3.Label {
+                            text: linkRow.band.length > 0
+                                ? i18nc("MLO link band and channel", "%1 ch %2", linkRow.band, linkRow.channel)
+                                : i18nc("MLO link with unknown channel", "Link")
+                            font.pointSize: Kirigami.Theme.smallFont.pointSize
+                            Layout.fillWidth: true
+                        }
+
+                        PlasmaComponents3.Label {
+                            text: i18nc("Signal strength in dBm", "%1 dBm", linkRow.signal)
+                            font.pointSize: Kirigami.Theme.smallFont.pointSize
+                        }
+
+                        PlasmaComponents3.Label {
+                            text: i18nc("Link receive/transmit rate", "%1/%2 Mbps", linkRow.rxRate.toFixed(0), linkRow.txRate.toFixed(0))
+                            font.pointSize: Kirigami.Theme.smallFont.pointSize
+                        }
+
+                        PlasmaComponents3.Label {
+                            text: i18nc("Channel width and share of combined RX rate", "%1 MHz, %2%", linkRow.channelWidth, Math.round(linkRow.rxShare * 100))
+                            font.pointSize: Kirigami.Theme.smallFont.pointSize
+                            opacity: 0.6
+                        }
+                    }
+                }
+            }
+
+            // Associated stations (AP, mesh and P2P-GO interfaces)
+            Kirigami.Separator {
+                visible: WifiMonitor.hostingStations
+                Layout.fillWidth: true
+            }
+
+            ColumnLayout {
+                visible: WifiMonitor.hostingStations
+                Layout.fillWidth: true
+                Layout.margins: Kirigami.Units.smallSpacing
+                spacing: Kirigami.Units.smallSpacing
+
+                RowLayout {
+                    Layout.fillWidth: true
+
+                    PlasmaComponents3.Label {
+                        text: i18np("%1 Station", "%1 Stations", WifiMonitor.stations.count)
+                        font.bold: true
+                        Layout.fillWidth: true
+                    }
+
+                    PlasmaComponents3.ComboBox {
+                        textRole: "text"
+                        valueRole: "value"
+                        model: [
+                            { text: i18nc("Sort stations by", "Signal"), value: "signal" },
+                            { text: i18nc("Sort stations by", "RX rate"), value: "rxRate" },
+                            { text: i18nc("Sort stations by", "TX rate"), value: "txRate" },
+                            { text: i18nc("Sort stations by", "Traffic"), value: "rxBytes" },
+                            { text: i18nc("Sort stations by", "Inactive"), value: "inactiveTime" },
+                            { text: i18nc("Sort stations by", "MAC"), value: "mac" }
+                        ]
+                        Component.onCompleted: currentIndex = indexOfValue(WifiMonitor.stations.sortRole)
+                        onActivated: {
+                            // Best first: strongest/fastest at the top, least idle at the top.
+                            WifiMonitor.stations.sortOrder = (currentValue === "mac" || currentValue === "inactiveTime")
+                                ? Qt.AscendingOrder : Qt.DescendingOrder
+                            WifiMonitor.stations.sortRole = currentValue
+                        }
+                    }
+                }
+
+                // ListView rather than a Repeater so only visible rows get delegates on busy APs.
+                ListView {
+                    Layout.fillWidth: true
+                    Layout.preferredHeight: Math.min(contentHeight, Kirigami.Units.gridUnit * 10)
+                    clip: true
+                    interactive: contentHeight > height
+                    model: WifiMonitor.stations
+
+                    delegate: RowLayout {
+                        id: stationRow
+
+                        required property string mac
+                        required property int signal
+                        required property real rxRate
+                        required property real txRate
+                        required property string generation
+
+                        width: ListView.view.width
+                        spacing: Kirigami.Units.largeSpacing
+
+                        PlasmaComponents3.Label {
+                            text: stationRow.mac
+                            font.family: "monospace"
+                            font.pointSize: Kirigami.Theme.smallFont.pointSize
+                            elide: Text.ElideRight
+                            Layout.fillWidth: true
+                        }
+
+                        PlasmaComponents3.Label {
+                            text: i18nc("Signal strength in dBm", "%1 dBm", stationRow.signal)
+                            font.pointSize: Kirigami.Theme.smallFont.pointSize
+                        }
+
+                        PlasmaComponents3.Label {
+                            text: i18nc("Station receive/transmit rate", "%1/%2 Mbps", stationRow.rxRate.toFixed(0), stationRow.txRate.toFixed(0))
+                            font.pointSize: Kirigami.Theme.smallFont.pointSize
+                        }
+
+                        PlasmaComponents3.Label {
+                            text: stationRow.generation
+                            font.pointSize: Kirigami.Theme.smallFont.pointSize
+                            opacity: 0.6
+                        }
+                    }
+                }
+            }
+
+            // Link events section
+            Kirigami.Separator {
+                visible: fullRoot.isConnected && Plasmoid.configuration.showLinkEvents
+                Layout.fillWidth: true
+            }
+
+            ColumnLayout {
+                visible: fullRoot.isConnected && Plasmoid.configuration.showLinkEvents
+                Layout.fillWidth: true
+                Layout.margins: Kirigami.Units.smallSpacing
+                spacing: Kirigami.Units.smallSpacing
+
+                PlasmaComponents3.Label {
+                    text: i18n("Link Events")
+                    font.bold: true
+                }
+
+                PlasmaComponents3.Label {
+                    visible: WifiMonitor.linkEvents.length === 0
+                    text: i18n("No degradation detected")
+                    font.pointSize: Kirigami.Theme.smallFont.pointSize
+                    opacity: 0.6
+                }
+
+                Repeater {
+                    model: WifiMonitor.linkEvents.slice(0, 5)
+
+                    delegate: RowLayout {
+                        id: eventRow
+
+                        required property var modelData
+
+                        Layout.fillWidth: true
+                        spacing: Kirigami.Units.largeSpacing
+
+                        PlasmaComponents3.Label {
+                            text: new Date(eventRow.modelData.timestamp).toLocaleTimeString(Qt.locale(), Locale.ShortFormat)
+                            font.pointSize: Kirigami.Theme.smallFont.pointSize
+                            opacity: 0.6
+                        }
+
+                        PlasmaComponents3.Label {
+                            text: fullRoot.linkMetricName(eventRow.modelData.metric)
+                            Layout.fillWidth: true
+                        }
+
+                        PlasmaComponents3.Label {
+                            text: eventRow.modelData.degraded ? i18nc("Link event", "Degraded") : i18nc("Link event", "Recovered")
+                            color: eventRow.modelData.degraded ? Kirigami.Theme.negativeTextColor : Kirigami.Theme.positiveTextColor
+                        }
+                    }
+                }
+            }
+
+            // Rate occupancy section
+            Kirigami.Separator {
+                visible: fullRoot.isConnected && Plasmoid.configuration.showRateOccupancy
+                Layout.fillWidth: true
+            }
+
+            ColumnLayout {
+                id: occupancySection
+
+                // Only read the property while the section is shown.
+                readonly property var occupancy: visible ? WifiMonitor.rateOccupancy : ({})
+                property bool showTx: false
+                readonly property var rows: (showTx ? occupancy.tx : occupancy.rx) || []
+                // Scale the colour to the busiest cell so a spread-out link still shows contrast.
+                readonly property real maxShare: {
+                    var max = 0;
+                    for (var i = 0; i < rows.length; ++i) {
+                        for (var j = 0; j < rows[i].cells.length; ++j) {
+                            max = Math.max(max, rows[i].cells[j]);
+                        }
+                    }
+                    return max;
+                }
+                readonly property real cellSize: Kirigami.Units.gridUnit * 0.75
+
+                visible: fullRoot.isConnected && Plasmoid.configuration.showRateOccupancy
+                Layout.fillWidth: true
+                Layout.margins: Kirigami.Units.smallSpacing
+                spacing: Kirigami.Units.smallSpacing
+
+                RowLayout {
+                    Layout.fillWidth: true
+
+                    PlasmaComponents3.Label {
+                        text: i18n("Rate Occupancy")
+                        font.bold: true
+                        Layout.fillWidth: true
+                    }
+
+                    PlasmaComponents3.ToolButton {
+                        text: i18nc("Receive rate label", "RX")
+                        checkable: true
+                        checked: !occupancySection.showTx
+                        onClicked: occupancySection.showTx = false
+                    }
+
+                    PlasmaComponents3.ToolButton {
+                        text: i18nc("Transmit rate label", "TX")
+                        checkable: true
+                        checked: occupancySection.showTx
+                        onClicked: occupancySection.showTx = true
+                    }
+
+                    PlasmaComponents3.ToolButton {
+                        icon.name: "edit-clear-history"
+                        display: PlasmaComponents3.AbstractButton.IconOnly
+                        text: i18n("Reset")
+                        onClicked: WifiMonitor.resetRateOccupancy()
+                        PlasmaComponents3.ToolTip.text: text
+                        PlasmaComponents3.ToolTip.visible: hovered
+                    }
+                }
+
+                PlasmaComponents3.Label {
+                    visible: occupancySection.rows.length === 0
+                    text: i18n("No rates recorded yet")
+                    font.pointSize: Kirigami.Theme.smallFont.pointSize
+                    opacity: 0.6
+                }
+
+                GridLayout {
+                    visible: occupancySection.rows.length > 0
+                    columns: 18
+                    columnSpacing: 1
+                    rowSpacing: 1
+
+                    // Header: MCS indices
+                    PlasmaComponents3.Label {
+                        text: i18nc("Rate occupancy row header", "MCS")
+                        font.pointSize: Kirigami.Theme.smallFont.pointSize
+                        opacity: 0.6
+                        Layout.rightMargin: Kirigami.Units.smallSpacing
+                    }
+
+                    Repeater {
+                        model: 16
+
+                        delegate: PlasmaComponents3.Label {
+                            required property int index
+
+                            text: index
+                            horizontalAlignment: Text.AlignHCenter
+                            font.pointSize: Kirigami.Theme.smallFont.pointSize * 0.8
+                            opacity: 0.6
+                            Layout.preferredWidth: occupancySection.cellSize
+                        }
+                    }
+
+                    Item { Layout.fillWidth: true }
+
+                    Repeater {
+                        model: occupancySection.rows
+
+                        delegate: Repeater {
+                            id: occupancyRow
+
+                            required property var modelData
+
+                            // Row label, 16 cells, share of time: one grid row.
+                            model: 18
+
+                            delegate: Loader {
+                                id: occupancyCell
+
+                                required property int index
+
+                                sourceComponent: index === 0 ? rowLabel : index === 17 ? rowShare : cell
+
+                                Component {
+                                    id: rowLabel
+
+                                    PlasmaComponents3.Label {
+                                        text: i18nc("Rate occupancy row: generation, width, streams", "%1 %2 MHz %3×%3",
+                                                    occupancyRow.modelData.mode, occupancyRow.modelData.width,
+                                                    occupancyRow.modelData.nss)
+                                        font.pointSize: Kirigami.Theme.smallFont.pointSize
+                                        rightPadding: Kirigami.Units.smallSpacing
+                                    }
+                                }
+
+                                Component {
+                                    id: cell
+
+                                    Rectangle {
+                                        readonly property real share: occupancyRow.modelData.cells[occupancyCell.index - 1]
+
+                                        implicitWidth: occupancySection.cellSize
+                                        implicitHeight: occupancySection.cellSize
+                                        color: share > 0 ? Kirigami.Theme.highlightColor : Kirigami.Theme.alternateBackgroundColor
+                                        opacity: share > 0 ? 0.2 + 0.8 * share / occupancySection.maxShare : 1.0
+                                    }
+                                }
+
+                                Component {
+                                    id: rowShare
+
+                                    PlasmaComponents3.Label {
+                                        text: i18nc("Share of time", "%1%", (occupancyRow.modelData.share * 100).toFixed(0))
+                                        font.pointSize: Kirigami.Theme.smallFont.pointSize
+                                        opacity: 0.6
+                                        leftPadding: Kirigami.Units.smallSpacing
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Event timeline section
+            Kirigami.Separator {
+                visible: Plasmoid.configuration.showTimeline
+                Layout.fillWidth: true
+            }
+
+            ColumnLayout {
+                visible: Plasmoid.configuration.showTimeline
+                Layout.fillWidth: true
+                Layout.margins: Kirigami.Units.smallSpacing
+                spacing: Kirigami.Units.smallSpacing
+
+                PlasmaComponents3.Label {
+                    text: i18n("Event Timeline")
+                    font.bold: true
+                }
+
+                ListView {
+                    id: timelineView
+
                     Layout.fillWidth: true
+                    Layout.preferredHeight: Kirigami.Units.gridUnit * 8
+                    clip: true
+                    // Only read the property while the section is shown.
+                    model: Plasmoid.configuration.showTimeline ? WifiMonitor.timeline : []
+
+                    delegate: RowLayout {
+                        id: timelineRow
+
+                        required property var modelData
+
+                        width: timelineView.width
+                        spacing: Kirigami.Units.largeSpacing
+
+                        PlasmaComponents3.Label {
+                            text: new Date(timelineRow.modelData.timestamp).toLocaleTimeString(Qt.locale(), "HH:mm:ss")
+                            font.pointSize: Kirigami.Theme.smallFont.pointSize
+                            opacity: 0.6
+                        }
+
+                        PlasmaComponents3.Label {
+                            text: fullRoot.timelineText(timelineRow.modelData)
+                            elide: Text.ElideRight
+                            font.pointSize: Kirigami.Theme.smallFont.pointSize
+                            color: timelineRow.modelData.kind === "error" ? Kirigami.Theme.negativeTextColor : Kirigami.Theme.textColor
+                            opacity: timelineRow.modelData.kind === "sample" && timelineRow.modelData.value2 === 0 ? 0.5 : 1.0
+                            Layout.fillWidth: true
+                        }
+                    }
                 }
             }
 
@@ -598,19 +1151,19 @@ PlasmaExtras.Representation {
 
                 PlasmaComponents3.Label {
                     visible: Plasmoid.configuration.showConnectedTime
-                    text: fullRoot.formatDuration(WifiMonitor.connectedTime)
+                    text: fullRoot.formatDuration(fullRoot.snapshot.connectedTime)
                 }
 
                 PlasmaComponents3.Label {
-                    visible: Plasmoid.configuration.showExpectedThroughput && WifiMonitor.expectedThroughput > 0
+                    visible: Plasmoid.configuration.showExpectedThroughput && fullRoot.snapshot.expectedThroughput > 0
                     text: i18n("Expected")
                     font.pointSize: Kirigami.Theme.smallFont.pointSize
                     opacity: 0.6
                 }
 
                 PlasmaComponents3.Label {
-                    visible: Plasmoid.configuration.showExpectedThroughput && WifiMonitor.expectedThroughput > 0
-                    text: i18n("%1 Mbps", (WifiMonitor.expectedThroughput / 1000).toFixed(1))
+                    visible: Plasmoid.configuration.showExpectedThroughput && fullRoot.snapshot.expectedThroughput > 0
+                    text: i18n("%1 Mbps", (fullRoot.snapshot.expectedThroughput / 1000).toFixed(1))
                 }
 
                 PlasmaComponents3.Label {
@@ -687,12 +1240,12 @@ PlasmaExtras.Representation {
 
             // Advanced section
             Kirigami.Separator {
-                visible: fullRoot.isConnected && (Plasmoid.configuration.showAckSignal || Plasmoid.configuration.showAirtime)
+                visible: fullRoot.isConnected && (Plasmoid.configuration.showAckSignal || Plasmoid.configuration.showAirtime || Plasmoid.configuration.showChainSignal)
                 Layout.fillWidth: true
             }
 
             GridLayout {
-                visible: fullRoot.isConnected && (Plasmoid.configuration.showAckSignal || Plasmoid.configuration.showAirtime)
+                visible: fullRoot.isConnected && (Plasmoid.configuration.showAckSignal || Plasmoid.configuration.showAirtime || Plasmoid.configuration.showChainSignal)
                 Layout.fillWidth: true
                 Layout.margins: Kirigami.Units.smallSpacing
                 columns: 4
@@ -701,7 +1254,7 @@ PlasmaExtras.Representation {
 
                 // Row 1: ACK Sig / ACK Avg
                 PlasmaComponents3.Label {
-                    visible: Plasmoid.configuration.showAckSignal && WifiMonitor.hasAckSignal
+                    visible: Plasmoid.configuration.showAckSignal && fullRoot.snapshot.hasAckSignal
                     text: i18nc("ACK signal strength", "ACK Sig")
                     font.pointSize: Kirigami.Theme.smallFont.pointSize
                     opacity: 0.6
@@ -709,13 +1262,13 @@ PlasmaExtras.Representation {
                 }
 
                 PlasmaComponents3.Label {
-                    visible: Plasmoid.configuration.showAckSignal && WifiMonitor.hasAckSignal
-                    text: i18n("%1 dBm", WifiMonitor.ackSignal)
+                    visible: Plasmoid.configuration.showAckSignal && fullRoot.snapshot.hasAckSignal
+                    text: i18n("%1 dBm", fullRoot.snapshot.ackSignal)
                     Layout.preferredWidth: fullRoot.valueColumnWidth
                 }
 
                 PlasmaComponents3.Label {
-                    visible: Plasmoid.configuration.showAckSignal && WifiMonitor.hasAckSignal
+                    visible: Plasmoid.configuration.showAckSignal && fullRoot.snapshot.hasAckSignal
                     text: i18nc("ACK signal average", "ACK Avg")
                     font.pointSize: Kirigami.Theme.smallFont.pointSize
                     opacity: 0.6
@@ -723,14 +1276,14 @@ PlasmaExtras.Representation {
                 }
 
                 PlasmaComponents3.Label {
-                    visible: Plasmoid.configuration.showAckSignal && WifiMonitor.hasAckSignal
-                    text: i18n("%1 dBm", WifiMonitor.ackSignalAvg)
+                    visible: Plasmoid.configuration.showAckSignal && fullRoot.snapshot.hasAckSignal
+                    text: i18n("%1 dBm", fullRoot.snapshot.ackSignalAvg)
                     Layout.fillWidth: true
                 }
 
                 // Row 2: RX Time / TX Time (hidden if driver doesn't support)
                 PlasmaComponents3.Label {
-                    visible: Plasmoid.configuration.showAirtime && (WifiMonitor.rxDuration > 0 || WifiMonitor.txDuration > 0)
+                    visible: Plasmoid.configuration.showAirtime && (fullRoot.snapshot.rxDuration > 0 || fullRoot.snapshot.txDuration > 0)
                     text: i18nc("Receive duration", "RX Time")
                     font.pointSize: Kirigami.Theme.smallFont.pointSize
                     opacity: 0.6
@@ -738,13 +1291,13 @@ PlasmaExtras.Representation {
                 }
 
                 PlasmaComponents3.Label {
-                    visible: Plasmoid.configuration.showAirtime && (WifiMonitor.rxDuration > 0 || WifiMonitor.txDuration > 0)
-                    text: i18n("%1 ms", (WifiMonitor.rxDuration / 1000).toFixed(0))
+                    visible: Plasmoid.configuration.showAirtime && (fullRoot.snapshot.rxDuration > 0 || fullRoot.snapshot.txDuration > 0)
+                    text: i18n("%1 ms", (fullRoot.snapshot.rxDuration / 1000).toFixed(0))
                     Layout.preferredWidth: fullRoot.valueColumnWidth
                 }
 
                 PlasmaComponents3.Label {
-                    visible: Plasmoid.configuration.showAirtime && (WifiMonitor.rxDuration > 0 || WifiMonitor.txDuration > 0)
+                    visible: Plasmoid.configuration.showAirtime && (fullRoot.snapshot.rxDuration > 0 || fullRoot.snapshot.txDuration > 0)
                     text: i18nc("Transmit duration", "TX Time")
                     font.pointSize: Kirigami.Theme.smallFont.pointSize
                     opacity: 0.6
@@ -752,8 +1305,39 @@ PlasmaExtras.Representation {
                 }
 
                 PlasmaComponents3.Label {
-                    visible: Plasmoid.configuration.showAirtime && (WifiMonitor.rxDuration > 0 || WifiMonitor.txDuration > 0)
-                    text: i18n("%1 ms", (WifiMonitor.txDuration / 1000).toFixed(0))
+                    visible: Plasmoid.configuration.showAirtime && (fullRoot.snapshot.rxDuration > 0 || fullRoot.snapshot.txDuration > 0)
+                    text: i18n("%1 ms", (fullRoot.snapshot.txDuration / 1000).toFixed(0))
+                    Layout.fillWidth: true
+                }
+
+                // Row 3: per-antenna chain signal / imbalance (hidden if driver doesn't report chains)
+                PlasmaComponents3.Label {
+                    visible: Plasmoid.configuration.showChainSignal && fullRoot.snapshot.chainSignals.length > 1
+                    text: i18nc("Per-antenna chain signal", "Chains")
+                    font.pointSize: Kirigami.Theme.smallFont.pointSize
+                    opacity: 0.6
+                    Layout.preferredWidth: fullRoot.leftLabelWidth
+                }
+
+                PlasmaComponents3.Label {
+                    visible: Plasmoid.configuration.showChainSignal && fullRoot.snapshot.chainSignals.length > 1
+                    text: i18n("%1 dBm", fullRoot.snapshot.chainSignals.join(" / "))
+                    Layout.preferredWidth: fullRoot.valueColumnWidth
+                }
+
+                PlasmaComponents3.Label {
+                    visible: Plasmoid.configuration.showChainSignal && fullRoot.snapshot.chainSignals.length > 1
+                    text: i18nc("Chain signal imbalance", "Imbalance")
+                    font.pointSize: Kirigami.Theme.smallFont.pointSize
+                    opacity: 0.6
+                    Layout.preferredWidth: fullRoot.rightLabelWidth
+                }
+
+                PlasmaComponents3.Label {
+                    visible: Plasmoid.configuration.showChainSignal && fullRoot.snapshot.chainSignals.length > 1
+                    text: i18n("%1 dB", fullRoot.snapshot.chainImbalance.toFixed(0))
+                    color: fullRoot.snapshot.chainImbalanced ? Kirigami.Theme.negativeTextColor : Kirigami.Theme.textColor
+                    font.bold: fullRoot.snapshot.chainImbalanced
                     Layout.fillWidth: true
                 }
             }
@@ -9,16 +9,21 @@ KCM.SimpleKCM {
 
     property alias cfg_showLinkRateChart: showLinkRateChart.checked
     property alias cfg_chartHeight: chartHeight.value
+    property alias cfg_compactShowRate: compactShowRate.checked
     property alias cfg_showSignalInfo: showSignalInfo.checked
     property alias cfg_showChannelInfo: showChannelInfo.checked
 
     property alias cfg_showRxTxRate: showRxTxRate.checked
     property alias cfg_showMcs: showMcs.checked
     property alias cfg_showMimo: showMimo.checked
+    property alias cfg_showLinkEfficiency: showLinkEfficiency.checked
+    property alias cfg_showRateOccupancy: showRateOccupancy.checked
 
     property alias cfg_showTrafficStats: showTrafficStats.checked
     property alias cfg_showLinkQuality: showLinkQuality.checked
     property alias cfg_showBeaconStats: showBeaconStats.checked
+    property alias cfg_showLinkEvents: showLinkEvents.checked
+    property alias cfg_showTimeline: showTimeline.checked
 
     property alias cfg_showConnectedTime: showConnectedTime.checked
     property alias cfg_showExpectedThroughput: showExpectedThroughput.checked
@@ -28,6 +33,17 @@ KCM.SimpleKCM {
 
     property alias cfg_showAckSignal: showAckSignal.checked
     property alias cfg_showAirtime: showAirtime.checked
+    property alias cfg_showChainSignal: showChainSignal.checked
+    property alias cfg_exportMinutes: exportMinutes.value
+    property alias cfg_burstIntervalMs: burstIntervalMs.value
+    property alias cfg_burstSeconds: burstSeconds.value
+    property alias cfg_burstOnDegradation: burstOnDegradation.checked
+    property alias cfg_signalFilter: signalFilter.text
+    property alias cfg_rateFilter: rateFilter.text
+    property alias cfg_efficiencyFilter: efficiencyFilter.text
+    property alias cfg_traceEnabled: traceEnabled.checked
+
+    readonly property string filterHelp: i18n("Stages applied in order: ewma:<alpha>, median:<samples>, kalman:<process noise>:<measurement noise>, hysteresis:<margin>. Empty shows the raw values.")
 
     Kirigami.FormLayout {
         Kirigami.Separator {
@@ -49,6 +65,20 @@ KCM.SimpleKCM {
             enabled: showLinkRateChart.checked
         }
 
+        QQC2.CheckBox {
+            id: compactShowRate
+            Kirigami.FormData.label: i18n("Panel label:")
+            text: i18n("Show RX rate in the panel")
+        }
+
+        QQC2.Label {
+            text: i18n("When off, only the signal level is read while the popup is closed, which is much cheaper.")
+            font: Kirigami.Theme.smallFont
+            wrapMode: Text.Wrap
+            Layout.fillWidth: true
+            enabled: false
+        }
+
         QQC2.CheckBox {
             id: showSignalInfo
             Kirigami.FormData.label: i18n("Signal info:")
@@ -84,6 +114,18 @@ KCM.SimpleKCM {
             text: i18n("Show spatial stream count")
         }
 
+        QQC2.CheckBox {
+            id: showLinkEfficiency
+            Kirigami.FormData.label: i18n("Link efficiency:")
+            text: i18n("Show maximum PHY rate and share in use")
+        }
+
+        QQC2.CheckBox {
+            id: showRateOccupancy
+            Kirigami.FormData.label: i18n("Rate occupancy:")
+            text: i18n("Show time spent per MCS, streams and width")
+        }
+
         Kirigami.Separator {
             Kirigami.FormData.isSection: true
             Kirigami.FormData.label: i18n("Statistics")
@@ -107,6 +149,18 @@ KCM.SimpleKCM {
             text: i18n("Show beacon loss and signal")
         }
 
+        QQC2.CheckBox {
+            id: showLinkEvents
+            Kirigami.FormData.label: i18n("Link events:")
+            text: i18n("Show recent degradation and recovery events")
+        }
+
+        QQC2.CheckBox {
+            id: showTimeline
+            Kirigami.FormData.label: i18n("Event timeline:")
+            text: i18n("Show connection changes, errors and samples in one list")
+        }
+
         Kirigami.Separator {
             Kirigami.FormData.isSection: true
             Kirigami.FormData.label: i18n("Connection")
@@ -158,5 +212,67 @@ KCM.SimpleKCM {
             Kirigami.FormData.label: i18n("Airtime:")
             text: i18n("Show RX/TX duration")
         }
+
+        QQC2.CheckBox {
+            id: showChainSignal
+            Kirigami.FormData.label: i18n("Antenna chains:")
+            text: i18n("Show per-chain signal and imbalance")
+        }
+
+        QQC2.SpinBox {
+            id: exportMinutes
+            Kirigami.FormData.label: i18n("Export window (minutes):")
+            from: 1
+            to: 1440
+        }
+
+        QQC2.SpinBox {
+            id: burstIntervalMs
+            Kirigami.FormData.label: i18n("Burst interval (ms):")
+            from: 10
+            to: 100
+        }
+
+        QQC2.SpinBox {
+            id: burstSeconds
+            Kirigami.FormData.label: i18n("Burst length (seconds):")
+            from: 5
+            to: 60
+        }
+
+        QQC2.CheckBox {
+            id: burstOnDegradation
+            text: i18n("Capture a burst when the link degrades")
+        }
+
+        QQC2.TextField {
+            id: signalFilter
+            Kirigami.FormData.label: i18n("Signal filter:")
+            placeholderText: i18nc("Filter spec placeholder, keep the syntax", "e.g. median:3,ewma:0.5,hysteresis:2")
+            QQC2.ToolTip.text: root.filterHelp
+            QQC2.ToolTip.visible: hovered
+        }
+
+        QQC2.TextField {
+            id: rateFilter
+            Kirigami.FormData.label: i18n("Rate filter:")
+            placeholderText: i18nc("Filter spec placeholder, keep the syntax", "e.g. ewma:0.3")
+            QQC2.ToolTip.text: root.filterHelp
+            QQC2.ToolTip.visible: hovered
+        }
+
+        QQC2.TextField {
+            id: efficiencyFilter
+            Kirigami.FormData.label: i18n("Efficiency filter:")
+            placeholderText: i18nc("Filter spec placeholder, keep the syntax", "e.g. ewma:0.3")
+            QQC2.ToolTip.text: root.filterHelp
+            QQC2.ToolTip.visible: hovered
+        }
+
+        QQC2.CheckBox {
+            id: traceEnabled
+            Kirigami.FormData.label: i18n("Diagnostics:")
+            text: i18n("Write a performance trace (chrome://tracing, Perfetto)")
+        }
     }
 }
@@ -13,7 +13,14 @@ PlasmoidItem {
 
     readonly property bool isConnected: WifiMonitor.connected
     readonly property bool isAvailable: WifiMonitor.available
+    // One consistent copy of the per-tick statistics
+    readonly property var snapshot: WifiMonitor.snapshot
     readonly property bool isOnDesktop: Plasmoid.formFactor === PlasmaCore.Types.Planar
+    readonly property int exportMinutes: Plasmoid.configuration.exportMinutes
+    readonly property var burst: WifiMonitor.burst
+    property string lastExportPath: ""
+    // Nothing but the signal level is on screen, so sampling can take the cheap path.
+    readonly property bool signalOnly: !root.expanded && !root.isOnDesktop && !Plasmoid.configuration.compactShowRate
 
     preferredRepresentation: isOnDesktop ? fullRepresentation : compactRepresentation
 
@@ -30,7 +37,7 @@ PlasmoidItem {
             return "network-wireless-disconnected";
 
         // Dynamic icon based on signal strength
-        var dbm = WifiMonitor.signalDbm;
+        var dbm = root.snapshot.signalDbm;
         if (dbm >= -50)
             return "network-wireless-signal-excellent";
         if (dbm >= -60)
@@ -50,11 +57,29 @@ PlasmoidItem {
             return WifiMonitor.lastError ? i18n("Error: %1", WifiMonitor.lastError) : "";
         }
 
+        if (WifiMonitor.signalOnly) {
+            return i18n("%1 dBm", root.snapshot.signalDbm);
+        }
+
         var base = i18n("%1 Mbps | %2 dBm | %3 | %4 MHz",
-                        WifiMonitor.rxRate.toFixed(0),
-                        WifiMonitor.signalDbm,
-                        WifiMonitor.wifiGeneration,
-                        WifiMonitor.channelWidth);
+                        root.snapshot.rxRate.toFixed(0),
+                        root.snapshot.signalDbm,
+                        root.snapshot.wifiGeneration,
+                        root.snapshot.channelWidth);
+
+        if (root.snapshot.linkDegraded) {
+            base += "\n" + i18n("Link degraded");
+        }
+
+        if (root.snapshot.chainImbalanced) {
+            base += "\n" + i18n("Antenna chain imbalance: %1 dB", root.snapshot.chainImbalance.toFixed(0));
+        }
+
+        if (root.snapshot.belowCapability) {
+            base += "\n" + i18n("Running at %1% of %2 Mbps link capability",
+                                 Math.round(root.snapshot.linkEfficiency * 100),
+                                 root.snapshot.rxMaxRate.toFixed(0));
+        }
 
         if (WifiMonitor.lastError) {
             return base + "\n" + i18n("Error: %1", WifiMonitor.lastError);
@@ -84,9 +109,113 @@ PlasmoidItem {
                     clipboardHelper.copy();
                 }
             }
+        },
+        PlasmaCore.Action {
+            text: i18n("Export Last %1 Minutes as CSV", root.exportMinutes)
+            icon.name: "document-export"
+            enabled: !WifiMonitor.exporting
+            onTriggered: WifiMonitor.exportHistory(root.exportMinutes, "csv")
+        },
+        PlasmaCore.Action {
+            text: i18n("Export Last %1 Minutes as NumPy (.npz)", root.exportMinutes)
+            icon.name: "document-export"
+            enabled: !WifiMonitor.exporting
+            onTriggered: WifiMonitor.exportHistory(root.exportMinutes, "npz")
+        },
+        PlasmaCore.Action {
+            text: root.burst.active
+                ? i18n("Stop Burst Capture (%1%)", Math.round(root.burst.progress * 100))
+                : i18n("Capture Burst (%1 s at %2 ms)", Plasmoid.configuration.burstSeconds, Plasmoid.configuration.burstIntervalMs)
+            icon.name: root.burst.active ? "media-playback-stop" : "media-record"
+            enabled: root.isConnected
+            onTriggered: root.burst.active ? WifiMonitor.stopBurstCapture() : WifiMonitor.startBurstCapture()
+        },
+        PlasmaCore.Action {
+            text: i18n("Export Burst as CSV")
+            icon.name: "document-export"
+            enabled: !WifiMonitor.exporting && !root.burst.active && root.burst.samples > 0
+            onTriggered: WifiMonitor.exportBurst("csv")
+        },
+        PlasmaCore.Action {
+            text: i18n("Export Burst as NumPy (.npz)")
+            icon.name: "document-export"
+            enabled: !WifiMonitor.exporting && !root.burst.active && root.burst.samples > 0
+            onTriggered: WifiMonitor.exportBurst("npz")
+        },
+        PlasmaCore.Action {
+            text: i18n("Save Event Timeline")
+            icon.name: "view-calendar-timeline"
+            enabled: !WifiMonitor.exporting
+            onTriggered: WifiMonitor.exportTimeline()
+        },
+        PlasmaCore.Action {
+            text: i18n("Open Last Export")
+            icon.name: "document-open"
+            visible: root.lastExportPath !== ""
+            onTriggered: Qt.openUrlExternally("file://" + root.lastExportPath)
         }
     ]
 
+    Binding {
+        target: WifiMonitor
+        property: "signalOnly"
+        value: root.signalOnly
+    }
+
+    Binding {
+        target: WifiMonitor
+        property: "burstIntervalMs"
+        value: Plasmoid.configuration.burstIntervalMs
+    }
+
+    Binding {
+        target: WifiMonitor
+        property: "burstDurationMs"
+        value: Plasmoid.configuration.burstSeconds * 1000
+    }
+
+    Binding {
+        target: WifiMonitor
+        property: "burstOnDegradation"
+        value: Plasmoid.configuration.burstOnDegradation
+    }
+
+    Binding {
+        target: WifiMonitor
+        property: "signalFilter"
+        value: Plasmoid.configuration.signalFilter
+    }
+
+    Binding {
+        target: WifiMonitor
+        property: "rateFilter"
+        value: Plasmoid.configuration.rateFilter
+    }
+
+    Binding {
+        target: WifiMonitor
+        property: "efficiencyFilter"
+        value: Plasmoid.configuration.efficiencyFilter
+    }
+
+    Binding {
+        target: WifiMonitor
+        property: "tracing"
+        value: Plasmoid.configuration.traceEnabled
+    }
+
+    Connections {
+        target: WifiMonitor
+
+        function onHistoryExported(path, error) {
+            if (error) {
+                console.warn("TrueLink export failed:", error);
+                return;
+            }
+            root.lastExportPath = path;
+        }
+    }
+
     // Hidden TextEdit for clipboard operations
     TextEdit {
         id: clipboardHelper
@@ -112,17 +241,18 @@ PlasmoidItem {
                 width: 4
                 height: parent.height * 0.8
                 radius: 2
-                color: root.isConnected ? WifiMonitor.statusColor : Kirigami.Theme.disabledTextColor
+                color: root.isConnected ? root.snapshot.statusColor : Kirigami.Theme.disabledTextColor
                 Layout.alignment: Qt.AlignVCenter
             }
 
             PlasmaComponents3.Label {
+                visible: !root.isConnected || Plasmoid.configuration.compactShowRate
                 text: {
                     if (!root.isAvailable)
                         return i18n("No Adapter");
                     if (!root.isConnected)
                         return i18n("Disconnected");
-                    return i18n("%1 Mbps", Math.round(WifiMonitor.rxRate));
+                    return i18n("%1 Mbps", Math.round(root.snapshot.rxRate));
                 }
                 font.pointSize: Kirigami.Theme.smallFont.pointSize
                 Layout.alignment: Qt.AlignVCenter
@@ -130,7 +260,7 @@ PlasmoidItem {
 
             PlasmaComponents3.Label {
                 visible: root.isConnected
-                text: i18n("%1 dBm", WifiMonitor.signalDbm)
+                text: i18n("%1 dBm", root.snapshot.signalDbm)
                 font.pointSize: Kirigami.Theme.smallFont.pointSize
                 opacity: 0.75
                 Layout.alignment: Qt.AlignVCenter
@@ -0,0 +1,32 @@
+#include "burstadaptor.h"
+#include "tracer.h"
+#include "wifimonitor.h"
+
+BurstAdaptor::BurstAdaptor(WifiMonitor *monitor)
+    : QDBusAbstractAdaptor(monitor)
+    , m_monitor(monitor)
+{
+}
+
+bool BurstAdaptor::Start(int durationMs, int intervalMs)
+{
+    const Tracer::Scope trace("Burst.Start", "dbus");
+    return m_monitor->startBurstCapture(durationMs, intervalMs, BurstCapture::Trigger::DBus);
+}
+
+void BurstAdaptor::Stop()
+{
+    const Tracer::Scope trace("Burst.Stop", "dbus");
+    m_monitor->stopBurstCapture();
+}
+
+void BurstAdaptor::Export(const QString &format)
+{
+    const Tracer::Scope trace("Burst.Export", "dbus");
+    m_monitor->exportBurst(format);
+}
+
+QVariantMap BurstAdaptor::Status() const
+{
+    return m_monitor->burst();
+}
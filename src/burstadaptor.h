@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QDBusAbstractAdaptor>
+#include <QVariantMap>
+
+class WifiMonitor;
+
+/**
+ * @brief D-Bus control of WifiMonitor's burst capture
+ *
+ * Exported on plasmashell's session bus connection at
+ * /org/kde/plasma/truelinkmonitor, so a script can start a capture at the
+ * moment it reproduces a problem, e.g.
+ * `qdbus org.kde.plasmashell /org/kde/plasma/truelinkmonitor Start 10000 10`.
+ */
+class BurstAdaptor : public QDBusAbstractAdaptor
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.kde.plasma.truelinkmonitor.Burst")
+
+public:
+    explicit BurstAdaptor(WifiMonitor *monitor);
+
+public Q_SLOTS:
+    // 0 for either argument uses the configured value.
+    bool Start(int durationMs, int intervalMs);
+    void Stop();
+    // "csv" or "npz"; the path is reported through the applet's notification.
+    void Export(const QString &format);
+    QVariantMap Status() const;
+
+private:
+    WifiMonitor *m_monitor;
+};
@@ -0,0 +1,119 @@
+#include "burstcapture.h"
+
+#include <QtGlobal>
+
+bool BurstCapture::start(int intervalMs, int durationMs, Trigger trigger, uint64_t nowNs, int64_t wallClockMs)
+{
+    if (m_active) {
+        return false;
+    }
+    m_intervalMs = qBound(minIntervalMs, intervalMs, maxIntervalMs);
+    m_durationMs = qBound(minDurationMs, durationMs, qMin(maxDurationMs, capacity * m_intervalMs));
+    m_trigger = trigger;
+    m_startNs = nowNs;
+    m_startWallClockMs = wallClockMs;
+
+    m_samples.clear();
+    m_samples.reserve(capacity);
+    m_active = true;
+    return true;
+}
+
+bool BurstCapture::append(uint64_t nowNs, const Nl80211StationInfo &info)
+{
+    if (!m_active) {
+        return false;
+    }
+    const uint64_t elapsedNs = nowNs - m_startNs;
+
+    Sample sample;
+    sample.offsetUs = static_cast<int64_t>(elapsedNs / 1000);
+    sample.valid = info.valid;
+    if (info.valid) {
+        sample.signalDbm = static_cast<int8_t>(info.signalDbm);
+        sample.signalAvgDbm = static_cast<int8_t>(info.signalAvgDbm);
+        sample.rxMcs = info.rxMcs;
+        sample.txMcs = info.txMcs;
+        sample.rxNss = info.rxNss;
+        sample.txNss = info.txNss;
+        sample.rxChannelWidth = info.rxChannelWidth;
+        sample.rxBitrate = info.rxBitrate;
+        sample.txBitrate = info.txBitrate;
+        sample.txRetries = info.txRetries;
+        sample.txFailed = info.txFailed;
+        sample.beaconLoss = info.beaconLoss;
+        sample.inactiveTime = info.inactiveTime;
+        sample.rxBytes = info.rxBytes;
+        sample.txBytes = info.txBytes;
+    }
+    m_samples.append(sample);
+
+    if (m_samples.size() >= capacity || elapsedNs >= uint64_t(m_durationMs) * 1000000) {
+        finish();
+        return false;
+    }
+    return true;
+}
+
+void BurstCapture::finish()
+{
+    m_active = false;
+}
+
+bool BurstCapture::isActive() const
+{
+    return m_active;
+}
+
+int BurstCapture::size() const
+{
+    return m_samples.size();
+}
+
+const BurstCapture::Sample &BurstCapture::at(int index) const
+{
+    return m_samples[index];
+}
+
+int BurstCapture::intervalMs() const
+{
+    return m_intervalMs;
+}
+
+int BurstCapture::durationMs() const
+{
+    return m_durationMs;
+}
+
+int BurstCapture::expectedSamples() const
+{
+    return m_durationMs / m_intervalMs + 1;
+}
+
+BurstCapture::Trigger BurstCapture::trigger() const
+{
+    return m_trigger;
+}
+
+int64_t BurstCapture::startWallClockMs() const
+{
+    return m_startWallClockMs;
+}
+
+double BurstCapture::progress(uint64_t nowNs) const
+{
+    if (!m_active) {
+        return m_startWallClockMs > 0 ? 1.0 : 0.0;
+    }
+    return qMin(1.0, static_cast<double>(nowNs - m_startNs) / (m_durationMs * 1.0e6));
+}
+
+const char *BurstCapture::triggerName(Trigger trigger)
+{
+    switch (trigger) {
+        case Trigger::Manual:      return "manual";
+        case Trigger::Degradation: return "degradation";
+        case Trigger::DBus:        return "dbus";
+    }
+    return "unknown";
+}
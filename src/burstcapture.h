@@ -0,0 +1,92 @@
+#pragma once
+
+#include "nl80211helper.h"
+
+#include <QVector>
+
+#include <cstdint>
+
+/**
+ * @brief Raw samples of one short high-rate capture window
+ *
+ * The regular tick samples once a second and smooths the rates, which
+ * hides what happens between ticks: a roam, a rate collapse lasting a few
+ * frames. A burst samples every 10–100 ms for a bounded window and keeps
+ * every sample unsmoothed. The buffer is sized for the largest window the
+ * first time a burst starts and reused by every later one, so a burst tick
+ * only copies one sample into place. The last capture stays readable, for
+ * charting and export, until the next one starts.
+ */
+class BurstCapture
+{
+public:
+    enum class Trigger : uint8_t {
+        Manual = 0,  // context menu or QML
+        Degradation, // the change-point detector reported a degradation
+        DBus,
+    };
+
+    struct Sample {
+        int64_t offsetUs = 0; // since the capture started
+        bool valid = false;   // false: the query failed, e.g. mid-roam
+        int8_t signalDbm = 0;
+        int8_t signalAvgDbm = 0;
+        uint8_t rxMcs = 0;
+        uint8_t txMcs = 0;
+        uint8_t rxNss = 0;
+        uint8_t txNss = 0;
+        uint8_t rxChannelWidth = 0;
+        uint32_t rxBitrate = 0; // 100 kbit/s
+        uint32_t txBitrate = 0;
+        uint32_t txRetries = 0;
+        uint32_t txFailed = 0;
+        uint32_t beaconLoss = 0;
+        uint32_t inactiveTime = 0; // ms
+        uint64_t rxBytes = 0;
+        uint64_t txBytes = 0;
+    };
+
+    static constexpr int minIntervalMs = 10;
+    static constexpr int maxIntervalMs = 100;
+    static constexpr int defaultIntervalMs = 20;
+    // Shorter windows hold too few samples to show anything the tick misses.
+    static constexpr int minDurationMs = 1000;
+    static constexpr int maxDurationMs = 60 * 1000;
+    static constexpr int defaultDurationMs = 30 * 1000;
+    // A full window at the default interval. Shorter intervals get a
+    // proportionally shorter window.
+    static constexpr int capacity = maxDurationMs / defaultIntervalMs;
+
+    // Starts a new capture, discarding the previous one. @p intervalMs and
+    // @p durationMs are clamped to what the buffer holds. Returns false if a
+    // capture is already running.
+    bool start(int intervalMs, int durationMs, Trigger trigger, uint64_t nowNs, int64_t wallClockMs);
+    // Stores one sample. Returns false once the window is over or the buffer
+    // is full; the capture has then finished.
+    bool append(uint64_t nowNs, const Nl80211StationInfo &info);
+    void finish();
+
+    [[nodiscard]] bool isActive() const;
+    [[nodiscard]] int size() const;
+    [[nodiscard]] const Sample &at(int index) const;
+    [[nodiscard]] int intervalMs() const;
+    [[nodiscard]] int durationMs() const;
+    // Samples the window is expected to hold.
+    [[nodiscard]] int expectedSamples() const;
+    [[nodiscard]] Trigger trigger() const;
+    // Start of the capture, ms since the epoch; 0 if there never was one.
+    [[nodiscard]] int64_t startWallClockMs() const;
+    // Fraction of the window elapsed at @p nowNs, 1 once finished.
+    [[nodiscard]] double progress(uint64_t nowNs) const;
+
+    static const char *triggerName(Trigger trigger);
+
+private:
+    QVector<Sample> m_samples;
+    uint64_t m_startNs = 0;
+    int64_t m_startWallClockMs = 0;
+    int m_intervalMs = defaultIntervalMs;
+    int m_durationMs = defaultDurationMs;
+    Trigger m_trigger = Trigger::Manual;
+    bool m_active = false;
+};
@@ -0,0 +1,125 @@
+#include "columnreducer.h"
+
+#include <QtGlobal>
+
+#include <cmath>
+
+void ColumnReducer::configure(int windowSamples, int columns)
+{
+    m_window = qMax(1, windowSamples);
+    m_columns = qMax(1, columns);
+    m_samplesPerColumn = (m_window + m_columns - 1) / m_columns;
+    // One extra column for the one the window start currently cuts through.
+    m_ring.fill(Column{}, (m_window + m_samplesPerColumn - 1) / m_samplesPerColumn + 1);
+    m_head = -1;
+    m_next = 0;
+}
+
+void ColumnReducer::add(double value)
+{
+    add(value, value);
+}
+
+void ColumnReducer::add(double min, double max)
+{
+    if (m_ring.isEmpty()) {
+        return;
+    }
+
+    const int64_t index = m_next++;
+    if (std::isnan(min) || std::isnan(max)) {
+        return;
+    }
+    const int64_t id = index / m_samplesPerColumn;
+    if (m_head < 0 || m_ring[m_head].id != id) {
+        m_head = (m_head + 1) % m_ring.size();
+        m_ring[m_head] = Column{id, min, max, index, index};
+        return;
+    }
+
+    Column &column = m_ring[m_head];
+    if (min < column.min) {
+        column.min = min;
+        column.minIndex = index;
+    }
+    if (max > column.max) {
+        column.max = max;
+        column.maxIndex = index;
+    }
+}
+
+void ColumnReducer::clear()
+{
+    m_ring.fill(Column{});
+    m_head = -1;
+    m_next = 0;
+}
+
+int ColumnReducer::windowSamples() const
+{
+    return m_window;
+}
+
+int ColumnReducer::columns() const
+{
+    return m_columns;
+}
+
+int ColumnReducer::samplesPerColumn() const
+{
+    return m_samplesPerColumn;
+}
+
+int ColumnReducer::size() const
+{
+    return static_cast<int>(qMin<int64_t>(m_next, m_window));
+}
+
+void ColumnReducer::points(QVector<double> &xy) const
+{
+    xy.clear();
+    if (m_head < 0) {
+        return;
+    }
+
+    const int64_t span = size();
+    const int64_t start = m_next - span;
+    const double scale = span > 1 ? 1.0 / static_cast<double>(span - 1) : 0.0;
+    // The oldest column may straddle the window start. Its extremes are kept
+    // and pinned to x = 0, which is off by less than one column, instead of
+    // dropping a spike that is still partly in view.
+    const int64_t oldestId = start / m_samplesPerColumn;
+    const auto appendPoint = [&](int64_t index, double value) {
+        xy.append(static_cast<double>(qMax(index, start) - start) * scale);
+        xy.append(value);
+    };
+
+    const int count = m_ring.size();
+    for (int i = 1; i <= count; ++i) {
+        const Column &column = m_ring[(m_head + i) % count];
+        if (column.id < oldestId) {
+            continue;
+        }
+        if (column.minIndex == column.maxIndex && column.min == column.max) {
+            appendPoint(column.minIndex, column.min);
+        } else if (column.minIndex <= column.maxIndex) {
+            appendPoint(column.minIndex, column.min);
+            appendPoint(column.maxIndex, column.max);
+        } else {
+            appendPoint(column.maxIndex, column.max);
+            appendPoint(column.minIndex, column.min);
+        }
+    }
+}
+
+double ColumnReducer::maxValue(double floor) const
+{
+    const int64_t oldestId = (m_next - size()) / m_samplesPerColumn;
+    double result = floor;
+    for (const Column &column : m_ring) {
+        if (column.id >= oldestId) {
+            result = qMax(result, column.max);
+        }
+    }
+    return result;
+}
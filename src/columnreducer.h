@@ -0,0 +1,57 @@
+#pragma once
+
+#include <QVector>
+
+#include <cstdint>
+
+/**
+ * @brief Min/max-per-pixel-column downsampling for the rate chart
+ *
+ * Reduces a sliding window of samples to at most two points per chart
+ * column, the column's minimum and maximum at their original positions, so
+ * a one-sample spike survives no matter how long the window is. Columns are
+ * aligned to the absolute sample count rather than to the window start, so
+ * a new sample only touches the newest column and older columns never need
+ * recomputing. Output size is bounded by the column count, not the window.
+ */
+class ColumnReducer
+{
+public:
+    // Window length in samples and number of columns (usually the chart width in pixels).
+    void configure(int windowSamples, int columns);
+    void add(double value);
+    // One sample that already spans a range, e.g. an aggregated history bucket.
+    // A NaN sample (no data for that slot) takes its place in the window but
+    // draws nothing.
+    void add(double min, double max);
+    void clear();
+
+    [[nodiscard]] int windowSamples() const;
+    [[nodiscard]] int columns() const;
+    [[nodiscard]] int samplesPerColumn() const;
+    // Samples currently inside the window.
+    [[nodiscard]] int size() const;
+
+    // Replaces @p xy with (x, value) pairs, oldest first. x runs from 0 to 1
+    // across the retained samples, so a partially filled window spans the chart.
+    void points(QVector<double> &xy) const;
+    // Largest value shown by points(), or @p floor if that is larger.
+    [[nodiscard]] double maxValue(double floor) const;
+
+private:
+    struct Column {
+        int64_t id = -1;
+        double min = 0.0;
+        double max = 0.0;
+        int64_t minIndex = 0;
+        int64_t maxIndex = 0;
+    };
+
+    QVector<Column> m_ring;
+    int m_head = -1;
+    int m_window = 0;
+    int m_columns = 0;
+    int m_samplesPerColumn = 1;
+    // Absolute index of the next sample.
+    int64_t m_next = 0;
+};
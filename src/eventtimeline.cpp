@@ -0,0 +1,255 @@
+#include "eventtimeline.h"
+#include "profiler.h"
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QFile>
+#include <QVector>
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+namespace EventTimeline {
+
+namespace {
+
+constexpr int wordCount = sizeof(Event) / sizeof(uint64_t);
+static_assert(sizeof(Event) == wordCount * sizeof(uint64_t), "Event must pack into whole words");
+
+// The payload is kept in relaxed atomics so a reader racing a writer is
+// well-defined; the sequence check then throws the torn copy away.
+// seq is 2n + 1 while event n is being written and 2n + 2 once published.
+struct alignas(64) Slot {
+    std::atomic<uint64_t> seq{0};
+    std::atomic<uint64_t> words[wordCount] = {};
+};
+
+Slot s_slots[capacity];
+std::atomic<uint64_t> s_head{0};
+std::atomic<uint64_t> s_dropped{0};
+
+void copyDetail(char (&out)[detailSize], const char *detail, size_t length)
+{
+    if (length >= detailSize) {
+        length = detailSize - 1;
+        // Do not cut a UTF-8 sequence in half.
+        while (length > 0 && (static_cast<uint8_t>(detail[length]) & 0xc0) == 0x80) {
+            --length;
+        }
+    }
+    std::memcpy(out, detail, length);
+    out[length] = '\0';
+}
+
+// UTF-16 to UTF-8 straight into the slot, stopping at the last character
+// that fits; unpaired surrogates become U+FFFD like QString::toUtf8().
+void copyDetail(char (&out)[detailSize], const QString &detail)
+{
+    const QChar *p = detail.constData();
+    const QChar *const end = p + detail.size();
+    size_t length = 0;
+    while (p != end) {
+        char32_t c = p->unicode();
+        if (p->isSurrogate()) {
+            if (p->isHighSurrogate() && p + 1 != end && p[1].isLowSurrogate()) {
+                c = QChar::surrogateToUcs4(p[0], p[1]);
+                ++p;
+            } else {
+                c = QChar::ReplacementCharacter;
+            }
+        }
+        ++p;
+        const size_t bytes = c < 0x80 ? 1 : c < 0x800 ? 2 : c < 0x10000 ? 3 : 4;
+        if (length + bytes > detailSize - 1) {
+            break;
+        }
+        if (bytes == 1) {
+            out[length++] = static_cast<char>(c);
+            continue;
+        }
+        static constexpr uint8_t lead[] = {0, 0, 0xc0, 0xe0, 0xf0};
+        out[length++] = static_cast<char>(lead[bytes] | (c >> (6 * (bytes - 1))));
+        for (size_t i = bytes - 1; i > 0; --i) {
+            out[length++] = static_cast<char>(0x80 | ((c >> (6 * (i - 1))) & 0x3f));
+        }
+    }
+    out[length] = '\0';
+}
+
+// Claims the next slot and publishes @p event into it.
+void publish(const Event &event)
+{
+    const uint64_t n = s_head.fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = s_slots[n % capacity];
+
+    // Claim the slot only if the previous lap published it; a writer from
+    // an older lap that is still mid-copy wins and this event is dropped.
+    uint64_t previous = slot.seq.load(std::memory_order_relaxed);
+    if ((previous & 1) || previous > 2 * n
+        || !slot.seq.compare_exchange_strong(previous, 2 * n + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+        s_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint64_t words[wordCount];
+    std::memcpy(words, &event, sizeof(event));
+    for (int i = 0; i < wordCount; ++i) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.seq.store(2 * n + 2, std::memory_order_release);
+}
+
+void appendJsonString(QByteArray &out, const char *text)
+{
+    out.append('"');
+    for (const char *p = text; *p; ++p) {
+        const auto c = static_cast<uint8_t>(*p);
+        if (c == '"' || c == '\\') {
+            out.append('\\').append(*p);
+        } else if (c < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out.append(escaped);
+        } else {
+            out.append(*p);
+        }
+    }
+    out.append('"');
+}
+
+} // namespace
+
+void record(Kind kind, int32_t value, int32_t value2, const char *detail)
+{
+    Event event;
+    event.timestampNs = Profiler::nowNs();
+    event.kind = kind;
+    event.value = value;
+    event.value2 = value2;
+    if (detail) {
+        copyDetail(event.detail, detail, std::strlen(detail));
+    }
+    publish(event);
+}
+
+void record(Kind kind, const QString &detail, int32_t value)
+{
+    Event event;
+    event.timestampNs = Profiler::nowNs();
+    event.kind = kind;
+    event.value = value;
+    copyDetail(event.detail, detail);
+    publish(event);
+}
+
+uint64_t recorded()
+{
+    return s_head.load(std::memory_order_relaxed);
+}
+
+uint64_t dropped()
+{
+    return s_dropped.load(std::memory_order_relaxed);
+}
+
+int read(Event *out, uint64_t *sequences, int max, uint64_t since)
+{
+    const uint64_t head = s_head.load(std::memory_order_acquire);
+    uint64_t first = head > uint64_t(capacity) ? head - capacity : 0;
+    if (head - first > uint64_t(max)) {
+        first = head - max;
+    }
+    if (since > first) {
+        first = since;
+    }
+
+    int count = 0;
+    for (uint64_t n = first; n < head; ++n) {
+        const Slot &slot = s_slots[n % capacity];
+        const uint64_t before = slot.seq.load(std::memory_order_acquire);
+        if (before != 2 * n + 2) {
+            continue; // not published yet, or already overwritten
+        }
+        uint64_t words[wordCount];
+        for (int i = 0; i < wordCount; ++i) {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != before) {
+            continue;
+        }
+        std::memcpy(&out[count], words, sizeof(Event));
+        if (sequences) {
+            sequences[count] = n;
+        }
+        ++count;
+    }
+    return count;
+}
+
+int64_t wallClockMs(uint64_t timestampNs)
+{
+    const uint64_t ageNs = Profiler::nowNs() - timestampNs;
+    return QDateTime::currentMSecsSinceEpoch() - static_cast<int64_t>(ageNs / 1000000);
+}
+
+bool writeJsonLines(const QString &path, QString *error)
+{
+    QVector<Event> events(capacity);
+    QVector<uint64_t> sequences(capacity);
+    const int count = read(events.data(), sequences.data(), capacity);
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (error) {
+            *error = file.errorString();
+        }
+        return false;
+    }
+
+    QByteArray line;
+    for (int i = 0; i < count; ++i) {
+        const Event &event = events[i];
+        char fields[192];
+        std::snprintf(fields, sizeof(fields),
+                      "{\"seq\":%llu,\"monotonic_ns\":%llu,\"timestamp_ms\":%lld,\"kind\":\"%s\",\"value\":%d,\"value2\":%d,\"detail\":",
+                      static_cast<unsigned long long>(sequences[i]),
+                      static_cast<unsigned long long>(event.timestampNs),
+                      static_cast<long long>(wallClockMs(event.timestampNs)),
+                      kindName(event.kind), event.value, event.value2);
+        line = fields;
+        appendJsonString(line, event.detail);
+        line.append("}\n");
+        if (file.write(line) != line.size()) {
+            if (error) {
+                *error = file.errorString();
+            }
+            file.remove();
+            return false;
+        }
+    }
+    return true;
+}
+
+const char *kindName(Kind kind)
+{
+    switch (kind) {
+        case Kind::Connected:        return "connected";
+        case Kind::Roamed:           return "roamed";
+        case Kind::Disconnected:     return "disconnected";
+        case Kind::Availability:     return "availability";
+        case Kind::SamplingMode:     return "samplingMode";
+        case Kind::WiphyChanged:     return "wiphyChanged";
+        case Kind::InterfaceChanged: return "interfaceChanged";
+        case Kind::Error:            return "error";
+        case Kind::LinkEvent:        return "linkEvent";
+        case Kind::Sample:           return "sample";
+        case Kind::Session:          return "session";
+        case Kind::Burst:            return "burst";
+    }
+    return "unknown";
+}
+
+} // namespace EventTimeline
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <QString>
+
+#include <cstdint>
+
+/**
+ * @brief Process-wide, lock-free log of network state changes
+ *
+ * Connection and availability transitions, nl80211 notifications, errors
+ * and one marker per sample go into a single bounded ring with monotonic
+ * timestamps, so they can be read back as one timeline. Recording is a
+ * clock read, one atomic increment, one compare-and-swap and a 56-byte
+ * copy; it never allocates or blocks, and any thread may record. When the
+ * ring is full the oldest events are overwritten.
+ *
+ * Each slot carries a sequence number that doubles as a seqlock: a writer
+ * claims the slot only once the previous lap's writer has published it
+ * (otherwise the event is counted as dropped rather than waiting), and a
+ * reader discards any slot whose sequence changed while it was copying.
+ */
+namespace EventTimeline {
+
+enum class Kind : uint8_t {
+    Connected = 0,   // value: frequency (MHz), detail: BSSID
+    Roamed,          // value: frequency (MHz), detail: new BSSID
+    Disconnected,
+    Availability,    // value: 1 adapter available, 0 gone or radio off
+    SamplingMode,    // detail: mode name
+    WiphyChanged,    // value: wiphy index
+    InterfaceChanged, // value: ifindex
+    Error,           // detail: message
+    LinkEvent,       // value: 1 degraded, 0 recovered, detail: metric
+    Sample,          // value: signal (dBm), value2: TX retries since the previous sample
+    Session,         // value: Nl80211Session::State, value2: retry delay (ms), detail: failure
+    Burst,           // value: 1 started, 0 finished, value2: interval (ms) or samples, detail: trigger
+};
+inline constexpr int kindCount = 12;
+
+inline constexpr int capacity = 1024;
+inline constexpr int detailSize = 39;
+
+struct Event {
+    uint64_t timestampNs = 0; // Profiler::nowNs() clock
+    int32_t value = 0;
+    int32_t value2 = 0;
+    Kind kind = Kind::Sample;
+    char detail[detailSize] = {}; // UTF-8, NUL-terminated, truncated on a character boundary
+};
+
+void record(Kind kind, int32_t value = 0, int32_t value2 = 0, const char *detail = nullptr);
+// Encodes @p detail as UTF-8 directly into the event, without a temporary.
+void record(Kind kind, const QString &detail, int32_t value = 0);
+
+// Number of events ever recorded; the sequence number of the next event.
+[[nodiscard]] uint64_t recorded();
+// Events that found their slot still being written by a previous lap.
+[[nodiscard]] uint64_t dropped();
+
+/**
+ * Copies up to @p max of the newest events with a sequence number of at
+ * least @p since into @p out, oldest first, and their sequence numbers into
+ * @p sequences if given. Returns the number copied.
+ */
+int read(Event *out, uint64_t *sequences, int max, uint64_t since = 0);
+
+// Maps a recorded timestamp to wall-clock milliseconds since the epoch.
+[[nodiscard]] int64_t wallClockMs(uint64_t timestampNs);
+
+// Writes every retained event as one JSON object per line.
+bool writeJsonLines(const QString &path, QString *error);
+
+const char *kindName(Kind kind);
+
+} // namespace EventTimeline
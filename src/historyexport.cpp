@@ -0,0 +1,442 @@
+#include "historyexport.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QtEndian>
+
+#include <array>
+#include <bit>
+#include <cstdio>
+#include <iterator>
+
+namespace HistoryExport {
+
+namespace {
+
+constexpr int bufferSize = 64 * 1024;
+
+// Field order inside a bucket, used for column names and values.
+constexpr const char *statNames[] = {"min", "max", "mean", "last"};
+constexpr int statCount = 4;
+
+float bucketStat(const TieredHistory::Bucket &bucket, int stat)
+{
+    switch (stat) {
+        case 0:  return bucket.min;
+        case 1:  return bucket.max;
+        case 2:  return bucket.mean;
+        default: return bucket.last;
+    }
+}
+
+QByteArray columnName(int metric, int stat)
+{
+    return QByteArray(TieredHistory::metricName(static_cast<TieredHistory::Metric>(metric))) + '_' + statNames[stat];
+}
+
+// What the writers see of a window: column 0 is the timestamp, every column
+// is either int64 or float32.
+class BucketTable
+{
+public:
+    explicit BucketTable(const Window &window)
+        : m_window(window)
+    {
+    }
+
+    [[nodiscard]] int rows() const { return m_window.rows(); }
+    [[nodiscard]] int columns() const { return 1 + TieredHistory::metricCount * statCount; }
+    [[nodiscard]] QByteArray name(int column) const
+    {
+        return column == 0 ? QByteArray("timestamp_ms") : columnName((column - 1) / statCount, (column - 1) % statCount);
+    }
+    [[nodiscard]] bool isInteger(int column) const { return column == 0; }
+    [[nodiscard]] int64_t integer(int row, int) const { return m_window.timestamps[row]; }
+    [[nodiscard]] float real(int row, int column) const
+    {
+        const int metric = (column - 1) / statCount;
+        return bucketStat(m_window.buckets[row * TieredHistory::metricCount + metric], (column - 1) % statCount);
+    }
+
+private:
+    const Window &m_window;
+};
+
+struct BurstColumn {
+    const char *name;
+    int64_t (*integer)(const BurstCapture::Sample &);
+    float (*real)(const BurstCapture::Sample &);
+};
+
+// Timestamps are filled in by BurstTable; rates in Mbps, widths in MHz.
+constexpr BurstColumn burstColumns[] = {
+    {"timestamp_us", nullptr, nullptr},
+    {"valid", [](const BurstCapture::Sample &s) -> int64_t { return s.valid; }, nullptr},
+    {"signal", [](const BurstCapture::Sample &s) -> int64_t { return s.signalDbm; }, nullptr},
+    {"signal_avg", [](const BurstCapture::Sample &s) -> int64_t { return s.signalAvgDbm; }, nullptr},
+    {"rx_rate", nullptr, [](const BurstCapture::Sample &s) { return s.rxBitrate / 10.0f; }},
+    {"tx_rate", nullptr, [](const BurstCapture::Sample &s) { return s.txBitrate / 10.0f; }},
+    {"rx_mcs", [](const BurstCapture::Sample &s) -> int64_t { return s.rxMcs; }, nullptr},
+    {"tx_mcs", [](const BurstCapture::Sample &s) -> int64_t { return s.txMcs; }, nullptr},
+    {"rx_nss", [](const BurstCapture::Sample &s) -> int64_t { return s.rxNss; }, nullptr},
+    {"tx_nss", [](const BurstCapture::Sample &s) -> int64_t { return s.txNss; }, nullptr},
+    {"rx_width", [](const BurstCapture::Sample &s) -> int64_t { return Nl80211Helper::channelWidthToMhz(s.rxChannelWidth); }, nullptr},
+    {"tx_retries", [](const BurstCapture::Sample &s) -> int64_t { return s.txRetries; }, nullptr},
+    {"tx_failed", [](const BurstCapture::Sample &s) -> int64_t { return s.txFailed; }, nullptr},
+    {"beacon_loss", [](const BurstCapture::Sample &s) -> int64_t { return s.beaconLoss; }, nullptr},
+    {"inactive_ms", [](const BurstCapture::Sample &s) -> int64_t { return s.inactiveTime; }, nullptr},
+    {"rx_bytes", [](const BurstCapture::Sample &s) -> int64_t { return static_cast<int64_t>(s.rxBytes); }, nullptr},
+    {"tx_bytes", [](const BurstCapture::Sample &s) -> int64_t { return static_cast<int64_t>(s.txBytes); }, nullptr},
+};
+
+class BurstTable
+{
+public:
+    explicit BurstTable(const BurstCapture &capture)
+        : m_capture(capture)
+    {
+    }
+
+    [[nodiscard]] int rows() const { return m_capture.size(); }
+    [[nodiscard]] int columns() const { return static_cast<int>(std::size(burstColumns)); }
+    [[nodiscard]] QByteArray name(int column) const { return burstColumns[column].name; }
+    [[nodiscard]] bool isInteger(int column) const { return burstColumns[column].real == nullptr; }
+    [[nodiscard]] int64_t integer(int row, int column) const
+    {
+        const BurstCapture::Sample &sample = m_capture.at(row);
+        return column == 0 ? m_capture.startWallClockMs() * 1000 + sample.offsetUs : burstColumns[column].integer(sample);
+    }
+    [[nodiscard]] float real(int row, int column) const { return burstColumns[column].real(m_capture.at(row)); }
+
+private:
+    const BurstCapture &m_capture;
+};
+
+constexpr std::array<uint32_t, 256> makeCrcTable()
+{
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        table[i] = c;
+    }
+    return table;
+}
+
+constexpr std::array<uint32_t, 256> crcTable = makeCrcTable();
+
+// Running CRC-32 as used by zip; start from 0.
+uint32_t crc32(uint32_t crc, const char *data, qsizetype size)
+{
+    crc = ~crc;
+    for (qsizetype i = 0; i < size; ++i) {
+        crc = crcTable[(crc ^ static_cast<uint8_t>(data[i])) & 0xff] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+// Buffered writer that flushes to the file whenever the buffer fills up.
+class Sink
+{
+public:
+    explicit Sink(QFile &file)
+        : m_file(file)
+    {
+        m_buffer.reserve(bufferSize);
+    }
+
+    void append(const char *data, qsizetype size)
+    {
+        m_crc = crc32(m_crc, data, size);
+        m_written += size;
+        if (m_buffer.size() + size > bufferSize) {
+            flush();
+        }
+        m_buffer.append(data, size);
+    }
+
+    void append(const QByteArray &data)
+    {
+        append(data.constData(), data.size());
+    }
+
+    template<typename T>
+    void appendLe(T value)
+    {
+        const T le = qToLittleEndian(value);
+        append(reinterpret_cast<const char *>(&le), sizeof(le));
+    }
+
+    bool flush()
+    {
+        if (!m_buffer.isEmpty() && m_file.write(m_buffer) != m_buffer.size()) {
+            m_failed = true;
+        }
+        m_buffer.clear();
+        return !m_failed;
+    }
+
+    // CRC and byte count since the last restart(), for zip members.
+    void restart()
+    {
+        m_crc = 0;
+        m_written = 0;
+    }
+    [[nodiscard]] uint32_t crc() const { return m_crc; }
+    [[nodiscard]] qint64 written() const { return m_written; }
+    [[nodiscard]] bool failed() const { return m_failed; }
+
+private:
+    QFile &m_file;
+    QByteArray m_buffer;
+    uint32_t m_crc = 0;
+    qint64 m_written = 0;
+    bool m_failed = false;
+};
+
+template<typename Table>
+bool writeCsv(QFile &file, const Table &table)
+{
+    Sink sink(file);
+
+    QByteArray header;
+    for (int c = 0; c < table.columns(); ++c) {
+        header += (c ? "," : "") + table.name(c);
+    }
+    sink.append(header + '\n');
+
+    char line[512];
+    for (int row = 0; row < table.rows(); ++row) {
+        int length = 0;
+        for (int c = 0; c < table.columns(); ++c) {
+            const char *separator = c ? "," : "";
+            length += table.isInteger(c)
+                ? std::snprintf(line + length, sizeof(line) - length, "%s%lld", separator, static_cast<long long>(table.integer(row, c)))
+                : std::snprintf(line + length, sizeof(line) - length, "%s%.2f", separator, table.real(row, c));
+        }
+        line[length++] = '\n';
+        sink.append(line, length);
+    }
+    return sink.flush();
+}
+
+// .npy v1.0 header for a 1-D little-endian array, padded so the data starts 64-byte aligned.
+QByteArray npyHeader(const char *descr, int rows)
+{
+    QByteArray dict = QByteArray("{'descr': '") + descr + "', 'fortran_order': False, 'shape': ("
+        + QByteArray::number(rows) + ",), }";
+    const int prefix = 10; // magic (6) + version (2) + header length (2)
+    const int padded = ((prefix + dict.size() + 1 + 63) / 64) * 64;
+    dict.append(QByteArray(padded - prefix - dict.size() - 1, ' '));
+    dict.append('\n');
+
+    QByteArray header("\x93NUMPY\x01\x00", 8);
+    const quint16 length = qToLittleEndian(static_cast<quint16>(dict.size()));
+    header.append(reinterpret_cast<const char *>(&length), sizeof(length));
+    return header + dict;
+}
+
+struct ZipEntry {
+    QByteArray name;
+    uint32_t crc = 0;
+    uint32_t size = 0;
+    uint32_t offset = 0;
+};
+
+constexpr uint16_t zipVersion = 20;
+constexpr uint16_t dosDate = (0 << 9) | (1 << 5) | 1; // 1980-01-01
+
+void appendLocalHeader(Sink &sink, const ZipEntry &entry)
+{
+    sink.appendLe<uint32_t>(0x04034b50);
+    sink.appendLe<uint16_t>(zipVersion);
+    sink.appendLe<uint16_t>(0);       // flags
+    sink.appendLe<uint16_t>(0);       // stored, no compression
+    sink.appendLe<uint16_t>(0);       // time
+    sink.appendLe<uint16_t>(dosDate);
+    sink.appendLe<uint32_t>(entry.crc);
+    sink.appendLe<uint32_t>(entry.size);
+    sink.appendLe<uint32_t>(entry.size);
+    sink.appendLe<uint16_t>(static_cast<uint16_t>(entry.name.size()));
+    sink.appendLe<uint16_t>(0);       // extra field length
+    sink.append(entry.name);
+}
+
+template<typename Table>
+bool writeNpz(QFile &file, const Table &table)
+{
+    Sink sink(file);
+    QVector<ZipEntry> entries;
+    const int rows = table.rows();
+
+    // Each member's local header carries its CRC, which is only known after
+    // the data went through the sink, so the header is patched afterwards.
+    const auto writeMember = [&](const QByteArray &name, const char *descr, int itemSize, const auto &appendValues) {
+        if (!sink.flush()) {
+            return false;
+        }
+        ZipEntry entry;
+        entry.name = name + ".npy";
+        entry.offset = static_cast<uint32_t>(file.pos());
+        const QByteArray header = npyHeader(descr, rows);
+        entry.size = static_cast<uint32_t>(header.size() + qint64(rows) * itemSize);
+
+        appendLocalHeader(sink, entry);
+        sink.restart();
+        sink.append(header);
+        appendValues();
+        entry.crc = sink.crc();
+        if (!sink.flush()) {
+            return false;
+        }
+
+        // CRC-32 sits 14 bytes into the local header.
+        const qint64 end = file.pos();
+        const uint32_t crcLe = qToLittleEndian(entry.crc);
+        if (!file.seek(entry.offset + 14)
+            || file.write(reinterpret_cast<const char *>(&crcLe), sizeof(crcLe)) != sizeof(crcLe)
+            || !file.seek(end)) {
+            return false;
+        }
+        entries.append(entry);
+        return true;
+    };
+
+    bool ok = true;
+    for (int c = 0; ok && c < table.columns(); ++c) {
+        if (table.isInteger(c)) {
+            ok = writeMember(table.name(c), "<i8", 8, [&]() {
+                for (int row = 0; row < rows; ++row) {
+                    sink.appendLe<qint64>(table.integer(row, c));
+                }
+            });
+        } else {
+            ok = writeMember(table.name(c), "<f4", 4, [&]() {
+                for (int row = 0; row < rows; ++row) {
+                    sink.appendLe<quint32>(std::bit_cast<quint32>(table.real(row, c)));
+                }
+            });
+        }
+    }
+    if (!ok) {
+        return false;
+    }
+
+    sink.restart();
+    const auto directoryOffset = static_cast<uint32_t>(file.pos());
+    for (const ZipEntry &entry : entries) {
+        sink.appendLe<uint32_t>(0x02014b50);
+        sink.appendLe<uint16_t>(zipVersion); // made by
+        sink.appendLe<uint16_t>(zipVersion); // needed
+        sink.appendLe<uint16_t>(0);
+        sink.appendLe<uint16_t>(0);
+        sink.appendLe<uint16_t>(0);
+        sink.appendLe<uint16_t>(dosDate);
+        sink.appendLe<uint32_t>(entry.crc);
+        sink.appendLe<uint32_t>(entry.size);
+        sink.appendLe<uint32_t>(entry.size);
+        sink.appendLe<uint16_t>(static_cast<uint16_t>(entry.name.size()));
+        sink.appendLe<uint16_t>(0); // extra
+        sink.appendLe<uint16_t>(0); // comment
+        sink.appendLe<uint16_t>(0); // disk
+        sink.appendLe<uint16_t>(0); // internal attributes
+        sink.appendLe<uint32_t>(0); // external attributes
+        sink.appendLe<uint32_t>(entry.offset);
+        sink.append(entry.name);
+    }
+    const auto directorySize = static_cast<uint32_t>(sink.written());
+
+    sink.appendLe<uint32_t>(0x06054b50);
+    sink.appendLe<uint16_t>(0);
+    sink.appendLe<uint16_t>(0);
+    sink.appendLe<uint16_t>(static_cast<uint16_t>(entries.size()));
+    sink.appendLe<uint16_t>(static_cast<uint16_t>(entries.size()));
+    sink.appendLe<uint32_t>(directorySize);
+    sink.appendLe<uint32_t>(directoryOffset);
+    sink.appendLe<uint16_t>(0);
+    return sink.flush();
+}
+
+} // namespace
+
+Window capture(const TieredHistory &history, int64_t durationMs)
+{
+    Window window;
+    window.tier = TieredHistory::Tier::Hours;
+    for (int t = 0; t < TieredHistory::tierCount; ++t) {
+        const auto tier = static_cast<TieredHistory::Tier>(t);
+        if (TieredHistory::capacity(tier) * TieredHistory::bucketDurationMs(tier) >= durationMs) {
+            window.tier = tier;
+            break;
+        }
+    }
+
+    const int size = history.size(window.tier);
+    if (size == 0) {
+        return window;
+    }
+    const int64_t since = history.timestampMs(window.tier, size - 1) - durationMs;
+    int first = size - 1;
+    while (first > 0 && history.timestampMs(window.tier, first - 1) > since) {
+        --first;
+    }
+
+    const int rows = size - first;
+    window.timestamps.reserve(rows);
+    window.buckets.reserve(rows * TieredHistory::metricCount);
+    for (int i = first; i < size; ++i) {
+        window.timestamps.append(history.timestampMs(window.tier, i));
+        for (int m = 0; m < TieredHistory::metricCount; ++m) {
+            window.buckets.append(history.bucket(window.tier, static_cast<TieredHistory::Metric>(m), i));
+        }
+    }
+    return window;
+}
+
+namespace {
+
+template<typename Table>
+bool writeTable(const QString &path, Format format, const Table &table, QString *error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (error) {
+            *error = file.errorString();
+        }
+        return false;
+    }
+
+    const bool ok = format == Format::Csv ? writeCsv(file, table) : writeNpz(file, table);
+    if (!ok) {
+        if (error) {
+            *error = file.errorString();
+        }
+        file.remove();
+    }
+    return ok;
+}
+
+} // namespace
+
+bool write(const QString &path, Format format, const Window &window, QString *error)
+{
+    return writeTable(path, format, BucketTable(window), error);
+}
+
+bool write(const QString &path, Format format, const BurstCapture &capture, QString *error)
+{
+    return writeTable(path, format, BurstTable(capture), error);
+}
+
+const char *fileExtension(Format format)
+{
+    switch (format) {
+        case Format::Csv: return "csv";
+        case Format::Npz: return "npz";
+    }
+    return "";
+}
+
+} // namespace HistoryExport
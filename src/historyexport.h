@@ -0,0 +1,49 @@
+#pragma once
+
+#include "burstcapture.h"
+#include "tieredhistory.h"
+
+#include <QString>
+#include <QVector>
+
+#include <cstdint>
+
+/**
+ * @brief Writes a window of TieredHistory buckets, or a burst capture, to disk, one column per field
+ *
+ * capture() copies the newest buckets out of the history on the caller's
+ * thread; that copy is bounded by the tier capacity, not by how long the
+ * window is. write() can then run on a worker thread. Both formats are
+ * streamed through a fixed-size buffer:
+ *  - CSV, one row per bucket with a header line.
+ *  - NumPy .npz (an uncompressed zip of one .npy array per column), which
+ *    numpy, pandas (pd.DataFrame(dict(np.load(path)))) and pyarrow read
+ *    with types intact.
+ */
+namespace HistoryExport {
+
+enum class Format : uint8_t {
+    Csv = 0,
+    Npz,
+};
+
+struct Window {
+    TieredHistory::Tier tier = TieredHistory::Tier::Seconds;
+    QVector<int64_t> timestamps;
+    // rows * metricCount, row-major.
+    QVector<TieredHistory::Bucket> buckets;
+
+    [[nodiscard]] int rows() const { return timestamps.size(); }
+};
+
+// Newest @p durationMs of @p history, from the finest tier that still covers it.
+Window capture(const TieredHistory &history, int64_t durationMs);
+
+// Returns false and sets @p error if the file could not be written.
+bool write(const QString &path, Format format, const Window &window, QString *error);
+// One row per burst sample with a µs timestamp; unsmoothed, nothing aggregated.
+bool write(const QString &path, Format format, const BurstCapture &capture, QString *error);
+
+const char *fileExtension(Format format);
+
+} // namespace HistoryExport
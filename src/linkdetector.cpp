@@ -0,0 +1,154 @@
+#include "linkdetector.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+// Samples used to seed the baseline before any event can fire.
+constexpr int warmupSamples = 10;
+
+// Baseline drift tracking while the link looks healthy. Slow enough that a
+// step change is flagged long before the baseline follows it.
+constexpr double baselineAlpha = 0.02;
+
+// Retry ratios over a handful of packets are mostly noise.
+constexpr uint32_t minPacketsForRetryRatio = 10;
+
+} // namespace
+
+const LinkDetector::Tuning &LinkDetector::tuning(Metric metric)
+{
+    // Ordered like Metric.
+    static constexpr Tuning table[metricCount] = {
+        {3.0, 20.0, 3.0, 12.0, false}, // Signal, dB
+        {0.05, 0.6, 0.05, 0.4, true},  // RetryRatio, retries per transmitted packet
+        {0.5, 4.0, 0.5, 5.0, true},    // BeaconLoss, lost beacons per sample
+        {3.0, 20.0, 3.0, 12.0, false}, // AckSignal, dB
+    };
+    return table[static_cast<int>(metric)];
+}
+
+int LinkDetector::addSample(int64_t timestampMs, const Nl80211StationInfo &info, Event *events)
+{
+    if (!info.valid) {
+        return 0;
+    }
+
+    int count = 0;
+
+    if (info.signalDbm != 0 && update(Metric::Signal, info.signalDbm, timestampMs, events[count])) {
+        ++count;
+    }
+
+    if (info.hasAckSignal && info.ackSignal != 0 && update(Metric::AckSignal, info.ackSignal, timestampMs, events[count])) {
+        ++count;
+    }
+
+    // Counter based metrics need a previous sample; a counter going backwards
+    // means the station was re-created, so skip that tick.
+    if (m_hasPrevious && info.txPackets >= m_prevTxPackets && info.txRetries >= m_prevTxRetries) {
+        const uint32_t packets = info.txPackets - m_prevTxPackets;
+        if (packets >= minPacketsForRetryRatio) {
+            const double ratio = static_cast<double>(info.txRetries - m_prevTxRetries) / packets;
+            if (update(Metric::RetryRatio, ratio, timestampMs, events[count])) {
+                ++count;
+            }
+        }
+    }
+
+    if (m_hasPrevious && info.beaconLoss >= m_prevBeaconLoss) {
+        if (update(Metric::BeaconLoss, info.beaconLoss - m_prevBeaconLoss, timestampMs, events[count])) {
+            ++count;
+        }
+    }
+
+    m_prevTxRetries = info.txRetries;
+    m_prevTxPackets = info.txPackets;
+    m_prevBeaconLoss = info.beaconLoss;
+    m_hasPrevious = true;
+
+    return count;
+}
+
+int LinkDetector::addSignal(int64_t timestampMs, int32_t signalDbm, Event *events)
+{
+    m_hasPrevious = false;
+    if (signalDbm != 0 && update(Metric::Signal, signalDbm, timestampMs, events[0])) {
+        return 1;
+    }
+    return 0;
+}
+
+void LinkDetector::reset()
+{
+    for (State &state : m_states) {
+        state = State{};
+    }
+    m_hasPrevious = false;
+    m_prevTxRetries = 0;
+    m_prevTxPackets = 0;
+    m_prevBeaconLoss = 0;
+}
+
+bool LinkDetector::isDegraded(Metric metric) const
+{
+    return m_states[static_cast<int>(metric)].degraded;
+}
+
+bool LinkDetector::anyDegraded() const
+{
+    return std::any_of(std::begin(m_states), std::end(m_states), [](const State &state) {
+        return state.degraded;
+    });
+}
+
+const char *LinkDetector::metricName(Metric metric)
+{
+    switch (metric) {
+        case Metric::Signal:     return "signal";
+        case Metric::RetryRatio: return "retryRatio";
+        case Metric::BeaconLoss: return "beaconLoss";
+        case Metric::AckSignal:  return "ackSignal";
+    }
+    return "unknown";
+}
+
+bool LinkDetector::update(Metric metric, double value, int64_t timestampMs, Event &event)
+{
+    const Tuning &t = tuning(metric);
+    State &state = m_states[static_cast<int>(metric)];
+
+    if (state.warmup < warmupSamples) {
+        state.baseline += (value - state.baseline) / (state.warmup + 1);
+        ++state.warmup;
+        return false;
+    }
+
+    // Positive deviation always means "worse than baseline".
+    const double deviation = t.higherIsWorse ? value - state.baseline : state.baseline - value;
+
+    if (!state.degraded) {
+        state.degradeSum = std::max(0.0, state.degradeSum + deviation - t.slack);
+        if (state.degradeSum > t.threshold) {
+            state.degraded = true;
+            state.degradeSum = 0.0;
+            state.recoverSum = 0.0;
+            event = Event{timestampMs, metric, EventKind::Degraded, value, state.baseline};
+            return true;
+        }
+        state.baseline += baselineAlpha * (value - state.baseline);
+        return false;
+    }
+
+    // Baseline stays frozen while degraded; recovery needs a sustained return towards it.
+    state.recoverSum = std::max(0.0, state.recoverSum + t.recoverySlack - deviation);
+    if (state.recoverSum > t.recoveryThreshold) {
+        state.degraded = false;
+        state.degradeSum = 0.0;
+        state.recoverSum = 0.0;
+        event = Event{timestampMs, metric, EventKind::Recovered, value, state.baseline};
+        return true;
+    }
+    return false;
+}
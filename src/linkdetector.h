@@ -0,0 +1,78 @@
+#pragma once
+
+#include "nl80211helper.h"
+
+#include <cstdint>
+
+/**
+ * @brief Streaming change-point detector for link degradation
+ *
+ * Runs a one-sided CUSUM per metric against a slowly adapting baseline.
+ * Each sample costs O(1) and no allocation. Once a metric is flagged as
+ * degraded its baseline is frozen, and it is only reported as recovered after
+ * it has stayed near that baseline for a while. The separate recovery
+ * statistic gives the hysteresis that stops events flapping on a noisy link.
+ */
+class LinkDetector
+{
+public:
+    enum class Metric : uint8_t {
+        Signal = 0,
+        RetryRatio,
+        BeaconLoss,
+        AckSignal,
+    };
+    static constexpr int metricCount = 4;
+
+    enum class EventKind : uint8_t {
+        Degraded = 0,
+        Recovered,
+    };
+
+    struct Event {
+        int64_t timestampMs = 0;
+        Metric metric = Metric::Signal;
+        EventKind kind = EventKind::Degraded;
+        double value = 0.0;     // metric value that triggered the event
+        double baseline = 0.0;  // pre-degradation level
+    };
+
+    // Feeds one sample. Writes up to metricCount events into @p events and returns how many.
+    int addSample(int64_t timestampMs, const Nl80211StationInfo &info, Event *events);
+    // Feeds a sample that only has the signal level. The counter metrics
+    // restart from the next full sample rather than span the gap.
+    int addSignal(int64_t timestampMs, int32_t signalDbm, Event *events);
+    void reset();
+
+    [[nodiscard]] bool isDegraded(Metric metric) const;
+    [[nodiscard]] bool anyDegraded() const;
+
+    static const char *metricName(Metric metric);
+
+private:
+    struct Tuning {
+        double slack;            // k: deviation tolerated without accumulating
+        double threshold;        // h: accumulated deviation that raises an event
+        double recoverySlack;    // deviation still considered "back to normal"
+        double recoveryThreshold;
+        bool higherIsWorse;
+    };
+
+    struct State {
+        double baseline = 0.0;
+        double degradeSum = 0.0;
+        double recoverSum = 0.0;
+        int warmup = 0;
+        bool degraded = false;
+    };
+
+    static const Tuning &tuning(Metric metric);
+    bool update(Metric metric, double value, int64_t timestampMs, Event &event);
+
+    State m_states[metricCount];
+
+    bool m_hasPrevious = false;
+    uint32_t m_prevTxRetries = 0;
+    uint32_t m_prevTxPackets = 0;
+    uint32_t m_prevBeaconLoss = 0;
+};
@@ -0,0 +1,123 @@
+#include "mlolinkmodel.h"
+#include "stationtable.h"
+#include "wiphycapabilities.h"
+
+#include <algorithm>
+
+MloLinkModel::MloLinkModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int MloLinkModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_count;
+}
+
+QVariant MloLinkModel::data(const QModelIndex &index, int role) const
+{
+    if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid)) {
+        return {};
+    }
+
+    const Nl80211StationInfo::Link &link = m_links[index.row()];
+    switch (role) {
+        case Qt::DisplayRole:
+        case LinkIdRole:       return link.linkId;
+        case AddressRole:      return StationTable::macToString(StationTable::packMac(link.address));
+        case FrequencyRole:    return link.frequencyMhz;
+        case ChannelRole:      return link.frequencyMhz ? Nl80211Helper::frequencyToChannel(link.frequencyMhz) : 0;
+        case BandRole: {
+            WiphyBand::Id id;
+            return link.frequencyMhz && WiphyCapabilities::bandFromRange(link.frequencyMhz, id)
+                ? QString::fromLatin1(WiphyCapabilities::bandName(id))
+                : QString();
+        }
+        case SignalRole:       return link.signalDbm;
+        case SignalAvgRole:    return link.signalAvgDbm;
+        case RxRateRole:       return link.rxBitrate / 10.0;
+        case TxRateRole:       return link.txBitrate / 10.0;
+        case GenerationRole:   return QString::fromLatin1(Nl80211Helper::wifiModeToGeneration(link.rxMode));
+        case McsRole:          return link.rxMcs;
+        case NssRole:          return link.rxNss;
+        case ChannelWidthRole: return Nl80211Helper::channelWidthToMhz(link.rxChannelWidth);
+        case RxBytesRole:      return static_cast<qulonglong>(link.rxBytes);
+        case TxBytesRole:      return static_cast<qulonglong>(link.txBytes);
+        case TxRetriesRole:    return link.txRetries;
+        case TxFailedRole:     return link.txFailed;
+        case RxShareRole:      return m_rxTotal ? static_cast<double>(link.rxBitrate) / m_rxTotal : 0.0;
+        default:               return {};
+    }
+}
+
+QHash<int, QByteArray> MloLinkModel::roleNames() const
+{
+    return {
+        {LinkIdRole, QByteArrayLiteral("linkId")},
+        {AddressRole, QByteArrayLiteral("address")},
+        {FrequencyRole, QByteArrayLiteral("frequency")},
+        {ChannelRole, QByteArrayLiteral("channel")},
+        {BandRole, QByteArrayLiteral("band")},
+        {SignalRole, QByteArrayLiteral("signal")},
+        {SignalAvgRole, QByteArrayLiteral("signalAvg")},
+        {RxRateRole, QByteArrayLiteral("rxRate")},
+        {TxRateRole, QByteArrayLiteral("txRate")},
+        {GenerationRole, QByteArrayLiteral("generation")},
+        {McsRole, QByteArrayLiteral("mcs")},
+        {NssRole, QByteArrayLiteral("nss")},
+        {ChannelWidthRole, QByteArrayLiteral("channelWidth")},
+        {RxBytesRole, QByteArrayLiteral("rxBytes")},
+        {TxBytesRole, QByteArrayLiteral("txBytes")},
+        {TxRetriesRole, QByteArrayLiteral("txRetries")},
+        {TxFailedRole, QByteArrayLiteral("txFailed")},
+        {RxShareRole, QByteArrayLiteral("rxShare")},
+    };
+}
+
+void MloLinkModel::update(const Nl80211StationInfo &info)
+{
+    Nl80211StationInfo::Link links[Nl80211StationInfo::maxLinks];
+    const int count = std::min<int>(info.linkCount, Nl80211StationInfo::maxLinks);
+    std::copy(info.links, info.links + count, links);
+    std::sort(links, links + count, [](const Nl80211StationInfo::Link &a, const Nl80211StationInfo::Link &b) {
+        return a.linkId < b.linkId;
+    });
+
+    m_rxTotal = 0;
+    for (int i = 0; i < count; ++i) {
+        m_rxTotal += links[i].rxBitrate;
+    }
+
+    const bool sameLayout = count == m_count
+        && std::equal(links, links + count, m_links, [](const Nl80211StationInfo::Link &a, const Nl80211StationInfo::Link &b) {
+               return a.linkId == b.linkId;
+           });
+    if (sameLayout) {
+        std::copy(links, links + count, m_links);
+        if (m_count > 0) {
+            Q_EMIT dataChanged(index(0), index(m_count - 1));
+        }
+        return;
+    }
+
+    const bool countChanging = count != m_count;
+    beginResetModel();
+    std::copy(links, links + count, m_links);
+    m_count = count;
+    endResetModel();
+    if (countChanging) {
+        Q_EMIT countChanged();
+    }
+}
+
+void MloLinkModel::clear()
+{
+    if (m_count == 0) {
+        return;
+    }
+    beginResetModel();
+    m_count = 0;
+    m_rxTotal = 0;
+    endResetModel();
+    Q_EMIT countChanged();
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QAbstractListModel>
+
+#include "nl80211helper.h"
+
+/**
+ * @brief Links of a Wi-Fi 7 multi-link (MLO) association for QML views
+ *
+ * One row per affiliated link, in link id order, copied from the station
+ * info of each sample into fixed storage. Empty for single-link
+ * associations. While the set of link ids stays the same only dataChanged()
+ * is emitted, so delegates are updated in place.
+ */
+class MloLinkModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+
+public:
+    enum Roles {
+        LinkIdRole = Qt::UserRole + 1,
+        AddressRole,
+        FrequencyRole,
+        ChannelRole,
+        BandRole,
+        SignalRole,
+        SignalAvgRole,
+        RxRateRole,
+        TxRateRole,
+        GenerationRole,
+        McsRole,
+        NssRole,
+        ChannelWidthRole,
+        RxBytesRole,
+        TxBytesRole,
+        TxRetriesRole,
+        TxFailedRole,
+        // Fraction of the aggregate RX rate carried by this link.
+        RxShareRole,
+    };
+    Q_ENUM(Roles)
+
+    explicit MloLinkModel(QObject *parent = nullptr);
+
+    [[nodiscard]] int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    [[nodiscard]] QVariant data(const QModelIndex &index, int role) const override;
+    [[nodiscard]] QHash<int, QByteArray> roleNames() const override;
+
+    // Replaces the rows with the links of @p info.
+    void update(const Nl80211StationInfo &info);
+    void clear();
+
+Q_SIGNALS:
+    void countChanged();
+
+private:
+    Nl80211StationInfo::Link m_links[Nl80211StationInfo::maxLinks];
+    int m_count = 0;
+    uint32_t m_rxTotal = 0;
+};
@@ -0,0 +1,188 @@
+#include "nl80211events.h"
+#include "eventtimeline.h"
+
+#include <QSocketNotifier>
+
+#include <cstring>
+
+#include <netlink/netlink.h>
+#include <netlink/genl/genl.h>
+#include <netlink/genl/ctrl.h>
+#include <linux/nl80211.h>
+
+namespace {
+
+constexpr char familyName[] = "nl80211";
+
+struct Dispatch {
+    Nl80211Events *self = nullptr;
+    int familyAdded = 0;
+    int familyRemoved = 0;
+};
+
+// NEWFAMILY/DELFAMILY from the generic netlink controller.
+void controlEvent(struct nlmsghdr *hdr, Dispatch *dispatch)
+{
+    auto *gnlh = static_cast<genlmsghdr *>(nlmsg_data(hdr));
+    if (gnlh->cmd != CTRL_CMD_NEWFAMILY && gnlh->cmd != CTRL_CMD_DELFAMILY) {
+        return;
+    }
+    struct nlattr *tb[CTRL_ATTR_MAX + 1] = {};
+    if (nla_parse(tb, CTRL_ATTR_MAX, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), nullptr) < 0
+        || !tb[CTRL_ATTR_FAMILY_NAME] || std::strcmp(nla_get_string(tb[CTRL_ATTR_FAMILY_NAME]), familyName) != 0) {
+        return;
+    }
+    ++(gnlh->cmd == CTRL_CMD_NEWFAMILY ? dispatch->familyAdded : dispatch->familyRemoved);
+}
+
+int eventCallback(struct nl_msg *msg, void *arg)
+{
+    auto *dispatch = static_cast<Dispatch *>(arg);
+    auto *self = dispatch->self;
+    if (nlmsg_hdr(msg)->nlmsg_type == GENL_ID_CTRL) {
+        controlEvent(nlmsg_hdr(msg), dispatch);
+        return NL_OK;
+    }
+    auto *gnlh = static_cast<genlmsghdr *>(nlmsg_data(nlmsg_hdr(msg)));
+    struct nlattr *tb[NL80211_ATTR_MAX + 1] = {};
+
+    if (nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), nullptr) < 0) {
+        return NL_SKIP;
+    }
+
+    switch (gnlh->cmd) {
+    case NL80211_CMD_NEW_WIPHY:
+    case NL80211_CMD_DEL_WIPHY: {
+        const int wiphy = tb[NL80211_ATTR_WIPHY] ? static_cast<int>(nla_get_u32(tb[NL80211_ATTR_WIPHY])) : -1;
+        EventTimeline::record(EventTimeline::Kind::WiphyChanged, wiphy);
+        Q_EMIT self->wiphyChanged(wiphy);
+        break;
+    }
+    case NL80211_CMD_NEW_INTERFACE:
+    case NL80211_CMD_DEL_INTERFACE:
+    case NL80211_CMD_SET_INTERFACE: {
+        const int ifindex = tb[NL80211_ATTR_IFINDEX] ? static_cast<int>(nla_get_u32(tb[NL80211_ATTR_IFINDEX])) : -1;
+        const int wiphy = tb[NL80211_ATTR_WIPHY] ? static_cast<int>(nla_get_u32(tb[NL80211_ATTR_WIPHY])) : -1;
+        EventTimeline::record(EventTimeline::Kind::InterfaceChanged, ifindex);
+        Q_EMIT self->interfaceChanged(ifindex, wiphy);
+        break;
+    }
+    default:
+        break;
+    }
+    return NL_OK;
+}
+
+} // namespace
+
+Nl80211Events::Nl80211Events(QObject *parent)
+    : QObject(parent)
+{
+}
+
+Nl80211Events::~Nl80211Events()
+{
+    stop();
+}
+
+bool Nl80211Events::start()
+{
+    if (m_socket) {
+        return true;
+    }
+
+    m_socket = nl_socket_alloc();
+    if (!m_socket) {
+        return false;
+    }
+
+    // Notifications are unsolicited, so there is no sequence number to match.
+    nl_socket_disable_seq_check(m_socket);
+
+    if (genl_connect(m_socket) < 0) {
+        stop();
+        return false;
+    }
+
+    const int control = genl_ctrl_resolve_grp(m_socket, "nlctrl", "notify");
+    if (control < 0 || nl_socket_add_membership(m_socket, control) < 0) {
+        stop();
+        return false;
+    }
+    subscribe();
+
+    nl_socket_set_nonblocking(m_socket);
+
+    m_notifier = new QSocketNotifier(nl_socket_get_fd(m_socket), QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &Nl80211Events::onReadable);
+    return true;
+}
+
+bool Nl80211Events::subscribe()
+{
+    // The group id is per registration; after a reload it may have changed.
+    const int group = genl_ctrl_resolve_grp(m_socket, familyName, "config");
+    m_subscribed = group >= 0 && nl_socket_add_membership(m_socket, group) >= 0;
+    return m_subscribed;
+}
+
+void Nl80211Events::stop()
+{
+    delete m_notifier;
+    m_notifier = nullptr;
+    if (m_socket) {
+        nl_socket_free(m_socket);
+        m_socket = nullptr;
+    }
+    m_subscribed = false;
+}
+
+bool Nl80211Events::isActive() const
+{
+    return m_socket != nullptr;
+}
+
+bool Nl80211Events::subscribed() const
+{
+    return m_subscribed;
+}
+
+void Nl80211Events::onReadable()
+{
+    struct nl_cb *cb = nl_cb_alloc(NL_CB_DEFAULT);
+    if (!cb) {
+        return;
+    }
+    Dispatch dispatch;
+    dispatch.self = this;
+    nl_cb_set(cb, NL_CB_VALID, NL_CB_CUSTOM, eventCallback, &dispatch);
+
+    // Drain everything queued; the non-blocking socket reports -NLE_AGAIN once
+    // empty. An overrun (ENOBUFS, reported as -NLE_NOMEM) is not the end.
+    bool overran = false;
+    for (;;) {
+        const int ret = nl_recvmsgs_report(m_socket, cb);
+        if (ret == -NLE_NOMEM) {
+            overran = true;
+            continue;
+        }
+        if (ret <= 0) {
+            break;
+        }
+    }
+    nl_cb_put(cb);
+
+    // The kernel drops the membership with the family; rejoin once it is back.
+    if (dispatch.familyRemoved > 0) {
+        m_subscribed = false;
+    }
+    if (dispatch.familyAdded > 0) {
+        subscribe();
+    }
+    if (dispatch.familyRemoved > 0 || dispatch.familyAdded > 0) {
+        Q_EMIT familyChanged(dispatch.familyAdded > 0 && m_subscribed);
+    }
+    if (overran) {
+        Q_EMIT overrun();
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QObject>
+
+struct nl_sock;
+class QSocketNotifier;
+
+/**
+ * @brief nl80211 multicast listener
+ *
+ * Joins the "config" multicast group on its own netlink socket and turns
+ * wiphy and interface add/remove/rename notifications into Qt signals.
+ * The socket is driven by a QSocketNotifier, so nothing is polled.
+ *
+ * It also listens to the generic netlink controller, so it notices nl80211
+ * itself going away and coming back (cfg80211 reloaded or loaded late) and
+ * rejoins the config group on its own.
+ */
+class Nl80211Events : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit Nl80211Events(QObject *parent = nullptr);
+    ~Nl80211Events() override;
+
+    // Opens the socket and subscribes. Safe to call again after a failure.
+    // Succeeds without nl80211 present; see subscribed().
+    bool start();
+    void stop();
+    [[nodiscard]] bool isActive() const;
+    // Whether the nl80211 config group is joined.
+    [[nodiscard]] bool subscribed() const;
+
+Q_SIGNALS:
+    // A radio was added, removed or changed (NEW_WIPHY/DEL_WIPHY).
+    void wiphyChanged(int wiphyIndex);
+    // A network interface was added, removed or changed (NEW/DEL/SET_INTERFACE).
+    // @p wiphyIndex is the radio it belongs to, -1 if the event did not say.
+    void interfaceChanged(int ifindex, int wiphyIndex);
+    // The nl80211 family was registered (@p available) or unregistered.
+    void familyChanged(bool available);
+    // The socket's receive queue overflowed; notifications were lost.
+    void overrun();
+
+private:
+    void onReadable();
+    bool subscribe();
+
+    struct nl_sock *m_socket = nullptr;
+    QSocketNotifier *m_notifier = nullptr;
+    bool m_subscribed = false;
+};
@@ -1,10 +1,18 @@
 #include "nl80211helper.h"
+#include "profiler.h"
+#include "stationtable.h"
+#include "wiphycapabilities.h"
+
+#include <QStringList>
+#include <QtGlobal>
 
 #include <netlink/netlink.h>
 #include <netlink/genl/genl.h>
 #include <netlink/genl/ctrl.h>
 #include <linux/nl80211.h>
 #include <net/if.h>
+#include <sys/socket.h>
+#include <algorithm>
 #include <cstring>
 #include <cerrno>
 
@@ -12,12 +20,36 @@ namespace {
 
 struct CallbackData {
     Nl80211StationInfo* info = nullptr;
+    // Set for dumps: every station goes into its own table entry instead of info.
+    StationTable* table = nullptr;
     int errorCode = 0;
+    int systemError = 0; // errno of a failed recv()
     bool partialParse = false;
 };
 
+// Closest errno for a libnl error code, so callers see one error space.
+int errnoFromNle(int nleError) {
+    switch (nleError < 0 ? -nleError : nleError) {
+        case 0:                    return 0;
+        case NLE_PERM:             return EPERM;
+        case NLE_NOACCESS:         return EACCES;
+        case NLE_NOMEM:            return ENOBUFS; // libnl folds ENOBUFS (socket overrun) into this
+        case NLE_NODEV:            return ENODEV;
+        case NLE_OBJ_NOTFOUND:     return ENOENT;
+        case NLE_AGAIN:            return EAGAIN;
+        case NLE_INTR:             return EINTR;
+        case NLE_BAD_SOCK:         return EBADF;
+        case NLE_AF_NOSUPPORT:     return EAFNOSUPPORT;
+        case NLE_PROTO_MISMATCH:   return EPROTONOSUPPORT;
+        case NLE_OPNOTSUPP:        return EOPNOTSUPP;
+        case NLE_MSG_TRUNC:        return EMSGSIZE;
+        default:                   return EIO;
+    }
+}
+
 int parseRateInfo(struct nlattr* rateAttr, uint32_t& bitrate, uint8_t& mcs, 
-                  uint8_t& nss, uint8_t& width, Nl80211StationInfo::WifiMode& mode) {
+                  uint8_t& nss, uint8_t& width, Nl80211StationInfo::WifiMode& mode,
+                  Nl80211StationInfo::GuardInterval& gi, bool& dcm) {
     struct nlattr* rateInfo[NL80211_RATE_INFO_MAX + 1] = {};
     
     if (nla_parse_nested(rateInfo, NL80211_RATE_INFO_MAX, rateAttr, nullptr) < 0) {
@@ -54,6 +86,26 @@ int parseRateInfo(struct nlattr* rateAttr, uint32_t& bitrate, uint8_t& mcs,
         nss = (mcs / 8) + 1;
     }
     
+    gi = Nl80211StationInfo::GuardInterval::Gi0_8;
+    dcm = false;
+    
+    if (mode == Nl80211StationInfo::WifiMode::EHT || mode == Nl80211StationInfo::WifiMode::HE) {
+        const int giAttr = mode == Nl80211StationInfo::WifiMode::EHT ? NL80211_RATE_INFO_EHT_GI : NL80211_RATE_INFO_HE_GI;
+        if (rateInfo[giAttr]) {
+            // HE and EHT GI enums share the 0.8/1.6/3.2 us ordering.
+            switch (nla_get_u8(rateInfo[giAttr])) {
+                case NL80211_RATE_INFO_HE_GI_1_6: gi = Nl80211StationInfo::GuardInterval::Gi1_6; break;
+                case NL80211_RATE_INFO_HE_GI_3_2: gi = Nl80211StationInfo::GuardInterval::Gi3_2; break;
+                default: break;
+            }
+        }
+        if (rateInfo[NL80211_RATE_INFO_HE_DCM]) {
+            dcm = nla_get_u8(rateInfo[NL80211_RATE_INFO_HE_DCM]) != 0;
+        }
+    } else if (rateInfo[NL80211_RATE_INFO_SHORT_GI]) {
+        gi = Nl80211StationInfo::GuardInterval::Gi0_4;
+    }
+    
     if (rateInfo[NL80211_RATE_INFO_320_MHZ_WIDTH]) {
         width = 5;
     } else if (rateInfo[NL80211_RATE_INFO_160_MHZ_WIDTH]) {
@@ -71,30 +123,29 @@ int parseRateInfo(struct nlattr* rateAttr, uint32_t& bitrate, uint8_t& mcs,
     return 0;
 }
 
-int stationInfoCallback(struct nl_msg* msg, void* arg) {
-    auto* data = static_cast<CallbackData*>(arg);
-    if (!data || !data->info) return NL_SKIP;
+uint8_t parseChainSignal(struct nlattr* chainAttr, int32_t* out) {
+    uint8_t count = 0;
+    struct nlattr* attr = nullptr;
+    int rem = 0;
     
-    struct nlattr* tb[NL80211_ATTR_MAX + 1] = {};
-    struct genlmsghdr* gnlh = static_cast<genlmsghdr*>(nlmsg_data(nlmsg_hdr(msg)));
+    std::fill_n(out, Nl80211StationInfo::maxChains, 0);
     
-    if (nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
-                  genlmsg_attrlen(gnlh, 0), nullptr) < 0) {
-        return NL_SKIP;
-    }
-    
-    if (!tb[NL80211_ATTR_STA_INFO]) {
-        return NL_SKIP;
-    }
-    
-    struct nlattr* sinfo[NL80211_STA_INFO_MAX + 1];
-    if (nla_parse_nested(sinfo, NL80211_STA_INFO_MAX, tb[NL80211_ATTR_STA_INFO], nullptr) < 0) {
-        return NL_SKIP;
+    // One u8 attribute per set bit of the antenna mask, typed by the chain
+    // index, so a mask like 0b101 leaves a gap at chain 1.
+    nla_for_each_nested(attr, chainAttr, rem) {
+        const int chain = nla_type(attr);
+        if (chain >= Nl80211StationInfo::maxChains) {
+            continue;
+        }
+        out[chain] = static_cast<int8_t>(nla_get_u8(attr));
+        count = qMax<uint8_t>(count, chain + 1);
     }
     
-    auto& info = *data->info;
-    info.valid = true;
-    
+    return count;
+}
+
+// NL80211_STA_INFO_* attributes, shared by the MLD-level entry and each link.
+void parseStationAttributes(struct nlattr** sinfo, Nl80211StationInfo& info, CallbackData* data) {
     if (sinfo[NL80211_STA_INFO_SIGNAL]) {
         info.signalDbm = static_cast<int8_t>(nla_get_u8(sinfo[NL80211_STA_INFO_SIGNAL]));
     }
@@ -103,26 +154,43 @@ int stationInfoCallback(struct nl_msg* msg, void* arg) {
         info.signalAvgDbm = static_cast<int8_t>(nla_get_u8(sinfo[NL80211_STA_INFO_SIGNAL_AVG]));
     }
     
+    if (sinfo[NL80211_STA_INFO_CHAIN_SIGNAL]) {
+        info.chainCount = parseChainSignal(sinfo[NL80211_STA_INFO_CHAIN_SIGNAL], info.chainSignal);
+    }
+    
+    if (sinfo[NL80211_STA_INFO_CHAIN_SIGNAL_AVG]) {
+        const uint8_t avgCount = parseChainSignal(sinfo[NL80211_STA_INFO_CHAIN_SIGNAL_AVG], info.chainSignalAvg);
+        if (info.chainCount == 0) {
+            info.chainCount = avgCount;
+        }
+    }
+    
     if (sinfo[NL80211_STA_INFO_TX_BITRATE]) {
         if (parseRateInfo(sinfo[NL80211_STA_INFO_TX_BITRATE],
-                          info.txBitrate, info.txMcs, info.txNss, info.txChannelWidth, info.txMode) < 0) {
+                          info.txBitrate, info.txMcs, info.txNss, info.txChannelWidth, info.txMode,
+                          info.txGuardInterval, info.txDcm) < 0) {
             info.txBitrate = 0;
             info.txMcs = 0;
             info.txNss = 0;
             info.txChannelWidth = 0;
             info.txMode = Nl80211StationInfo::WifiMode::Unknown;
+            info.txGuardInterval = Nl80211StationInfo::GuardInterval::Gi0_8;
+            info.txDcm = false;
             data->partialParse = true;
         }
     }
     
     if (sinfo[NL80211_STA_INFO_RX_BITRATE]) {
         if (parseRateInfo(sinfo[NL80211_STA_INFO_RX_BITRATE],
-                          info.rxBitrate, info.rxMcs, info.rxNss, info.rxChannelWidth, info.rxMode) < 0) {
+                          info.rxBitrate, info.rxMcs, info.rxNss, info.rxChannelWidth, info.rxMode,
+                          info.rxGuardInterval, info.rxDcm) < 0) {
             info.rxBitrate = 0;
             info.rxMcs = 0;
             info.rxNss = 0;
             info.rxChannelWidth = 0;
             info.rxMode = Nl80211StationInfo::WifiMode::Unknown;
+            info.rxGuardInterval = Nl80211StationInfo::GuardInterval::Gi0_8;
+            info.rxDcm = false;
             data->partialParse = true;
         }
     }
@@ -203,10 +271,462 @@ int stationInfoCallback(struct nl_msg* msg, void* arg) {
     if (sinfo[NL80211_STA_INFO_TX_DURATION]) {
         info.txDuration = nla_get_u64(sinfo[NL80211_STA_INFO_TX_DURATION]);
     }
+}
+
+// Per-link station info of an MLO association. Each entry of the nested
+// array carries NL80211_ATTR_MLO_LINK_ID, the AP's link address in
+// NL80211_ATTR_MAC and its own NL80211_ATTR_STA_INFO.
+// @p sinfo is the MLD-level STA_INFO, to tell which fields it left out.
+void parseMloLinks(struct nlattr* linksAttr, struct nlattr** sinfo, Nl80211StationInfo& info, CallbackData* data) {
+    struct nlattr* linkAttr;
+    int remaining;
+    nla_for_each_nested(linkAttr, linksAttr, remaining) {
+        if (info.linkCount >= Nl80211StationInfo::maxLinks) {
+            break;
+        }
+        struct nlattr* ltb[NL80211_ATTR_MAX + 1] = {};
+        struct nlattr* lsinfo[NL80211_STA_INFO_MAX + 1];
+        if (nla_parse_nested(ltb, NL80211_ATTR_MAX, linkAttr, nullptr) < 0
+            || !ltb[NL80211_ATTR_STA_INFO]
+            || nla_parse_nested(lsinfo, NL80211_STA_INFO_MAX, ltb[NL80211_ATTR_STA_INFO], nullptr) < 0) {
+            continue;
+        }
+        
+        Nl80211StationInfo parsed;
+        parseStationAttributes(lsinfo, parsed, data);
+        
+        auto& link = info.links[info.linkCount++];
+        link = Nl80211StationInfo::Link{};
+        if (ltb[NL80211_ATTR_MLO_LINK_ID]) {
+            link.linkId = nla_get_u8(ltb[NL80211_ATTR_MLO_LINK_ID]);
+        }
+        if (ltb[NL80211_ATTR_MAC] && nla_len(ltb[NL80211_ATTR_MAC]) >= 6) {
+            std::memcpy(link.address, nla_data(ltb[NL80211_ATTR_MAC]), sizeof(link.address));
+        }
+        link.signalDbm = parsed.signalDbm;
+        link.signalAvgDbm = parsed.signalAvgDbm;
+        link.txBitrate = parsed.txBitrate;
+        link.rxBitrate = parsed.rxBitrate;
+        link.txMcs = parsed.txMcs;
+        link.rxMcs = parsed.rxMcs;
+        link.txNss = parsed.txNss;
+        link.rxNss = parsed.rxNss;
+        link.txChannelWidth = parsed.txChannelWidth;
+        link.rxChannelWidth = parsed.rxChannelWidth;
+        link.txMode = parsed.txMode;
+        link.rxMode = parsed.rxMode;
+        link.rxBytes = parsed.rxBytes;
+        link.txBytes = parsed.txBytes;
+        link.rxPackets = parsed.rxPackets;
+        link.txPackets = parsed.txPackets;
+        link.txRetries = parsed.txRetries;
+        link.txFailed = parsed.txFailed;
+    }
+    if (info.linkCount == 0) {
+        return;
+    }
     
+    // The MLD-level entry reports at most one link's rate; the association
+    // moves the sum of all of them.
+    // Rate control runs per direction, so the fastest TX link need not be the fastest RX one.
+    int fastestTx = 0;
+    int fastestRx = 0;
+    int strongest = 0;
+    uint32_t txSum = 0;
+    uint32_t rxSum = 0;
+    for (int i = 0; i < info.linkCount; ++i) {
+        const auto& link = info.links[i];
+        txSum += link.txBitrate;
+        rxSum += link.rxBitrate;
+        if (link.txBitrate > info.links[fastestTx].txBitrate) {
+            fastestTx = i;
+        }
+        if (link.rxBitrate > info.links[fastestRx].rxBitrate) {
+            fastestRx = i;
+        }
+        if (link.signalDbm != 0 && (info.links[strongest].signalDbm == 0 || link.signalDbm > info.links[strongest].signalDbm)) {
+            strongest = i;
+        }
+    }
+    if (!sinfo[NL80211_STA_INFO_TX_BITRATE]) {
+        const auto& best = info.links[fastestTx];
+        info.txMcs = best.txMcs;
+        info.txNss = best.txNss;
+        info.txChannelWidth = best.txChannelWidth;
+        info.txMode = best.txMode;
+    }
+    if (!sinfo[NL80211_STA_INFO_RX_BITRATE]) {
+        const auto& best = info.links[fastestRx];
+        info.rxMcs = best.rxMcs;
+        info.rxNss = best.rxNss;
+        info.rxChannelWidth = best.rxChannelWidth;
+        info.rxMode = best.rxMode;
+    }
+    info.txBitrate = txSum;
+    info.rxBitrate = rxSum;
+    if (!sinfo[NL80211_STA_INFO_SIGNAL]) {
+        info.signalDbm = info.links[strongest].signalDbm;
+        info.signalAvgDbm = info.links[strongest].signalAvgDbm;
+    }
+    // Drivers normally accumulate the counters at MLD level; sum the links
+    // when they do not.
+    if (!sinfo[NL80211_STA_INFO_RX_BYTES64] && !sinfo[NL80211_STA_INFO_RX_BYTES]) {
+        info.rxBytes = 0;
+        info.txBytes = 0;
+        info.rxPackets = 0;
+        info.txPackets = 0;
+        info.txRetries = 0;
+        info.txFailed = 0;
+        for (int i = 0; i < info.linkCount; ++i) {
+            const auto& link = info.links[i];
+            info.rxBytes += link.rxBytes;
+            info.txBytes += link.txBytes;
+            info.rxPackets += link.rxPackets;
+            info.txPackets += link.txPackets;
+            info.txRetries += link.txRetries;
+            info.txFailed += link.txFailed;
+        }
+    }
+}
+
+int parseStation(struct nlmsghdr* hdr, CallbackData* data) {
+    if (!data || (!data->info && !data->table)) return NL_SKIP;
+    
+    const Profiler::Scope profile(Profiler::Stage::Parse);
+    
+    struct nlattr* tb[NL80211_ATTR_MAX + 1] = {};
+    struct genlmsghdr* gnlh = static_cast<genlmsghdr*>(nlmsg_data(hdr));
+    
+    if (nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+                  genlmsg_attrlen(gnlh, 0), nullptr) < 0) {
+        return NL_SKIP;
+    }
+    
+    if (!tb[NL80211_ATTR_STA_INFO]) {
+        return NL_SKIP;
+    }
+    
+    struct nlattr* sinfo[NL80211_STA_INFO_MAX + 1];
+    if (nla_parse_nested(sinfo, NL80211_STA_INFO_MAX, tb[NL80211_ATTR_STA_INFO], nullptr) < 0) {
+        return NL_SKIP;
+    }
+    
+    Nl80211StationInfo* target = data->info;
+    if (data->table) {
+        if (!tb[NL80211_ATTR_MAC] || nla_len(tb[NL80211_ATTR_MAC]) < 6) {
+            return NL_SKIP;
+        }
+        target = &data->table->upsert(static_cast<const uint8_t*>(nla_data(tb[NL80211_ATTR_MAC])));
+    }
+    
+    auto& info = *target;
+    info.valid = true;
+    
+    parseStationAttributes(sinfo, info, data);
+    
+    info.linkCount = 0;
+    if (tb[NL80211_ATTR_MLO_LINKS]) {
+        parseMloLinks(tb[NL80211_ATTR_MLO_LINKS], sinfo, info, data);
+    }
+    
+    return NL_OK;
+}
+
+// Reads the replies to request @p seq into @p buffer and hands them to
+// parseStation(). Unlike nl_recvmsgs() this allocates nothing. Returns 0
+// or a negative NLE code; a kernel error is left in data->errorCode.
+int receiveStationReplies(struct nl_sock* sock, uint32_t seq, bool dump,
+                          unsigned char* buffer, size_t size, CallbackData* data) {
+    const int fd = nl_socket_get_fd(sock);
+    for (;;) {
+        ssize_t length;
+        do {
+            length = recv(fd, buffer, size, MSG_TRUNC);
+        } while (length < 0 && errno == EINTR);
+        if (length < 0) {
+            data->systemError = errno;
+            return -nl_syserr2nlerr(errno);
+        }
+        if (static_cast<size_t>(length) > size) {
+            return -NLE_MSG_TRUNC;
+        }
+
+        int remaining = static_cast<int>(length);
+        for (auto* hdr = reinterpret_cast<struct nlmsghdr*>(buffer); nlmsg_ok(hdr, remaining); hdr = nlmsg_next(hdr, &remaining)) {
+            if (hdr->nlmsg_seq != seq) {
+                continue; // left over from an earlier request
+            }
+            if (hdr->nlmsg_type == NLMSG_DONE) {
+                return 0;
+            }
+            if (hdr->nlmsg_type == NLMSG_ERROR) {
+                data->errorCode = static_cast<const struct nlmsgerr*>(nlmsg_data(hdr))->error;
+                return 0;
+            }
+            parseStation(hdr, data);
+            if (!dump) {
+                return 0; // no ACK requested, the reply is the whole answer
+            }
+        }
+    }
+}
+
+// Number of spatial streams in a 2-bit-per-stream VHT/HE MCS map (3 = unsupported).
+uint8_t nssFromMcsMap(uint16_t map) {
+    uint8_t nss = 0;
+    for (int i = 0; i < 8; ++i) {
+        if (((map >> (2 * i)) & 0x3) != 0x3) {
+            nss = static_cast<uint8_t>(i + 1);
+        }
+    }
+    return nss;
+}
+
+uint16_t readLe16(const uint8_t* data) {
+    return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+void parseBandIftypeData(struct nlattr* iftypeData, WiphyBand& band) {
+    struct nlattr* entry;
+    int rem;
+    nla_for_each_nested(entry, iftypeData, rem) {
+        struct nlattr* tb[NL80211_BAND_IFTYPE_ATTR_MAX + 1] = {};
+        if (nla_parse_nested(tb, NL80211_BAND_IFTYPE_ATTR_MAX, entry, nullptr) < 0) {
+            continue;
+        }
+
+        // Only the capabilities we have as a client matter.
+        bool station = false;
+        if (tb[NL80211_BAND_IFTYPE_ATTR_IFTYPES]) {
+            struct nlattr* iftype;
+            int iftypeRem;
+            nla_for_each_nested(iftype, tb[NL80211_BAND_IFTYPE_ATTR_IFTYPES], iftypeRem) {
+                if (nla_type(iftype) == NL80211_IFTYPE_STATION) {
+                    station = true;
+                }
+            }
+        }
+        if (!station) {
+            continue;
+        }
+
+        if (tb[NL80211_BAND_IFTYPE_ATTR_HE_CAP_PHY] && nla_len(tb[NL80211_BAND_IFTYPE_ATTR_HE_CAP_PHY]) >= 1) {
+            band.he = true;
+            // HE PHY capabilities, channel width set (B1..B4 of the first octet).
+            const uint8_t widthSet = static_cast<const uint8_t*>(nla_data(tb[NL80211_BAND_IFTYPE_ATTR_HE_CAP_PHY]))[0];
+            if (widthSet & 0x18) {
+                band.maxWidthMhz = qMax(band.maxWidthMhz, 160);
+            } else if (widthSet & 0x04) {
+                band.maxWidthMhz = qMax(band.maxWidthMhz, 80);
+            } else if (widthSet & 0x02) {
+                band.maxWidthMhz = qMax(band.maxWidthMhz, 40);
+            }
+        }
+        if (tb[NL80211_BAND_IFTYPE_ATTR_HE_CAP_MCS_SET] && nla_len(tb[NL80211_BAND_IFTYPE_ATTR_HE_CAP_MCS_SET]) >= 2) {
+            const auto* mcs = static_cast<const uint8_t*>(nla_data(tb[NL80211_BAND_IFTYPE_ATTR_HE_CAP_MCS_SET]));
+            band.maxNss = qMax(band.maxNss, nssFromMcsMap(readLe16(mcs)));
+        }
+
+        if (tb[NL80211_BAND_IFTYPE_ATTR_EHT_CAP_PHY] && nla_len(tb[NL80211_BAND_IFTYPE_ATTR_EHT_CAP_PHY]) >= 1) {
+            band.eht = true;
+            // EHT PHY capabilities B1: 320 MHz in 6 GHz.
+            const uint8_t phy0 = static_cast<const uint8_t*>(nla_data(tb[NL80211_BAND_IFTYPE_ATTR_EHT_CAP_PHY]))[0];
+            if (phy0 & 0x02) {
+                band.maxWidthMhz = qMax(band.maxWidthMhz, 320);
+            }
+        }
+        if (tb[NL80211_BAND_IFTYPE_ATTR_EHT_CAP_MCS_SET] && nla_len(tb[NL80211_BAND_IFTYPE_ATTR_EHT_CAP_MCS_SET]) >= 1) {
+            // Low nibble of the first octet is the RX max NSS for the lowest MCS group.
+            const uint8_t nss = static_cast<const uint8_t*>(nla_data(tb[NL80211_BAND_IFTYPE_ATTR_EHT_CAP_MCS_SET]))[0] & 0x0f;
+            band.maxNss = qMax(band.maxNss, nss);
+        }
+    }
+}
+
+// One split dump message carries a slice of a band; merge it into what we have.
+void parseBand(struct nlattr* bandAttr, WiphyBand& band) {
+    struct nlattr* tb[NL80211_BAND_ATTR_MAX + 1] = {};
+    if (nla_parse_nested(tb, NL80211_BAND_ATTR_MAX, bandAttr, nullptr) < 0) {
+        return;
+    }
+    band.present = true;
+
+    if (tb[NL80211_BAND_ATTR_HT_CAPA]) {
+        band.ht = true;
+        // HT capabilities info B1: 20/40 MHz supported.
+        if (nla_get_u16(tb[NL80211_BAND_ATTR_HT_CAPA]) & 0x0002) {
+            band.maxWidthMhz = qMax(band.maxWidthMhz, 40);
+        }
+    }
+    if (tb[NL80211_BAND_ATTR_HT_MCS_SET] && nla_len(tb[NL80211_BAND_ATTR_HT_MCS_SET]) >= 4) {
+        // RX MCS bitmask, one octet per spatial stream.
+        const auto* mask = static_cast<const uint8_t*>(nla_data(tb[NL80211_BAND_ATTR_HT_MCS_SET]));
+        uint8_t nss = 0;
+        for (int i = 0; i < 4; ++i) {
+            if (mask[i]) {
+                nss = static_cast<uint8_t>(i + 1);
+            }
+        }
+        band.maxNss = qMax(band.maxNss, nss);
+    }
+
+    if (tb[NL80211_BAND_ATTR_VHT_CAPA]) {
+        band.vht = true;
+        band.maxWidthMhz = qMax(band.maxWidthMhz, 80);
+        // VHT capabilities B2-B3: supported channel width set.
+        if ((nla_get_u32(tb[NL80211_BAND_ATTR_VHT_CAPA]) >> 2) & 0x3) {
+            band.maxWidthMhz = qMax(band.maxWidthMhz, 160);
+        }
+    }
+    if (tb[NL80211_BAND_ATTR_VHT_MCS_SET] && nla_len(tb[NL80211_BAND_ATTR_VHT_MCS_SET]) >= 2) {
+        const auto* mcs = static_cast<const uint8_t*>(nla_data(tb[NL80211_BAND_ATTR_VHT_MCS_SET]));
+        band.maxNss = qMax(band.maxNss, nssFromMcsMap(readLe16(mcs)));
+    }
+
+    if (tb[NL80211_BAND_ATTR_IFTYPE_DATA]) {
+        parseBandIftypeData(tb[NL80211_BAND_ATTR_IFTYPE_DATA], band);
+    }
+
+    if (tb[NL80211_BAND_ATTR_FREQS]) {
+        struct nlattr* freq;
+        int rem;
+        nla_for_each_nested(freq, tb[NL80211_BAND_ATTR_FREQS], rem) {
+            struct nlattr* ftb[NL80211_FREQUENCY_ATTR_MAX + 1] = {};
+            if (nla_parse_nested(ftb, NL80211_FREQUENCY_ATTR_MAX, freq, nullptr) < 0
+                || !ftb[NL80211_FREQUENCY_ATTR_FREQ] || ftb[NL80211_FREQUENCY_ATTR_DISABLED]) {
+                continue;
+            }
+            const uint32_t mhz = nla_get_u32(ftb[NL80211_FREQUENCY_ATTR_FREQ]);
+            if (!band.frequencies.contains(mhz)) {
+                band.frequencies.append(mhz);
+            }
+        }
+    }
+}
+
+int wiphyCallback(struct nl_msg* msg, void* arg) {
+    auto* caps = static_cast<WiphyCapabilities*>(arg);
+    struct genlmsghdr* gnlh = static_cast<genlmsghdr*>(nlmsg_data(nlmsg_hdr(msg)));
+    struct nlattr* tb[NL80211_ATTR_MAX + 1] = {};
+
+    if (nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), nullptr) < 0) {
+        return NL_SKIP;
+    }
+
+    if (tb[NL80211_ATTR_WIPHY]) {
+        const int index = static_cast<int>(nla_get_u32(tb[NL80211_ATTR_WIPHY]));
+        if (caps->wiphyIndex >= 0 && caps->wiphyIndex != index) {
+            return NL_SKIP;  // older kernels ignore the filter
+        }
+        caps->wiphyIndex = index;
+    }
+    if (tb[NL80211_ATTR_WIPHY_NAME]) {
+        caps->name = QString::fromUtf8(nla_get_string(tb[NL80211_ATTR_WIPHY_NAME]));
+    }
+
+    if (tb[NL80211_ATTR_WIPHY_BANDS]) {
+        struct nlattr* bandAttr;
+        int rem;
+        nla_for_each_nested(bandAttr, tb[NL80211_ATTR_WIPHY_BANDS], rem) {
+            const int id = nla_type(bandAttr);
+            if (id >= 0 && id < WiphyBand::count) {
+                parseBand(bandAttr, caps->bands[id]);
+            }
+        }
+    }
+    caps->valid = true;
     return NL_OK;
 }
 
+struct InterfaceData {
+    int wiphy = -1;
+    int iftype = -1;
+    // Indexed by MLO link id; filled when set and the interface has links.
+    uint32_t* linkFrequency = nullptr;
+    bool ok = false;
+};
+
+int interfaceCallback(struct nl_msg* msg, void* arg) {
+    auto* data = static_cast<InterfaceData*>(arg);
+    struct genlmsghdr* gnlh = static_cast<genlmsghdr*>(nlmsg_data(nlmsg_hdr(msg)));
+    struct nlattr* tb[NL80211_ATTR_MAX + 1] = {};
+    if (nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), nullptr) < 0) {
+        return NL_SKIP;
+    }
+    if (tb[NL80211_ATTR_WIPHY]) {
+        data->wiphy = static_cast<int>(nla_get_u32(tb[NL80211_ATTR_WIPHY]));
+    }
+    if (tb[NL80211_ATTR_IFTYPE]) {
+        data->iftype = static_cast<int>(nla_get_u32(tb[NL80211_ATTR_IFTYPE]));
+    }
+    if (data->linkFrequency && tb[NL80211_ATTR_MLO_LINKS]) {
+        struct nlattr* linkAttr;
+        int remaining;
+        nla_for_each_nested(linkAttr, tb[NL80211_ATTR_MLO_LINKS], remaining) {
+            struct nlattr* ltb[NL80211_ATTR_MAX + 1] = {};
+            if (nla_parse_nested(ltb, NL80211_ATTR_MAX, linkAttr, nullptr) < 0
+                || !ltb[NL80211_ATTR_MLO_LINK_ID] || !ltb[NL80211_ATTR_WIPHY_FREQ]) {
+                continue;
+            }
+            data->linkFrequency[nla_get_u8(ltb[NL80211_ATTR_MLO_LINK_ID]) & 15] = nla_get_u32(ltb[NL80211_ATTR_WIPHY_FREQ]);
+        }
+    }
+    data->ok = true;
+    return NL_OK;
+}
+
+// Sends @p msg on @p sock and dispatches replies to @p valid until the
+// kernel acks or finishes the dump. Returns 0 or a negative errno/NLE code.
+int transact(struct nl_sock* sock, struct nl_msg* msg, nl_recvmsg_msg_cb_t valid, void* arg) {
+    struct nl_cb* cb = nl_cb_alloc(NL_CB_DEFAULT);
+    if (!cb) {
+        return -NLE_NOMEM;
+    }
+
+    int kernelError = 0;
+    nl_cb_set(cb, NL_CB_VALID, NL_CB_CUSTOM, valid, arg);
+    nl_cb_set(cb, NL_CB_ACK, NL_CB_CUSTOM, [](struct nl_msg*, void*) -> int {
+        return NL_STOP;
+    }, nullptr);
+    nl_cb_set(cb, NL_CB_FINISH, NL_CB_CUSTOM, [](struct nl_msg*, void*) -> int {
+        return NL_STOP;
+    }, nullptr);
+    nl_cb_err(cb, NL_CB_CUSTOM, [](struct sockaddr_nl*, struct nlmsgerr* err, void* errArg) -> int {
+        *static_cast<int*>(errArg) = err->error;
+        return NL_STOP;
+    }, &kernelError);
+
+    int ret = nl_send_auto(sock, msg);
+    if (ret >= 0) {
+        ret = nl_recvmsgs(sock, cb);
+    }
+    nl_cb_put(cb);
+
+    if (ret < 0) {
+        return ret;
+    }
+    return kernelError;
+}
+
+// GET_INTERFACE for @p ifname into @p data; false if it could not be read.
+bool queryInterface(struct nl_sock* sock, int familyId, const char* ifname, InterfaceData& data) {
+    const unsigned int ifindex = if_nametoindex(ifname);
+    if (ifindex == 0) {
+        return false;
+    }
+    struct nl_msg* msg = nlmsg_alloc();
+    if (!msg) {
+        return false;
+    }
+    if (genlmsg_put(msg, 0, 0, familyId, 0, 0, NL80211_CMD_GET_INTERFACE, 0)
+        && nla_put_u32(msg, NL80211_ATTR_IFINDEX, ifindex) >= 0
+        && transact(sock, msg, interfaceCallback, &data) < 0) {
+        data.ok = false;
+    }
+    nlmsg_free(msg);
+    return data.ok;
+}
+
 }  // namespace
 
 Nl80211Helper::Nl80211Helper() = default;
@@ -218,19 +738,31 @@ Nl80211Helper::~Nl80211Helper() {
 bool Nl80211Helper::init() {
     m_socket = nl_socket_alloc();
     if (!m_socket) {
+        m_lastError = QStringLiteral("Failed to allocate netlink socket");
+        m_lastErrno = ENOMEM;
         return false;
     }
     
-    if (genl_connect(m_socket) < 0) {
+    int ret = genl_connect(m_socket);
+    if (ret < 0) {
+        // Usually a sandbox or container without generic netlink.
+        m_lastError = QStringLiteral("Failed to connect netlink socket: %1").arg(QString::fromUtf8(nl_geterror(ret)));
+        m_lastErrno = errnoFromNle(ret);
         cleanup();
         return false;
     }
     
-    m_nl80211Id = genl_ctrl_resolve(m_socket, "nl80211");
-    if (m_nl80211Id < 0) {
+    ret = genl_ctrl_resolve(m_socket, "nl80211");
+    if (ret < 0) {
+        // cfg80211 not loaded (or being reloaded).
+        m_lastError = QStringLiteral("nl80211 family not found: %1").arg(QString::fromUtf8(nl_geterror(ret)));
+        m_lastErrno = errnoFromNle(ret);
         cleanup();
         return false;
     }
+    m_nl80211Id = ret;
+    m_lastError.clear();
+    m_lastErrno = 0;
     
     // Disable sequence number checking to allow socket reuse across multiple queries.
     // Without this, residual messages in the socket buffer cause NLE_SEQ_MISMATCH errors.
@@ -240,6 +772,7 @@ bool Nl80211Helper::init() {
 }
 
 void Nl80211Helper::cleanup() {
+    releaseStationQuery();
     if (m_socket) {
         nl_socket_free(m_socket);
         m_socket = nullptr;
@@ -251,139 +784,352 @@ bool Nl80211Helper::isValid() const {
     return m_socket != nullptr && m_nl80211Id >= 0;
 }
 
+bool Nl80211Helper::familyMoved() {
+    if (!isValid()) {
+        return true;
+    }
+    return genl_ctrl_resolve(m_socket, "nl80211") != m_nl80211Id;
+}
+
 Nl80211StationInfo Nl80211Helper::getStationInfo(const char* ifname, const uint8_t* bssid) {
     Nl80211StationInfo result;
     m_lastError.clear();
+    m_lastErrno = 0;
     
+    const Profiler::Scope profile(Profiler::Stage::Query);
+    
+    if (!isValid()) {
+        m_lastError = QStringLiteral("nl80211 not initialized");
+        m_lastErrno = ENOTCONN;
+        return result;
+    }
     if (!ifname) {
         m_lastError = QStringLiteral("No interface name provided");
+        m_lastErrno = EINVAL;
         return result;
     }
-    
-    unsigned int ifindex = if_nametoindex(ifname);
-    if (ifindex == 0) {
-        m_lastError = QStringLiteral("Interface not found: %1").arg(QString::fromUtf8(ifname));
+    if (!bssid) {
+        // A dump answers with every peer; writing them all into one result
+        // would leave whichever the kernel listed last.
+        if (!m_anyStation) {
+            m_anyStation = std::make_unique<StationTable>(4);
+        }
+        if (dumpStations(ifname, *m_anyStation)) {
+            if (const Nl80211StationInfo* station = pickStation(*m_anyStation)) {
+                result = *station;
+                if (result.linkCount > 0) {
+                    resolveLinkChannels(result);
+                }
+            } else {
+                m_lastError = QStringLiteral("No station associated");
+                m_lastErrno = ENOENT;
+            }
+        }
         return result;
     }
-    
-    struct nl_sock* sock = nl_socket_alloc();
-    if (!sock) {
-        m_lastError = QStringLiteral("Failed to allocate netlink socket");
+    if (!prepareStationQuery(ifname, bssid)) {
         return result;
     }
+    if (runStationQuery(&result, nullptr) && result.linkCount > 0) {
+        resolveLinkChannels(result);
+    }
     
-    if (genl_connect(sock) < 0) {
-        m_lastError = QStringLiteral("Failed to connect netlink socket");
-        nl_socket_free(sock);
-        return result;
+    return result;
+}
+
+bool Nl80211Helper::prepareStationQuery(const char* ifname, const uint8_t* bssid) {
+    const bool dump = bssid == nullptr;
+    if (m_stationQuery && dump == m_queryDump
+        && std::strncmp(m_queryIfname, ifname, sizeof(m_queryIfname)) == 0
+        && (dump || std::memcmp(m_queryBssid, bssid, sizeof(m_queryBssid)) == 0)) {
+        return true;
     }
     
-    int nl80211Id = genl_ctrl_resolve(sock, "nl80211");
-    if (nl80211Id < 0) {
-        m_lastError = QStringLiteral("Failed to resolve nl80211");
-        nl_socket_free(sock);
-        return result;
+    const unsigned int ifindex = if_nametoindex(ifname);
+    if (ifindex == 0) {
+        m_lastError = QStringLiteral("Interface not found: %1").arg(QString::fromUtf8(ifname));
+        m_lastErrno = ENODEV;
+        return false;
     }
     
     struct nl_msg* msg = nlmsg_alloc();
     if (!msg) {
         m_lastError = QStringLiteral("Failed to allocate netlink message");
-        nl_socket_free(sock);
-        return result;
+        m_lastErrno = ENOMEM;
+        return false;
     }
-    
-    int flags = bssid ? 0 : NLM_F_DUMP;
-    
-    if (!genlmsg_put(msg, 0, 0, nl80211Id, 0, flags, NL80211_CMD_GET_STATION, 0)) {
+    if (!genlmsg_put(msg, NL_AUTO_PORT, NL_AUTO_SEQ, m_nl80211Id, 0,
+                     NLM_F_REQUEST | (dump ? NLM_F_DUMP : 0), NL80211_CMD_GET_STATION, 0)
+        || nla_put_u32(msg, NL80211_ATTR_IFINDEX, ifindex) < 0
+        || (!dump && nla_put(msg, NL80211_ATTR_MAC, 6, bssid) < 0)) {
         m_lastError = QStringLiteral("Failed to create netlink message");
+        m_lastErrno = EMSGSIZE;
         nlmsg_free(msg);
-        nl_socket_free(sock);
-        return result;
-    }
-    
-    if (nla_put_u32(msg, NL80211_ATTR_IFINDEX, ifindex) < 0) {
-        m_lastError = QStringLiteral("Failed to set interface index");
-        nlmsg_free(msg);
-        nl_socket_free(sock);
-        return result;
+        return false;
     }
+    nlmsg_hdr(msg)->nlmsg_pid = nl_socket_get_local_port(m_socket);
     
-    if (bssid) {
-        if (nla_put(msg, NL80211_ATTR_MAC, 6, bssid) < 0) {
-            m_lastError = QStringLiteral("Failed to set BSSID");
-            nlmsg_free(msg);
-            nl_socket_free(sock);
-            return result;
-        }
+    releaseStationQuery();
+    m_stationQuery = msg;
+    std::strncpy(m_queryIfname, ifname, sizeof(m_queryIfname) - 1);
+    m_queryIfname[sizeof(m_queryIfname) - 1] = '\0';
+    if (!dump) {
+        std::memcpy(m_queryBssid, bssid, sizeof(m_queryBssid));
     }
-    
-    CallbackData cbData;
-    cbData.info = &result;
-    cbData.errorCode = 0;
-    
-    struct nl_cb* cb = nl_cb_alloc(NL_CB_DEFAULT);
-    if (!cb) {
-        m_lastError = QStringLiteral("Failed to allocate callback");
-        nlmsg_free(msg);
-        nl_socket_free(sock);
-        return result;
+    m_queryDump = dump;
+    return true;
+}
+
+void Nl80211Helper::releaseStationQuery() {
+    if (m_stationQuery) {
+        nlmsg_free(m_stationQuery);
+        m_stationQuery = nullptr;
     }
+    m_queryIfname[0] = '\0';
+    m_linkMask = 0;
+}
+
+bool Nl80211Helper::runStationQuery(Nl80211StationInfo* info, StationTable* table) {
+    // Sent without NLM_F_ACK: a single-station reply is then one datagram.
+    struct nlmsghdr* request = nlmsg_hdr(m_stationQuery);
+    request->nlmsg_seq = nl_socket_use_seq(m_socket);
     
-    nl_cb_set(cb, NL_CB_VALID, NL_CB_CUSTOM, stationInfoCallback, &cbData);
-    nl_cb_set(cb, NL_CB_ACK, NL_CB_CUSTOM, [](struct nl_msg*, void*) -> int { 
-        return NL_STOP; 
-    }, nullptr);
-    nl_cb_set(cb, NL_CB_FINISH, NL_CB_CUSTOM, [](struct nl_msg*, void*) -> int { 
-        return NL_STOP; 
-    }, nullptr);
-    nl_cb_err(cb, NL_CB_CUSTOM, [](struct sockaddr_nl*, struct nlmsgerr* err, void* arg) -> int {
-        auto* data = static_cast<CallbackData*>(arg);
-        if (data && err) {
-            data->errorCode = err->error;
-        }
-        return NL_STOP;
-    }, &cbData);
-    
-    int ret = nl_send_auto(sock, msg);
+    uint64_t stageStart = Profiler::nowNs();
+    int ret = nl_send(m_socket, m_stationQuery);
+    Profiler::record(Profiler::Stage::Send, Profiler::nowNs() - stageStart);
     if (ret < 0) {
+        Profiler::increment(Profiler::Counter::SendErrors);
         m_lastError = QStringLiteral("Failed to send netlink message: %1").arg(QString::fromUtf8(nl_geterror(ret)));
-        nl_cb_put(cb);
-        nlmsg_free(msg);
-        nl_socket_free(sock);
-        return result;
+        m_lastErrno = errnoFromNle(ret);
+        return false;
     }
     
-    ret = nl_recvmsgs(sock, cb);
+    CallbackData cbData;
+    cbData.info = info;
+    cbData.table = table;
+    
+    stageStart = Profiler::nowNs();
+    ret = receiveStationReplies(m_socket, request->nlmsg_seq, m_queryDump, m_receiveBuffer, receiveBufferSize, &cbData);
+    Profiler::record(Profiler::Stage::Receive, Profiler::nowNs() - stageStart);
     
+    if (cbData.partialParse) {
+        Profiler::increment(Profiler::Counter::ParseErrors);
+    }
     if (ret < 0) {
-        if (ret == -NLE_PERM || cbData.errorCode == -EPERM) {
+        Profiler::increment(Profiler::Counter::ReceiveErrors);
+        m_lastErrno = cbData.systemError ? cbData.systemError : errnoFromNle(ret);
+        if (ret == -NLE_PERM) {
             m_lastError = QStringLiteral("Permission denied - may need CAP_NET_ADMIN");
         } else {
             m_lastError = QStringLiteral("Failed to receive netlink response: %1").arg(QString::fromUtf8(nl_geterror(ret)));
         }
-    } else if (cbData.errorCode < 0) {
+        return false;
+    }
+    if (cbData.errorCode < 0) {
+        Profiler::increment(Profiler::Counter::KernelErrors);
+        m_lastErrno = -cbData.errorCode;
         if (cbData.errorCode == -EPERM) {
             m_lastError = QStringLiteral("Permission denied - may need CAP_NET_ADMIN");
         } else {
             m_lastError = QStringLiteral("Kernel error: %1").arg(cbData.errorCode);
         }
+        if (cbData.errorCode == -ENODEV) {
+            // Look the index up again next time; the interface may have been re-created.
+            releaseStationQuery();
+        }
+        return false;
     }
-
-    if (result.valid && cbData.partialParse && m_lastError.isEmpty()) {
+    
+    if (info && info->valid && cbData.partialParse) {
         m_lastError = QStringLiteral("Incomplete station info (failed to parse rate fields)");
     }
-    
-    nl_cb_put(cb);
+    return true;
+}
+
+void Nl80211Helper::resolveLinkChannels(Nl80211StationInfo& info) {
+    uint16_t mask = 0;
+    for (int i = 0; i < info.linkCount; ++i) {
+        mask |= static_cast<uint16_t>(1u << (info.links[i].linkId & 15));
+    }
+    if (mask != m_linkMask) {
+        // Links were added or removed: read their channels once.
+        std::fill(std::begin(m_linkFrequency), std::end(m_linkFrequency), 0u);
+        InterfaceData data;
+        data.linkFrequency = m_linkFrequency;
+        if (queryInterface(m_socket, m_nl80211Id, m_queryIfname, data)) {
+            m_linkMask = mask;
+        }
+    }
+    for (int i = 0; i < info.linkCount; ++i) {
+        info.links[i].frequencyMhz = m_linkFrequency[info.links[i].linkId & 15];
+    }
+}
+
+int Nl80211Helper::getWiphyIndex(const char* ifname, int* interfaceType) {
+    if (interfaceType) {
+        *interfaceType = -1;
+    }
+    if (!isValid() || !ifname) {
+        return -1;
+    }
+
+    InterfaceData data;
+    if (!queryInterface(m_socket, m_nl80211Id, ifname, data)) {
+        data = InterfaceData{};
+    }
+    if (interfaceType) {
+        *interfaceType = data.iftype;
+    }
+    return data.wiphy;
+}
+
+bool Nl80211Helper::dumpStations(const char* ifname, StationTable& table) {
+    m_lastError.clear();
+    m_lastErrno = 0;
+
+    const Profiler::Scope profile(Profiler::Stage::Query);
+
+    if (!isValid() || !ifname) {
+        m_lastError = QStringLiteral("nl80211 not initialized");
+        m_lastErrno = ENOTCONN;
+        return false;
+    }
+    // Same cached request and receive buffer as a single-station query, so
+    // a periodic dump allocates nothing either.
+    if (!prepareStationQuery(ifname, nullptr)) {
+        return false;
+    }
+
+    table.beginUpdate();
+    if (!runStationQuery(nullptr, &table)) {
+        // Skip eviction; stations refreshed before the failure simply carry newer values.
+        return false;
+    }
+
+    table.endUpdate();
+    return true;
+}
+
+const Nl80211StationInfo* Nl80211Helper::pickStation(const StationTable& table) {
+    const StationTable::Entry* best = nullptr;
+    for (int i = 0; i < table.size(); ++i) {
+        const StationTable::Entry& entry = table.at(i);
+        if (!entry.info.valid) {
+            continue;
+        }
+        if (!best || entry.info.connectedTime > best->info.connectedTime
+            || (entry.info.connectedTime == best->info.connectedTime && entry.key < best->key)) {
+            best = &entry;
+        }
+    }
+    return best ? &best->info : nullptr;
+}
+
+bool Nl80211Helper::isMultiStationInterface(int interfaceType) {
+    switch (interfaceType) {
+        case NL80211_IFTYPE_AP:
+        case NL80211_IFTYPE_AP_VLAN:
+        case NL80211_IFTYPE_MESH_POINT:
+        case NL80211_IFTYPE_P2P_GO:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool Nl80211Helper::getWiphyCapabilities(int wiphyIndex, WiphyCapabilities& caps) {
+    caps = WiphyCapabilities{};
+    if (!isValid() || wiphyIndex < 0) {
+        return false;
+    }
+
+    struct nl_msg* msg = nlmsg_alloc();
+    if (!msg) {
+        return false;
+    }
+
+    // Without the split flag the kernel truncates the band/frequency lists of
+    // modern multi-band radios to fit a single message.
+    caps.wiphyIndex = wiphyIndex;
+    int ret = -NLE_NOMEM;
+    if (genlmsg_put(msg, 0, 0, m_nl80211Id, 0, NLM_F_DUMP, NL80211_CMD_GET_WIPHY, 0)
+        && nla_put_flag(msg, NL80211_ATTR_SPLIT_WIPHY_DUMP) >= 0
+        && nla_put_u32(msg, NL80211_ATTR_WIPHY, static_cast<uint32_t>(wiphyIndex)) >= 0) {
+        ret = transact(m_socket, msg, wiphyCallback, &caps);
+    }
     nlmsg_free(msg);
-    nl_socket_free(sock);
-    
-    return result;
+
+    if (ret < 0) {
+        caps = WiphyCapabilities{};
+        return false;
+    }
+    for (WiphyBand& band : caps.bands) {
+        std::sort(band.frequencies.begin(), band.frequencies.end());
+    }
+    return caps.valid;
 }
 
 QString Nl80211Helper::lastError() const {
     return m_lastError;
 }
 
+int Nl80211Helper::lastErrno() const {
+    return m_lastErrno;
+}
+
+QByteArray Nl80211Helper::parseMacAddress(const QString& text) {
+    if (text.isEmpty()) {
+        return {};
+    }
+    
+    const QStringList parts = text.split(QLatin1Char(':'));
+    if (parts.size() != 6) {
+        return {};
+    }
+    
+    QByteArray out;
+    out.reserve(6);
+    
+    for (const QString& part : parts) {
+        bool ok = false;
+        const int value = part.toInt(&ok, 16);
+        if (!ok || value < 0 || value > 255) {
+            return {};
+        }
+        
+        const uint8_t byte = static_cast<uint8_t>(value);
+        out.append(static_cast<char>(byte));
+    }
+    
+    return out;
+}
+
+int Nl80211Helper::frequencyToChannel(uint32_t frequencyMhz) {
+    // Same mapping as ieee80211_freq_khz_to_channel() in the kernel.
+    if (frequencyMhz == 2484) {
+        return 14;
+    }
+    if (frequencyMhz >= 2407 && frequencyMhz < 2484) {
+        return static_cast<int>(frequencyMhz - 2407) / 5;
+    }
+    if (frequencyMhz >= 4910 && frequencyMhz <= 4980) {
+        return static_cast<int>(frequencyMhz - 4000) / 5;
+    }
+    if (frequencyMhz >= 5000 && frequencyMhz < 5925) {
+        return static_cast<int>(frequencyMhz - 5000) / 5;
+    }
+    if (frequencyMhz == 5935) {
+        return 2;
+    }
+    if (frequencyMhz >= 5950 && frequencyMhz <= 45000) {
+        return static_cast<int>(frequencyMhz - 5950) / 5;
+    }
+    if (frequencyMhz >= 58320 && frequencyMhz <= 70200) {
+        return static_cast<int>(frequencyMhz - 56160) / 2160;
+    }
+    return 0;
+}
+
 int Nl80211Helper::channelWidthToMhz(uint8_t width) {
     switch (width) {
         case 0: return 20;
@@ -415,3 +1161,12 @@ const char* Nl80211Helper::wifiModeToGeneration(Nl80211StationInfo::WifiMode mod
         default: return "Legacy";
     }
 }
+
+const char* Nl80211Helper::guardIntervalToString(Nl80211StationInfo::GuardInterval gi) {
+    switch (gi) {
+        case Nl80211StationInfo::GuardInterval::Gi0_4: return "0.4";
+        case Nl80211StationInfo::GuardInterval::Gi1_6: return "1.6";
+        case Nl80211StationInfo::GuardInterval::Gi3_2: return "3.2";
+        default: return "0.8";
+    }
+}
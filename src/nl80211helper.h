@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
+#include <QByteArray>
 #include <QString>
 
 struct Nl80211StationInfo {
@@ -10,6 +12,12 @@ struct Nl80211StationInfo {
     int32_t signalDbm = 0;
     int32_t signalAvgDbm = 0;
     
+    // Per-antenna chain signal (IEEE80211_MAX_CHAINS in the kernel)
+    static constexpr int maxChains = 4;
+    uint8_t chainCount = 0;
+    int32_t chainSignal[maxChains] = {};
+    int32_t chainSignalAvg[maxChains] = {};
+    
     // Bitrate (in 100 kbit/s)
     uint32_t txBitrate = 0;
     uint32_t rxBitrate = 0;
@@ -37,6 +45,21 @@ struct Nl80211StationInfo {
     WifiMode txMode = WifiMode::Unknown;
     WifiMode rxMode = WifiMode::Unknown;
     
+    // Guard interval: HT/VHT use 0.8/0.4 us, HE/EHT use 0.8/1.6/3.2 us
+    enum class GuardInterval : uint8_t {
+        Gi0_8 = 0,
+        Gi0_4,
+        Gi1_6,
+        Gi3_2
+    };
+    
+    GuardInterval txGuardInterval = GuardInterval::Gi0_8;
+    GuardInterval rxGuardInterval = GuardInterval::Gi0_8;
+    
+    // HE dual carrier modulation (halves the rate for robustness)
+    bool txDcm = false;
+    bool rxDcm = false;
+    
     // Traffic statistics
     uint64_t rxBytes = 0;
     uint64_t txBytes = 0;
@@ -65,8 +88,43 @@ struct Nl80211StationInfo {
     // Airtime
     uint64_t rxDuration = 0;  // microseconds
     uint64_t txDuration = 0;
+    
+    // Wi-Fi 7 multi-link operation: the affiliated links of an MLO
+    // association (NL80211_ATTR_MLO_LINKS). With links present the bitrates
+    // above are their sum, and MCS, NSS, width and mode describe the fastest
+    // link in that direction if the kernel gave no MLD-level rate.
+    struct Link {
+        uint8_t linkId = 0;
+        uint8_t address[6] = {};  // the AP's link address
+        uint32_t frequencyMhz = 0;  // 0 while the link's channel is unknown
+        int32_t signalDbm = 0;
+        int32_t signalAvgDbm = 0;
+        uint32_t txBitrate = 0;  // 100 kbit/s
+        uint32_t rxBitrate = 0;
+        uint8_t txMcs = 0;
+        uint8_t rxMcs = 0;
+        uint8_t txNss = 0;
+        uint8_t rxNss = 0;
+        uint8_t txChannelWidth = 0;
+        uint8_t rxChannelWidth = 0;
+        WifiMode txMode = WifiMode::Unknown;
+        WifiMode rxMode = WifiMode::Unknown;
+        uint64_t rxBytes = 0;
+        uint64_t txBytes = 0;
+        uint32_t rxPackets = 0;
+        uint32_t txPackets = 0;
+        uint32_t txRetries = 0;
+        uint32_t txFailed = 0;
+    };
+    // 802.11be allows 15 links; clients use up to one per band.
+    static constexpr int maxLinks = 4;
+    uint8_t linkCount = 0;
+    Link links[maxLinks] = {};
 };
 
+struct WiphyCapabilities;
+class StationTable;
+
 class Nl80211Helper {
 public:
     Nl80211Helper();
@@ -79,15 +137,73 @@ public:
     void cleanup();
     
     [[nodiscard]] bool isValid() const;
+    // Station @p bssid of @p ifname. Without a BSSID every station is dumped
+    // and the one associated longest is returned, see pickStation().
     [[nodiscard]] Nl80211StationInfo getStationInfo(const char* ifname, const uint8_t* bssid = nullptr);
     [[nodiscard]] QString lastError() const;
-    
+    // errno-style cause of the last failure (EPERM, ENODEV, ENOBUFS, ENOENT, ...), 0 after success.
+    [[nodiscard]] int lastErrno() const;
+    // Re-resolves the nl80211 family; true if it is gone or has a new id, as
+    // after cfg80211 was reloaded. Costs a round trip, so only ask on errors.
+    [[nodiscard]] bool familyMoved();
+    
+    // Dumps every station of @p ifname (AP, mesh, P2P-GO) into @p table.
+    // Nothing is evicted when the dump fails.
+    bool dumpStations(const char* ifname, StationTable& table);
+    // The station a BSSID-less query stands for: the longest associated,
+    // which on a client is the AP rather than a later TDLS peer. Ties go to
+    // the lowest address so the choice does not follow dump order.
+    [[nodiscard]] static const Nl80211StationInfo* pickStation(const StationTable& table);
+    
+    // wiphy index of @p ifname, -1 on error. Optionally reports its nl80211_iftype.
+    [[nodiscard]] int getWiphyIndex(const char* ifname, int* interfaceType = nullptr);
+    // One-shot GET_WIPHY split dump. Expensive; cache the result.
+    bool getWiphyCapabilities(int wiphyIndex, WiphyCapabilities& caps);
+    
+    // "aa:bb:cc:dd:ee:ff" -> 6 raw bytes, empty on malformed input.
+    static QByteArray parseMacAddress(const QString& text);
+    
+    // AP, AP_VLAN, mesh point and P2P-GO interfaces serve many stations.
+    static bool isMultiStationInterface(int interfaceType);
+    static int frequencyToChannel(uint32_t frequencyMhz);
     static int channelWidthToMhz(uint8_t width);
     static const char* wifiModeToString(Nl80211StationInfo::WifiMode mode);
     static const char* wifiModeToGeneration(Nl80211StationInfo::WifiMode mode);
+    static const char* guardIntervalToString(Nl80211StationInfo::GuardInterval gi);
 
 private:
+    bool prepareStationQuery(const char* ifname, const uint8_t* bssid);
+    void releaseStationQuery();
+    // Sends the prepared query; replies land in @p info, or per station in
+    // @p table for a dump. False with lastError() set on failure.
+    bool runStationQuery(Nl80211StationInfo* info, StationTable* table);
+    void resolveLinkChannels(Nl80211StationInfo& info);
+
     struct nl_sock* m_socket = nullptr;
     int m_nl80211Id = -1;
     QString m_lastError;
+    int m_lastErrno = 0;
+
+    // GET_STATION request for the current interface and BSSID, or a dump of
+    // all its stations. Built once and re-sent every sample; rebuilt only
+    // when the target changes or the kernel reports the interface gone.
+    struct nl_msg* m_stationQuery = nullptr;
+    char m_queryIfname[16] = {}; // IFNAMSIZ
+    uint8_t m_queryBssid[6] = {};
+    bool m_queryDump = false;
+
+    // Operating frequency per MLO link id from GET_INTERFACE, re-read only
+    // when the set of links in a station reply changes.
+    uint32_t m_linkFrequency[16] = {};
+    uint16_t m_linkMask = 0;
+
+    // Stations of a BSSID-less query; created by the first one.
+    std::unique_ptr<StationTable> m_anyStation;
+
+    // Station replies are read straight into this buffer; nl_recvmsgs() would
+    // allocate a receive buffer and a message object per datagram. Sized for
+    // the largest datagram the kernel builds for a dump (32 KiB), so a reply
+    // carrying several MLO links or stations is never truncated.
+    static constexpr size_t receiveBufferSize = 32768;
+    alignas(4) unsigned char m_receiveBuffer[receiveBufferSize];
 };
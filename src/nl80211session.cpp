@@ -0,0 +1,245 @@
+#include "nl80211session.h"
+#include "eventtimeline.h"
+#include "nl80211events.h"
+#include "nl80211helper.h"
+
+#include <QRandomGenerator>
+
+#include <algorithm>
+#include <cerrno>
+
+Nl80211Session::Nl80211Session(Nl80211Helper &helper, QObject *parent)
+    : QObject(parent)
+    , m_helper(helper)
+    , m_events(new Nl80211Events(this))
+{
+    m_retryTimer.setSingleShot(true);
+    connect(&m_retryTimer, &QTimer::timeout, this, &Nl80211Session::attempt);
+    connect(m_events, &Nl80211Events::familyChanged, this, &Nl80211Session::onFamilyChanged);
+    connect(m_events, &Nl80211Events::interfaceChanged, this, &Nl80211Session::onInterfaceChanged);
+    connect(m_events, &Nl80211Events::overrun, this, &Nl80211Session::onOverrun);
+}
+
+Nl80211Session::~Nl80211Session() = default;
+
+void Nl80211Session::start()
+{
+    if (m_state != State::Stopped) {
+        return;
+    }
+    m_attempts = 0;
+    attempt();
+}
+
+void Nl80211Session::stop()
+{
+    m_retryTimer.stop();
+    m_events->stop();
+    m_attempts = 0;
+    setState(State::Stopped, Failure::None);
+}
+
+bool Nl80211Session::isReady() const
+{
+    return m_state == State::Ready;
+}
+
+Nl80211Session::State Nl80211Session::state() const
+{
+    return m_state;
+}
+
+Nl80211Session::Failure Nl80211Session::failure() const
+{
+    return m_failure;
+}
+
+int Nl80211Session::attempts() const
+{
+    return m_attempts;
+}
+
+int Nl80211Session::retryInMs() const
+{
+    return m_retryTimer.isActive() ? m_retryTimer.remainingTime() : -1;
+}
+
+uint64_t Nl80211Session::overruns() const
+{
+    return m_overruns;
+}
+
+uint64_t Nl80211Session::recoveries() const
+{
+    return m_recoveries;
+}
+
+Nl80211Events *Nl80211Session::events() const
+{
+    return m_events;
+}
+
+void Nl80211Session::reportResult(bool ok)
+{
+    if (m_state != State::Ready) {
+        return;
+    }
+    if (ok) {
+        m_attempts = 0;
+        m_failure = Failure::None;
+        return;
+    }
+
+    const int error = m_helper.lastErrno();
+    const Failure failure = classify(error);
+    if (failure == Failure::Overrun) {
+        // A reply was dropped; the next query simply tries again.
+        ++m_overruns;
+        return;
+    }
+    if (failure == Failure::Other) {
+        // These are also what a stale family id produces. Only a fresh
+        // lookup tells a removed family from an ordinary query error.
+        if ((error == ENOENT || error == EOPNOTSUPP || error == EINVAL) && m_helper.familyMoved()) {
+            fail(Failure::NoFamily);
+        }
+        return;
+    }
+    fail(failure);
+}
+
+int Nl80211Session::backoffMs(int attempt, double random)
+{
+    // 1 s, 2 s, 4 s ... capped; the shift is bounded well before overflow.
+    const int64_t base = std::min<int64_t>(int64_t(initialBackoffMs) << std::clamp(attempt, 0, 20), maxBackoffMs);
+    const double spread = 1.0 + jitter * (2.0 * std::clamp(random, 0.0, 1.0) - 1.0);
+    return static_cast<int>(std::min<double>(base * spread, maxBackoffMs));
+}
+
+Nl80211Session::Failure Nl80211Session::classify(int error)
+{
+    switch (error) {
+    case 0:
+        return Failure::None;
+    case EPERM:
+    case EACCES:
+        return Failure::Permission;
+    case ENODEV:
+        return Failure::NoDevice;
+    case ENOBUFS:
+        return Failure::Overrun;
+    case EBADF:
+    case ENOTCONN:
+    case ENOTSOCK:
+    case EPIPE:
+    case ECONNREFUSED:
+    case EAFNOSUPPORT:
+    case EPROTONOSUPPORT:
+        return Failure::Socket;
+    default:
+        return Failure::Other;
+    }
+}
+
+const char *Nl80211Session::stateName(State state)
+{
+    switch (state) {
+    case State::Stopped: return "stopped";
+    case State::Ready:   return "ready";
+    case State::Backoff: return "backoff";
+    }
+    return "unknown";
+}
+
+const char *Nl80211Session::failureName(Failure failure)
+{
+    switch (failure) {
+    case Failure::None:       return "none";
+    case Failure::Permission: return "permission";
+    case Failure::NoFamily:   return "no-family";
+    case Failure::NoDevice:   return "no-device";
+    case Failure::Overrun:    return "overrun";
+    case Failure::Socket:     return "socket";
+    case Failure::Other:      return "other";
+    }
+    return "unknown";
+}
+
+void Nl80211Session::attempt()
+{
+    m_retryTimer.stop();
+    const bool recovering = m_state == State::Backoff;
+
+    if (!m_helper.isValid() && !m_helper.init()) {
+        const int error = m_helper.lastErrno();
+        fail(error == ENOENT ? Failure::NoFamily : classify(error));
+        return;
+    }
+    // Without the listener the session still works, it just cannot hear
+    // nl80211 coming back early; the retry timer covers that.
+    m_events->start();
+
+    setState(State::Ready, Failure::None);
+    if (recovering) {
+        ++m_recoveries;
+        Q_EMIT resyncRequired();
+    }
+}
+
+void Nl80211Session::fail(Failure failure)
+{
+    if (failure == Failure::NoFamily || failure == Failure::Socket) {
+        // Both leave the helper's socket or family id useless; start over.
+        m_helper.cleanup();
+    }
+    const int delay = backoffMs(m_attempts, QRandomGenerator::global()->generateDouble());
+    m_attempts = std::min(m_attempts + 1, 1000);
+    m_retryTimer.start(delay);
+    setState(State::Backoff, failure);
+}
+
+void Nl80211Session::setState(State state, Failure failure)
+{
+    if (state == m_state && failure == m_failure && state != State::Backoff) {
+        return;
+    }
+    m_state = state;
+    m_failure = failure;
+    EventTimeline::record(EventTimeline::Kind::Session, static_cast<int32_t>(state),
+                          state == State::Backoff ? m_retryTimer.remainingTime() : 0, failureName(failure));
+    Q_EMIT stateChanged();
+}
+
+void Nl80211Session::onFamilyChanged(bool available)
+{
+    if (m_state == State::Stopped) {
+        return;
+    }
+    if (!available) {
+        if (m_state == State::Ready) {
+            fail(Failure::NoFamily);
+        }
+        return;
+    }
+    if (m_state == State::Backoff) {
+        attempt();
+    } else {
+        // Re-registered between two samples: ids may have changed.
+        m_helper.cleanup();
+        attempt();
+        Q_EMIT resyncRequired();
+    }
+}
+
+void Nl80211Session::onInterfaceChanged()
+{
+    if (m_state == State::Backoff && m_failure == Failure::NoDevice) {
+        attempt();
+    }
+}
+
+void Nl80211Session::onOverrun()
+{
+    ++m_overruns;
+    Q_EMIT resyncRequired();
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+
+#include <cstdint>
+
+class Nl80211Events;
+class Nl80211Helper;
+
+/**
+ * @brief Keeps the nl80211 query socket and the event listener alive
+ *
+ * Owns the lifecycle of a caller-provided Nl80211Helper and of an
+ * Nl80211Events listener. Query failures are sorted into classes: a missing
+ * permission, the interface or the whole nl80211 family being gone, or a
+ * broken socket take the session into Backoff, where nothing is queried
+ * until a retry timer fires. Retries back off exponentially with jitter up
+ * to maxBackoffMs, and are brought forward when the kernel announces that
+ * nl80211 or an interface came back. Recovery re-resolves the family,
+ * rejoins the multicast groups and asks listeners to resync.
+ *
+ * Callers check isReady() before querying and pass every outcome to
+ * reportResult().
+ */
+class Nl80211Session : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class State : uint8_t {
+        Stopped = 0,
+        Ready,
+        Backoff,
+    };
+
+    enum class Failure : uint8_t {
+        None = 0,
+        Permission, // EPERM/EACCES, e.g. a sandbox without netlink access
+        NoFamily,   // nl80211 not registered: cfg80211 unloaded or being reloaded
+        NoDevice,   // the interface went away
+        Overrun,    // ENOBUFS: the receive queue overflowed, a reply was lost
+        Socket,     // anything else that breaks the socket itself
+        Other,      // per-query errors such as an unknown station; no backoff
+    };
+
+    static constexpr int initialBackoffMs = 1000;
+    static constexpr int maxBackoffMs = 5 * 60 * 1000;
+    // Each delay is spread by up to this fraction either way, so many
+    // sessions failing together do not retry in lockstep.
+    static constexpr double jitter = 0.2;
+
+    explicit Nl80211Session(Nl80211Helper &helper, QObject *parent = nullptr);
+    ~Nl80211Session() override;
+
+    void start();
+    void stop();
+
+    [[nodiscard]] bool isReady() const;
+    [[nodiscard]] State state() const;
+    // Why the session is (or last was) backing off.
+    [[nodiscard]] Failure failure() const;
+    // Consecutive failed attempts; 0 once a query succeeds.
+    [[nodiscard]] int attempts() const;
+    // Time until the next retry, -1 when none is scheduled.
+    [[nodiscard]] int retryInMs() const;
+    [[nodiscard]] uint64_t overruns() const;
+    [[nodiscard]] uint64_t recoveries() const;
+
+    [[nodiscard]] Nl80211Events *events() const;
+
+    // Call after every query made through the helper.
+    void reportResult(bool ok);
+
+    // Delay before retry @p attempt (0-based); @p random is uniform in [0, 1).
+    static int backoffMs(int attempt, double random);
+    static Failure classify(int error);
+    static const char *stateName(State state);
+    static const char *failureName(Failure failure);
+
+Q_SIGNALS:
+    void stateChanged();
+    // Notifications may have been missed, or nl80211 came back with new
+    // ids: cached wiphy and interface data should be re-read.
+    void resyncRequired();
+
+private:
+    void attempt();
+    void fail(Failure failure);
+    void setState(State state, Failure failure);
+    void onFamilyChanged(bool available);
+    void onInterfaceChanged();
+    void onOverrun();
+
+    Nl80211Helper &m_helper;
+    Nl80211Events *m_events = nullptr;
+    QTimer m_retryTimer;
+
+    State m_state = State::Stopped;
+    Failure m_failure = Failure::None;
+    int m_attempts = 0;
+    uint64_t m_overruns = 0;
+    uint64_t m_recoveries = 0;
+};
@@ -0,0 +1,240 @@
+#pragma once
+
+#include "nl80211helper.h"
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @brief Compile-time 802.11 HT/VHT/HE/EHT PHY rate tables
+ *
+ * Rates are in 100 kbit/s (same unit as Nl80211StationInfo bitrates) and are
+ * derived from the standard OFDM parameters:
+ *
+ *   rate = Nsd * Nbpscs * R * Nss / Tsym
+ *
+ * The whole MCS x NSS x width x guard interval table is generated by the
+ * compiler, so lookups are a single indexed load with no runtime setup.
+ */
+namespace PhyRates {
+
+using WifiMode = Nl80211StationInfo::WifiMode;
+using GuardInterval = Nl80211StationInfo::GuardInterval;
+
+inline constexpr int modeCount = 4;  // HT, VHT, HE, EHT
+inline constexpr int widthCount = 5; // 20, 40, 80, 160, 320 MHz
+inline constexpr int giCount = 4;    // GuardInterval values
+inline constexpr int maxNss = 8;
+inline constexpr int mcsCount = 14;  // EHT goes up to MCS 13
+
+namespace detail {
+
+struct Modulation {
+    uint8_t bitsPerSubcarrier;
+    uint8_t codingNum;
+    uint8_t codingDen;
+};
+
+inline constexpr Modulation modulations[mcsCount] = {
+    {1, 1, 2},  // BPSK 1/2
+    {2, 1, 2},  // QPSK 1/2
+    {2, 3, 4},  // QPSK 3/4
+    {4, 1, 2},  // 16-QAM 1/2
+    {4, 3, 4},  // 16-QAM 3/4
+    {6, 2, 3},  // 64-QAM 2/3
+    {6, 3, 4},  // 64-QAM 3/4
+    {6, 5, 6},  // 64-QAM 5/6
+    {8, 3, 4},  // 256-QAM 3/4
+    {8, 5, 6},  // 256-QAM 5/6
+    {10, 3, 4}, // 1024-QAM 3/4
+    {10, 5, 6}, // 1024-QAM 5/6
+    {12, 3, 4}, // 4096-QAM 3/4
+    {12, 5, 6}, // 4096-QAM 5/6
+};
+
+// Mode index 0..3 = HT, VHT, HE, EHT.
+constexpr int maxMcs(int mode)
+{
+    constexpr int limits[modeCount] = {7, 9, 11, 13};
+    return limits[mode];
+}
+
+constexpr int dataSubcarriers(int mode, int width)
+{
+    constexpr int legacy[widthCount] = {52, 108, 234, 468, 0};
+    constexpr int he[widthCount] = {234, 468, 980, 1960, 3920};
+    switch (mode) {
+    case 0:
+        return width <= 1 ? legacy[width] : 0;
+    case 1:
+        return legacy[width];
+    case 2:
+        return width <= 3 ? he[width] : 0;
+    default:
+        return he[width];
+    }
+}
+
+// OFDM symbol duration including guard interval, 0 if the GI is not defined for the mode.
+constexpr int symbolNs(int mode, int gi)
+{
+    constexpr int legacy[giCount] = {4000, 3600, 0, 0};
+    constexpr int he[giCount] = {13600, 0, 14400, 16000};
+    return mode <= 1 ? legacy[gi] : he[gi];
+}
+
+// 802.11ac leaves out the combinations whose coded bits do not split evenly
+// across the BCC encoders (the "not valid" rows of IEEE 802.11-2020 Tables
+// 21-30 to 21-61). Width is the table column; 80+80 shares the 160 column.
+constexpr bool vhtDefined(int width, int nss, int mcs)
+{
+    switch (width) {
+    case 0:
+        return mcs != 9 || nss == 3 || nss == 6;
+    case 2:
+        return !(mcs == 6 && (nss == 3 || nss == 7)) && !(mcs == 9 && nss == 6);
+    case 3:
+        return !(mcs == 9 && nss == 3);
+    default:
+        return true;
+    }
+}
+
+constexpr uint32_t computeRate(int mode, int width, int gi, int nss, int mcs)
+{
+    const int subcarriers = dataSubcarriers(mode, width);
+    const int symbol = symbolNs(mode, gi);
+    if (subcarriers == 0 || symbol == 0 || mcs > maxMcs(mode) || (mode == 0 && nss > 4)
+        || (mode == 1 && !vhtDefined(width, nss, mcs))) {
+        return 0;
+    }
+    const Modulation &m = modulations[mcs];
+    const uint64_t bitsNum = uint64_t(subcarriers) * m.bitsPerSubcarrier * m.codingNum * nss;
+    return static_cast<uint32_t>(bitsNum * 10000 / (uint64_t(m.codingDen) * symbol));
+}
+
+constexpr int tableIndex(int mode, int width, int gi, int nss, int mcs)
+{
+    return (((mode * widthCount + width) * giCount + gi) * maxNss + (nss - 1)) * mcsCount + mcs;
+}
+
+using Table = std::array<uint32_t, modeCount * widthCount * giCount * maxNss * mcsCount>;
+
+constexpr Table buildTable()
+{
+    Table table{};
+    for (int mode = 0; mode < modeCount; ++mode) {
+        for (int width = 0; width < widthCount; ++width) {
+            for (int gi = 0; gi < giCount; ++gi) {
+                for (int nss = 1; nss <= maxNss; ++nss) {
+                    for (int mcs = 0; mcs < mcsCount; ++mcs) {
+                        table[tableIndex(mode, width, gi, nss, mcs)] = computeRate(mode, width, gi, nss, mcs);
+                    }
+                }
+            }
+        }
+    }
+    return table;
+}
+
+inline constexpr Table table = buildTable();
+
+constexpr int modeIndex(WifiMode mode)
+{
+    switch (mode) {
+    case WifiMode::HT:
+        return 0;
+    case WifiMode::VHT:
+        return 1;
+    case WifiMode::HE:
+        return 2;
+    case WifiMode::EHT:
+        return 3;
+    default:
+        return -1;
+    }
+}
+
+// Nl80211StationInfo width code (0=20 .. 4=80+80, 5=320) to table column.
+constexpr int widthIndex(uint8_t channelWidth)
+{
+    constexpr int map[6] = {0, 1, 2, 3, 3, 4};
+    return channelWidth < 6 ? map[channelWidth] : -1;
+}
+
+} // namespace detail
+
+/**
+ * Theoretical PHY rate in 100 kbit/s, or 0 for combinations the standard does
+ * not define. HT MCS indices above 7 are folded into (MCS % 8, NSS).
+ */
+constexpr uint32_t rate(WifiMode mode, uint8_t channelWidth, GuardInterval gi, uint8_t nss, uint8_t mcs, bool dcm = false)
+{
+    const int m = detail::modeIndex(mode);
+    const int w = detail::widthIndex(channelWidth);
+    if (m < 0 || w < 0 || nss < 1 || nss > maxNss) {
+        return 0;
+    }
+    if (mode == WifiMode::HT) {
+        mcs %= 8;
+    }
+    if (mcs >= mcsCount) {
+        return 0;
+    }
+    const uint32_t value = detail::table[detail::tableIndex(m, w, static_cast<int>(gi), nss, mcs)];
+    return dcm ? value / 2 : value;
+}
+
+// Shortest guard interval the mode supports.
+constexpr GuardInterval bestGuardInterval(WifiMode mode)
+{
+    return mode == WifiMode::HT || mode == WifiMode::VHT ? GuardInterval::Gi0_4 : GuardInterval::Gi0_8;
+}
+
+/**
+ * Highest rate reachable for this mode, width and stream count: the top MCS
+ * the standard defines for them, with the shortest guard interval. This is
+ * what the link could do with a perfect channel, independent of what rate
+ * control currently picked.
+ */
+constexpr uint32_t maxRate(WifiMode mode, uint8_t channelWidth, uint8_t nss)
+{
+    const int m = detail::modeIndex(mode);
+    if (m < 0) {
+        return 0;
+    }
+    for (int mcs = detail::maxMcs(m); mcs >= 0; --mcs) {
+        const uint32_t value = rate(mode, channelWidth, bestGuardInterval(mode), nss, static_cast<uint8_t>(mcs));
+        if (value > 0) {
+            return value;
+        }
+    }
+    return 0;
+}
+
+// Spot checks against the rate tables in IEEE 802.11-2020 / 802.11ax / 802.11be.
+static_assert(rate(WifiMode::HT, 0, GuardInterval::Gi0_8, 1, 7) == 650);
+static_assert(rate(WifiMode::HT, 1, GuardInterval::Gi0_4, 2, 15) == 3000);
+static_assert(rate(WifiMode::VHT, 2, GuardInterval::Gi0_4, 1, 9) == 4333);
+static_assert(rate(WifiMode::VHT, 3, GuardInterval::Gi0_4, 2, 9) == 17333);
+static_assert(rate(WifiMode::HE, 2, GuardInterval::Gi0_8, 2, 11) == 12009);
+static_assert(rate(WifiMode::HE, 0, GuardInterval::Gi3_2, 1, 0) == 73);
+static_assert(rate(WifiMode::EHT, 5, GuardInterval::Gi0_8, 4, 13) == 115294);
+static_assert(rate(WifiMode::HT, 2, GuardInterval::Gi0_8, 1, 7) == 0);
+
+// VHT combinations 802.11ac does not define, and the MCS maxRate() falls back to.
+static_assert(rate(WifiMode::VHT, 0, GuardInterval::Gi0_4, 1, 9) == 0);
+static_assert(rate(WifiMode::VHT, 0, GuardInterval::Gi0_8, 2, 9) == 0);
+static_assert(rate(WifiMode::VHT, 0, GuardInterval::Gi0_4, 3, 9) == 2888);
+static_assert(rate(WifiMode::VHT, 2, GuardInterval::Gi0_8, 3, 6) == 0);
+static_assert(rate(WifiMode::VHT, 2, GuardInterval::Gi0_8, 7, 6) == 0);
+static_assert(rate(WifiMode::VHT, 2, GuardInterval::Gi0_4, 6, 9) == 0);
+static_assert(rate(WifiMode::VHT, 3, GuardInterval::Gi0_4, 3, 9) == 0);
+static_assert(rate(WifiMode::VHT, 4, GuardInterval::Gi0_4, 3, 9) == 0);
+static_assert(maxRate(WifiMode::VHT, 0, 1) == 866);
+static_assert(maxRate(WifiMode::VHT, 0, 3) == 2888);
+static_assert(maxRate(WifiMode::VHT, 2, 6) == 23400);
+static_assert(maxRate(WifiMode::VHT, 3, 3) == 23400);
+static_assert(maxRate(WifiMode::VHT, 2, 2) == 8666);
+
+} // namespace PhyRates
@@ -0,0 +1,168 @@
+#include "powermonitor.h"
+
+#include <QDBusArgument>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QDBusVariant>
+
+namespace {
+
+const QString screenSaverService = QStringLiteral("org.freedesktop.ScreenSaver");
+const QString screenSaverPath = QStringLiteral("/org/freedesktop/ScreenSaver");
+const QString screenSaverInterface = QStringLiteral("org.freedesktop.ScreenSaver");
+
+const QString logindService = QStringLiteral("org.freedesktop.login1");
+const QString logindUserPath = QStringLiteral("/org/freedesktop/login1/user/self");
+const QString logindUserInterface = QStringLiteral("org.freedesktop.login1.User");
+const QString logindSessionInterface = QStringLiteral("org.freedesktop.login1.Session");
+
+const QString upowerService = QStringLiteral("org.freedesktop.UPower");
+const QString upowerPath = QStringLiteral("/org/freedesktop/UPower");
+const QString upowerInterface = QStringLiteral("org.freedesktop.UPower");
+
+const QString propertiesInterface = QStringLiteral("org.freedesktop.DBus.Properties");
+
+QDBusPendingCall getProperty(const QDBusConnection &bus, const QString &service, const QString &path,
+                             const QString &interface, const QString &property)
+{
+    QDBusMessage message = QDBusMessage::createMethodCall(service, path, propertiesInterface, QStringLiteral("Get"));
+    message << interface << property;
+    return bus.asyncCall(message);
+}
+
+} // namespace
+
+PowerMonitor::PowerMonitor(QObject *parent)
+    : QObject(parent)
+{
+    initScreenSaver();
+    initLogind();
+    initUPower();
+}
+
+bool PowerMonitor::screenLocked() const { return m_screenLocked; }
+bool PowerMonitor::idle() const { return m_idle; }
+bool PowerMonitor::onBattery() const { return m_onBattery; }
+
+void PowerMonitor::initScreenSaver() {
+    QDBusConnection bus = QDBusConnection::sessionBus();
+    bus.connect(screenSaverService, screenSaverPath, screenSaverInterface, QStringLiteral("ActiveChanged"),
+                this, SLOT(onScreenSaverActiveChanged(bool)));
+
+    const QDBusMessage message = QDBusMessage::createMethodCall(screenSaverService, screenSaverPath,
+                                                                screenSaverInterface, QStringLiteral("GetActive"));
+    auto *watcher = new QDBusPendingCallWatcher(bus.asyncCall(message), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *call) {
+        const QDBusPendingReply<bool> reply = *call;
+        if (!reply.isError()) {
+            setScreenLocked(reply.value());
+        }
+        call->deleteLater();
+    });
+}
+
+void PowerMonitor::initLogind() {
+    // plasmashell runs as a systemd user service outside the login session, so
+    // look the graphical session up through the user instead of our PID.
+    auto *watcher = new QDBusPendingCallWatcher(
+        getProperty(QDBusConnection::systemBus(), logindService, logindUserPath, logindUserInterface, QStringLiteral("Display")),
+        this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *call) {
+        const QDBusPendingReply<QDBusVariant> reply = *call;
+        call->deleteLater();
+        if (reply.isError()) {
+            return;
+        }
+        // Display is a (so) struct: session id and object path.
+        const QDBusArgument argument = reply.value().variant().value<QDBusArgument>();
+        QString sessionId;
+        QDBusObjectPath sessionPath;
+        argument.beginStructure();
+        argument >> sessionId >> sessionPath;
+        argument.endStructure();
+        if (!sessionPath.path().isEmpty() && sessionPath.path() != QLatin1String("/")) {
+            watchLogindSession(sessionPath);
+        }
+    });
+}
+
+void PowerMonitor::watchLogindSession(const QDBusObjectPath &path) {
+    QDBusConnection bus = QDBusConnection::systemBus();
+    bus.connect(logindService, path.path(), propertiesInterface, QStringLiteral("PropertiesChanged"),
+                this, SLOT(onLogindPropertiesChanged(QString, QVariantMap, QStringList)));
+
+    auto *watcher = new QDBusPendingCallWatcher(
+        getProperty(bus, logindService, path.path(), logindSessionInterface, QStringLiteral("IdleHint")), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *call) {
+        const QDBusPendingReply<QDBusVariant> reply = *call;
+        if (!reply.isError()) {
+            setIdle(reply.value().variant().toBool());
+        }
+        call->deleteLater();
+    });
+}
+
+void PowerMonitor::initUPower() {
+    QDBusConnection bus = QDBusConnection::systemBus();
+    bus.connect(upowerService, upowerPath, propertiesInterface, QStringLiteral("PropertiesChanged"),
+                this, SLOT(onUPowerPropertiesChanged(QString, QVariantMap, QStringList)));
+
+    auto *watcher = new QDBusPendingCallWatcher(
+        getProperty(bus, upowerService, upowerPath, upowerInterface, QStringLiteral("OnBattery")), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *call) {
+        const QDBusPendingReply<QDBusVariant> reply = *call;
+        if (!reply.isError()) {
+            setOnBattery(reply.value().variant().toBool());
+        }
+        call->deleteLater();
+    });
+}
+
+void PowerMonitor::onScreenSaverActiveChanged(bool active) {
+    setScreenLocked(active);
+}
+
+void PowerMonitor::onLogindPropertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList &invalidated) {
+    Q_UNUSED(invalidated)
+    if (interface != logindSessionInterface) {
+        return;
+    }
+    const auto it = changed.constFind(QStringLiteral("IdleHint"));
+    if (it != changed.constEnd()) {
+        setIdle(it->toBool());
+    }
+}
+
+void PowerMonitor::onUPowerPropertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList &invalidated) {
+    Q_UNUSED(invalidated)
+    if (interface != upowerInterface) {
+        return;
+    }
+    const auto it = changed.constFind(QStringLiteral("OnBattery"));
+    if (it != changed.constEnd()) {
+        setOnBattery(it->toBool());
+    }
+}
+
+void PowerMonitor::setScreenLocked(bool locked) {
+    if (m_screenLocked != locked) {
+        m_screenLocked = locked;
+        Q_EMIT stateChanged();
+    }
+}
+
+void PowerMonitor::setIdle(bool idle) {
+    if (m_idle != idle) {
+        m_idle = idle;
+        Q_EMIT stateChanged();
+    }
+}
+
+void PowerMonitor::setOnBattery(bool onBattery) {
+    if (m_onBattery != onBattery) {
+        m_onBattery = onBattery;
+        Q_EMIT stateChanged();
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <QDBusObjectPath>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+
+/**
+ * @brief Tracks session lock, idle and battery state over D-Bus
+ *
+ * Listens to org.freedesktop.ScreenSaver on the session bus, and to the
+ * logind session IdleHint and UPower OnBattery properties on the system bus.
+ * All calls are asynchronous; until a service answers its state is assumed
+ * to be the "busy" default (unlocked, not idle, on AC), so a missing service
+ * never stops sampling.
+ */
+class PowerMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PowerMonitor(QObject *parent = nullptr);
+
+    [[nodiscard]] bool screenLocked() const;
+    [[nodiscard]] bool idle() const;
+    [[nodiscard]] bool onBattery() const;
+
+Q_SIGNALS:
+    // Emitted whenever any of the three states changes.
+    void stateChanged();
+
+private Q_SLOTS:
+    void onScreenSaverActiveChanged(bool active);
+    void onLogindPropertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList &invalidated);
+    void onUPowerPropertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList &invalidated);
+
+private:
+    void initScreenSaver();
+    void initLogind();
+    void initUPower();
+    void watchLogindSession(const QDBusObjectPath &path);
+    void setScreenLocked(bool locked);
+    void setIdle(bool idle);
+    void setOnBattery(bool onBattery);
+
+    bool m_screenLocked = false;
+    bool m_idle = false;
+    bool m_onBattery = false;
+};
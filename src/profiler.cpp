@@ -0,0 +1,194 @@
+#include "profiler.h"
+#include "tracer.h"
+
+#include <atomic>
+#include <ctime>
+
+Q_LOGGING_CATEGORY(TRUELINK_PROFILE, "truelinkmonitor.profile", QtWarningMsg)
+
+namespace Profiler {
+
+namespace {
+
+struct AtomicHistogram {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> totalNs{0};
+    std::atomic<uint64_t> maxNs{0};
+    std::atomic<uint64_t> buckets[bucketCount] = {};
+};
+
+AtomicHistogram s_histograms[stageCount];
+std::atomic<uint64_t> s_counters[counterCount] = {};
+std::atomic<uint64_t> s_lastTickNs{0};
+
+// Trace category of a stage's spans.
+const char *categoryFor(Stage stage)
+{
+    switch (stage) {
+        case Stage::History: return "stats";
+        case Stage::Emit:    return "qml";
+        default:             return "nl80211";
+    }
+}
+
+int bucketFor(uint64_t ns)
+{
+    const int bucket = ns == 0 ? 0 : 64 - __builtin_clzll(ns);
+    return bucket < bucketCount ? bucket : bucketCount - 1;
+}
+
+} // namespace
+
+double Histogram::meanNs() const
+{
+    return count > 0 ? static_cast<double>(totalNs) / count : 0.0;
+}
+
+uint64_t Histogram::percentileNs(double fraction) const
+{
+    if (count == 0) {
+        return 0;
+    }
+    const uint64_t target = static_cast<uint64_t>(fraction * (count - 1)) + 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < bucketCount; ++i) {
+        seen += buckets[i];
+        if (seen >= target) {
+            const uint64_t upper = i == 0 ? 0 : (uint64_t(1) << i) - 1;
+            return upper < maxNs ? upper : maxNs;
+        }
+    }
+    return maxNs;
+}
+
+uint64_t nowNs()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+void record(Stage stage, uint64_t durationNs)
+{
+    AtomicHistogram &h = s_histograms[static_cast<int>(stage)];
+    h.count.fetch_add(1, std::memory_order_relaxed);
+    h.totalNs.fetch_add(durationNs, std::memory_order_relaxed);
+    h.buckets[bucketFor(durationNs)].fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t max = h.maxNs.load(std::memory_order_relaxed);
+    while (durationNs > max && !h.maxNs.compare_exchange_weak(max, durationNs, std::memory_order_relaxed)) {
+    }
+
+    if (Tracer::isEnabled() && stage != Stage::TickJitter) {
+        Tracer::complete(stageName(stage), categoryFor(stage), nowNs() - durationNs, durationNs);
+    }
+}
+
+void increment(Counter counter)
+{
+    s_counters[static_cast<int>(counter)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void recordTick(uint64_t now, uint64_t expectedIntervalNs)
+{
+    const uint64_t last = s_lastTickNs.exchange(now, std::memory_order_relaxed);
+    if (last == 0 || now < last) {
+        return;
+    }
+    const uint64_t interval = now - last;
+    record(Stage::TickJitter, interval > expectedIntervalNs ? interval - expectedIntervalNs : expectedIntervalNs - interval);
+}
+
+void restartTicks()
+{
+    s_lastTickNs.store(0, std::memory_order_relaxed);
+}
+
+Histogram histogram(Stage stage)
+{
+    const AtomicHistogram &h = s_histograms[static_cast<int>(stage)];
+    Histogram result;
+    result.count = h.count.load(std::memory_order_relaxed);
+    result.totalNs = h.totalNs.load(std::memory_order_relaxed);
+    result.maxNs = h.maxNs.load(std::memory_order_relaxed);
+    for (int i = 0; i < bucketCount; ++i) {
+        result.buckets[i] = h.buckets[i].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+uint64_t counter(Counter counter)
+{
+    return s_counters[static_cast<int>(counter)].load(std::memory_order_relaxed);
+}
+
+void reset()
+{
+    for (AtomicHistogram &h : s_histograms) {
+        h.count.store(0, std::memory_order_relaxed);
+        h.totalNs.store(0, std::memory_order_relaxed);
+        h.maxNs.store(0, std::memory_order_relaxed);
+        for (auto &bucket : h.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+    for (auto &c : s_counters) {
+        c.store(0, std::memory_order_relaxed);
+    }
+    s_lastTickNs.store(0, std::memory_order_relaxed);
+}
+
+const char *stageName(Stage stage)
+{
+    switch (stage) {
+        case Stage::Query:      return "query";
+        case Stage::Send:       return "send";
+        case Stage::Receive:    return "receive";
+        case Stage::Parse:      return "parse";
+        case Stage::History:    return "history";
+        case Stage::Emit:       return "emit";
+        case Stage::TickJitter: return "tickJitter";
+    }
+    return "unknown";
+}
+
+const char *counterName(Counter counter)
+{
+    switch (counter) {
+        case Counter::Samples:       return "samples";
+        case Counter::SendErrors:    return "sendErrors";
+        case Counter::ReceiveErrors: return "receiveErrors";
+        case Counter::KernelErrors:  return "kernelErrors";
+        case Counter::ParseErrors:   return "parseErrors";
+    }
+    return "unknown";
+}
+
+void logSummary()
+{
+    if (!TRUELINK_PROFILE().isDebugEnabled()) {
+        return;
+    }
+    for (int i = 0; i < stageCount; ++i) {
+        const Stage stage = static_cast<Stage>(i);
+        const Histogram h = histogram(stage);
+        if (h.count == 0) {
+            continue;
+        }
+        qCDebug(TRUELINK_PROFILE, "%-10s n=%llu mean=%.1fus p50<=%.1fus p99<=%.1fus max=%.1fus",
+                stageName(stage),
+                static_cast<unsigned long long>(h.count),
+                h.meanNs() / 1000.0,
+                h.percentileNs(0.5) / 1000.0,
+                h.percentileNs(0.99) / 1000.0,
+                h.maxNs / 1000.0);
+    }
+    qCDebug(TRUELINK_PROFILE, "samples=%llu sendErrors=%llu receiveErrors=%llu kernelErrors=%llu parseErrors=%llu",
+            static_cast<unsigned long long>(counter(Counter::Samples)),
+            static_cast<unsigned long long>(counter(Counter::SendErrors)),
+            static_cast<unsigned long long>(counter(Counter::ReceiveErrors)),
+            static_cast<unsigned long long>(counter(Counter::KernelErrors)),
+            static_cast<unsigned long long>(counter(Counter::ParseErrors)));
+}
+
+} // namespace Profiler
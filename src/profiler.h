@@ -0,0 +1,101 @@
+#pragma once
+
+#include <QLoggingCategory>
+
+#include <cstdint>
+
+Q_DECLARE_LOGGING_CATEGORY(TRUELINK_PROFILE)
+
+/**
+ * @brief Always-on, low-overhead timing of the sampling pipeline
+ *
+ * Each stage has a histogram with power-of-two nanosecond buckets, so
+ * recording is a clock read plus a few relaxed atomic adds and never
+ * allocates. Error counters sit next to the histograms. Everything is
+ * process-wide so the netlink helper, the stats engine and the UI layer
+ * can report into the same tables without passing a context around.
+ * While Tracer is on, every recorded stage also becomes a trace span.
+ */
+namespace Profiler {
+
+enum class Stage : uint8_t {
+    Query = 0,    // whole getStationInfo() call
+    Send,         // nl_send_auto()
+    Receive,      // nl_recvmsgs(), includes Parse
+    Parse,        // station attribute parsing
+    History,      // StatsEngine::addSample()
+    Emit,         // statsUpdated/snapshotChanged emission, i.e. QML binding updates
+    TickJitter,   // |actual - expected| timer interval
+};
+inline constexpr int stageCount = 7;
+
+enum class Counter : uint8_t {
+    Samples = 0,
+    SendErrors,
+    ReceiveErrors,
+    KernelErrors,
+    ParseErrors,
+};
+inline constexpr int counterCount = 5;
+
+// Bucket i holds durations in [2^(i-1), 2^i) ns; bucket 0 is exactly 0 ns.
+inline constexpr int bucketCount = 40;
+
+struct Histogram {
+    uint64_t count = 0;
+    uint64_t totalNs = 0;
+    uint64_t maxNs = 0;
+    uint64_t buckets[bucketCount] = {};
+
+    [[nodiscard]] double meanNs() const;
+    // Upper bound of the bucket holding the @p fraction quantile (0..1).
+    [[nodiscard]] uint64_t percentileNs(double fraction) const;
+};
+
+// Monotonic clock in nanoseconds.
+[[nodiscard]] uint64_t nowNs();
+
+void record(Stage stage, uint64_t durationNs);
+void increment(Counter counter);
+
+// Feeds one timer tick; jitter is measured against the previous tick.
+void recordTick(uint64_t nowNs, uint64_t expectedIntervalNs);
+// Forgets the previous tick, e.g. after the timer interval changed.
+void restartTicks();
+
+[[nodiscard]] Histogram histogram(Stage stage);
+[[nodiscard]] uint64_t counter(Counter counter);
+void reset();
+
+const char *stageName(Stage stage);
+const char *counterName(Counter counter);
+
+// Writes one line per non-empty stage and the counters to the profile log category.
+void logSummary();
+
+/**
+ * Records the lifetime of the scope into @p stage.
+ */
+class Scope
+{
+public:
+    explicit Scope(Stage stage)
+        : m_stage(stage)
+        , m_start(nowNs())
+    {
+    }
+
+    ~Scope()
+    {
+        record(m_stage, nowNs() - m_start);
+    }
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+private:
+    Stage m_stage;
+    uint64_t m_start;
+};
+
+} // namespace Profiler
@@ -0,0 +1,85 @@
+#include "rateoccupancy.h"
+
+#include <cstring>
+
+namespace {
+
+constexpr int widthsMhz[PhyRates::widthCount] = {20, 40, 80, 160, 320};
+
+} // namespace
+
+void RateOccupancy::add(const Nl80211StationInfo &info, uint32_t durationMs)
+{
+    addRate(static_cast<int>(Direction::Rx), info.rxMode, info.rxChannelWidth, info.rxNss, info.rxMcs, durationMs);
+    addRate(static_cast<int>(Direction::Tx), info.txMode, info.txChannelWidth, info.txNss, info.txMcs, durationMs);
+}
+
+void RateOccupancy::addRate(int direction, Nl80211StationInfo::WifiMode mode, uint8_t channelWidth, uint8_t nss,
+                            uint8_t mcs, uint32_t durationMs)
+{
+    m_total[direction] += durationMs;
+    if (mode == Nl80211StationInfo::WifiMode::HT) {
+        mcs %= 8;
+    }
+    const int r = rowIndex(mode, channelWidth, nss);
+    if (r < 0 || mcs >= mcsCount) {
+        m_unclassified[direction] += durationMs;
+        return;
+    }
+    m_rows[direction][r] += durationMs;
+    m_cells[direction][r * mcsCount + mcs] += durationMs;
+}
+
+void RateOccupancy::reset()
+{
+    std::memset(m_cells, 0, sizeof(m_cells));
+    std::memset(m_rows, 0, sizeof(m_rows));
+    std::memset(m_total, 0, sizeof(m_total));
+    std::memset(m_unclassified, 0, sizeof(m_unclassified));
+}
+
+uint64_t RateOccupancy::totalMs(Direction direction) const
+{
+    return m_total[static_cast<int>(direction)];
+}
+
+uint64_t RateOccupancy::unclassifiedMs(Direction direction) const
+{
+    return m_unclassified[static_cast<int>(direction)];
+}
+
+uint64_t RateOccupancy::rowMs(Direction direction, int row) const
+{
+    return m_rows[static_cast<int>(direction)][row];
+}
+
+const uint32_t *RateOccupancy::row(Direction direction, int row) const
+{
+    return &m_cells[static_cast<int>(direction)][row * mcsCount];
+}
+
+int RateOccupancy::rowIndex(Nl80211StationInfo::WifiMode mode, uint8_t channelWidth, uint8_t nss)
+{
+    const int m = PhyRates::detail::modeIndex(mode);
+    const int w = PhyRates::detail::widthIndex(channelWidth);
+    if (m < 0 || w < 0 || nss < 1 || nss > PhyRates::maxNss) {
+        return -1;
+    }
+    return (m * PhyRates::widthCount + w) * PhyRates::maxNss + (nss - 1);
+}
+
+Nl80211StationInfo::WifiMode RateOccupancy::rowMode(int row)
+{
+    // WifiMode numbers HT..EHT from 1, in PhyRates' mode index order.
+    return static_cast<Nl80211StationInfo::WifiMode>(row / (PhyRates::widthCount * PhyRates::maxNss) + 1);
+}
+
+int RateOccupancy::rowWidthMhz(int row)
+{
+    return widthsMhz[row / PhyRates::maxNss % PhyRates::widthCount];
+}
+
+int RateOccupancy::rowNss(int row)
+{
+    return row % PhyRates::maxNss + 1;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "nl80211helper.h"
+#include "phyrates.h"
+
+#include <cstdint>
+
+/**
+ * @brief Time spent in each (mode, width, NSS, MCS) rate cell, per direction
+ *
+ * The instantaneous MCS flaps with every rate control decision; what matters
+ * is where rate control sits over time. Each sample adds its duration to one
+ * cell of a fixed dense matrix per direction, plus a per-row total, so an
+ * update is two increments per direction and memory stays at about 22 KB.
+ * A row is one (mode, width, NSS) combination, its cells are MCS 0–15. HT
+ * MCS indices are folded into (MCS % 8, NSS) like PhyRates does. Samples
+ * without a recognised HT/VHT/HE/EHT rate (legacy rates, unreported) only
+ * count towards unclassifiedMs().
+ */
+class RateOccupancy
+{
+public:
+    enum class Direction : uint8_t {
+        Rx = 0,
+        Tx,
+    };
+    static constexpr int directionCount = 2;
+
+    static constexpr int mcsCount = 16; // EHT defines MCS 14 and 15 as well
+    static constexpr int rowCount = PhyRates::modeCount * PhyRates::widthCount * PhyRates::maxNss;
+    static constexpr int cellCount = rowCount * mcsCount;
+
+    // Adds @p durationMs to the cells of the sample's RX and TX rates.
+    void add(const Nl80211StationInfo &info, uint32_t durationMs);
+    void reset();
+
+    // All time added for @p direction, including unclassified samples.
+    [[nodiscard]] uint64_t totalMs(Direction direction) const;
+    [[nodiscard]] uint64_t unclassifiedMs(Direction direction) const;
+    [[nodiscard]] uint64_t rowMs(Direction direction, int row) const;
+    // The mcsCount cells of @p row.
+    [[nodiscard]] const uint32_t *row(Direction direction, int row) const;
+
+    static Nl80211StationInfo::WifiMode rowMode(int row);
+    static int rowWidthMhz(int row);
+    static int rowNss(int row);
+
+private:
+    // -1 if the rate can't be placed.
+    static int rowIndex(Nl80211StationInfo::WifiMode mode, uint8_t channelWidth, uint8_t nss);
+    void addRate(int direction, Nl80211StationInfo::WifiMode mode, uint8_t channelWidth, uint8_t nss, uint8_t mcs,
+                 uint32_t durationMs);
+
+    // Per cell uint32 ms wrap after 49 days in one cell, beyond any session.
+    uint32_t m_cells[directionCount][cellCount] = {};
+    uint64_t m_rows[directionCount][rowCount] = {};
+    uint64_t m_total[directionCount] = {};
+    uint64_t m_unclassified[directionCount] = {};
+};
@@ -0,0 +1,210 @@
+#include "samplecodec.h"
+
+#include <QtGlobal>
+
+#include <type_traits>
+
+namespace SampleCodec {
+
+namespace {
+
+template<typename T>
+uint64_t toWire(const T &value)
+{
+    return static_cast<uint64_t>(static_cast<int64_t>(value));
+}
+
+template<typename T>
+T fromWire(uint64_t value)
+{
+    if constexpr (std::is_same_v<T, bool>) {
+        return value != 0;
+    } else {
+        return static_cast<T>(value);
+    }
+}
+
+// Writes the bitmap and deltas of @p current against @p previous, which is
+// updated in place. Returns the bytes written.
+template<int Count>
+size_t encodeDeltas(const uint64_t (&current)[Count], uint64_t (&previous)[Count], uint8_t *out)
+{
+    uint64_t bitmap = 0;
+    for (int i = 0; i < Count; ++i) {
+        if (current[i] != previous[i]) {
+            bitmap |= uint64_t(1) << i;
+        }
+    }
+
+    size_t n = writeVarint(out, bitmap);
+    for (uint64_t bits = bitmap; bits != 0; bits &= bits - 1) {
+        const int i = __builtin_ctzll(bits);
+        n += writeVarint(out + n, zigzagEncode(static_cast<int64_t>(current[i] - previous[i])));
+        previous[i] = current[i];
+    }
+    return n;
+}
+
+// Reads a bitmap and deltas written by encodeDeltas() and applies them to
+// @p values. Returns the bytes consumed or 0 on malformed input.
+template<int Count>
+size_t decodeDeltas(const uint8_t *data, size_t size, uint64_t (&values)[Count])
+{
+    uint64_t bitmap = 0;
+    size_t n = readVarint(data, size, bitmap);
+    if (n == 0 || (Count < 64 && (bitmap >> Count) != 0)) {
+        return 0;
+    }
+
+    for (uint64_t bits = bitmap; bits != 0; bits &= bits - 1) {
+        const int i = __builtin_ctzll(bits);
+        uint64_t raw = 0;
+        const size_t used = readVarint(data + n, size - n, raw);
+        if (used == 0) {
+            return 0;
+        }
+        n += used;
+        values[i] += static_cast<uint64_t>(zigzagDecode(raw));
+    }
+    return n;
+}
+
+} // namespace
+
+Encoder::Encoder(int keyframeInterval)
+    : m_keyframeInterval(keyframeInterval > 0 ? keyframeInterval : 1)
+{
+}
+
+void Encoder::reset()
+{
+    m_sinceKeyframe = -1;
+}
+
+size_t Encoder::encode(uint64_t timestampUs, const Nl80211StationInfo &info, uint8_t *out)
+{
+    uint8_t flags = 0;
+    if (m_sinceKeyframe < 0 || m_sinceKeyframe + 1 >= m_keyframeInterval) {
+        flags |= keyframeFlag;
+        for (uint64_t &value : m_previous) {
+            value = 0;
+        }
+        for (auto &link : m_previousLinks) {
+            for (uint64_t &value : link) {
+                value = 0;
+            }
+        }
+        m_previousTimestamp = 0;
+        m_sinceKeyframe = 0;
+    } else {
+        ++m_sinceKeyframe;
+    }
+
+    uint64_t current[fieldCount];
+    int index = 0;
+    forEachField(info, [&current, &index](const auto &field) {
+        current[index++] = toWire(field);
+    });
+
+    size_t n = 0;
+    out[n++] = flags;
+    n += writeVarint(out + n, zigzagEncode(static_cast<int64_t>(timestampUs - m_previousTimestamp)));
+    n += encodeDeltas(current, m_previous, out + n);
+
+    const int linkCount = qMin<int>(info.linkCount, Nl80211StationInfo::maxLinks);
+    for (int link = 0; link < linkCount; ++link) {
+        uint64_t currentLink[linkFieldCount];
+        index = 0;
+        forEachLinkField(info.links[link], [&currentLink, &index](const auto &field) {
+            currentLink[index++] = toWire(field);
+        });
+        n += encodeDeltas(currentLink, m_previousLinks[link], out + n);
+    }
+
+    m_previousTimestamp = timestampUs;
+    return n;
+}
+
+void Decoder::reset()
+{
+    m_synced = false;
+}
+
+size_t Decoder::decode(const uint8_t *data, size_t size, uint64_t &timestampUs, Nl80211StationInfo &info)
+{
+    if (size < 1) {
+        return 0;
+    }
+
+    const uint8_t flags = data[0];
+    const bool keyframe = flags & keyframeFlag;
+    if (!keyframe && !m_synced) {
+        return 0;
+    }
+
+    uint64_t values[fieldCount];
+    uint64_t links[Nl80211StationInfo::maxLinks][linkFieldCount];
+    uint64_t timestamp = keyframe ? 0 : m_previousTimestamp;
+    for (int i = 0; i < fieldCount; ++i) {
+        values[i] = keyframe ? 0 : m_previous[i];
+    }
+    for (int link = 0; link < Nl80211StationInfo::maxLinks; ++link) {
+        for (int i = 0; i < linkFieldCount; ++i) {
+            links[link][i] = keyframe ? 0 : m_previousLinks[link][i];
+        }
+    }
+
+    size_t n = 1;
+    uint64_t raw = 0;
+    size_t used = readVarint(data + n, size - n, raw);
+    if (used == 0) {
+        return 0;
+    }
+    n += used;
+    timestamp += static_cast<uint64_t>(zigzagDecode(raw));
+
+    used = decodeDeltas(data + n, size - n, values);
+    if (used == 0) {
+        return 0;
+    }
+    n += used;
+
+    Nl80211StationInfo decoded;
+    int index = 0;
+    forEachField(decoded, [&values, &index](auto &field) {
+        field = fromWire<std::remove_reference_t<decltype(field)>>(values[index++]);
+    });
+    if (decoded.linkCount > Nl80211StationInfo::maxLinks) {
+        return 0;
+    }
+
+    for (int link = 0; link < decoded.linkCount; ++link) {
+        used = decodeDeltas(data + n, size - n, links[link]);
+        if (used == 0) {
+            return 0;
+        }
+        n += used;
+        index = 0;
+        forEachLinkField(decoded.links[link], [&links, link, &index](auto &field) {
+            field = fromWire<std::remove_reference_t<decltype(field)>>(links[link][index++]);
+        });
+    }
+
+    // Only commit decoder state once the whole record parsed.
+    for (int i = 0; i < fieldCount; ++i) {
+        m_previous[i] = values[i];
+    }
+    for (int link = 0; link < Nl80211StationInfo::maxLinks; ++link) {
+        for (int i = 0; i < linkFieldCount; ++i) {
+            m_previousLinks[link][i] = links[link][i];
+        }
+    }
+    m_previousTimestamp = timestamp;
+    m_synced = true;
+
+    info = decoded;
+    timestampUs = timestamp;
+    return n;
+}
+
+} // namespace SampleCodec
@@ -0,0 +1,210 @@
+#pragma once
+
+#include "nl80211helper.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Compact wire format for Nl80211StationInfo samples
+ *
+ * Each record is:
+ *   - 1 byte of record flags (keyframe bit)
+ *   - zigzag varint timestamp delta (microseconds)
+ *   - varint bitmap of fields that changed since the previous record
+ *   - one zigzag varint delta per changed field, in field order
+ *   - for each of the linkCount MLO links: a varint bitmap and deltas of
+ *     the link's fields, against the previous record's link in that slot
+ *
+ * Counters grow slowly and most PHY fields are stable between ticks, so a
+ * typical record is 20-40 bytes instead of the ~460 byte struct.
+ * Deltas are taken modulo 2^64, so counter resets round-trip exactly.
+ * A keyframe encodes against an all-zero sample and lets a decoder join a
+ * stream part-way through.
+ */
+namespace SampleCodec {
+
+// Writes @p value as a LEB128 varint, returns the number of bytes written (max 10).
+inline size_t writeVarint(uint8_t *out, uint64_t value)
+{
+    size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = static_cast<uint8_t>(value) | 0x80;
+        value >>= 7;
+    }
+    out[n++] = static_cast<uint8_t>(value);
+    return n;
+}
+
+// Reads a LEB128 varint, returns the number of bytes consumed or 0 on truncated/overlong input.
+inline size_t readVarint(const uint8_t *data, size_t size, uint64_t &value)
+{
+    uint64_t result = 0;
+    for (size_t i = 0; i < size && i < 10; ++i) {
+        result |= static_cast<uint64_t>(data[i] & 0x7f) << (7 * i);
+        if (!(data[i] & 0x80)) {
+            value = result;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+constexpr uint64_t zigzagEncode(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+constexpr int64_t zigzagDecode(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Applies @p fn to every encoded field of @p info, in wire order. Fast-changing
+// fields come first so their bits keep the bitmap varint short.
+template<typename Info, typename Fn>
+constexpr void forEachField(Info &info, Fn &&fn)
+{
+    fn(info.signalDbm);
+    fn(info.signalAvgDbm);
+    fn(info.rxBytes);
+    fn(info.txBytes);
+    fn(info.rxPackets);
+    fn(info.txPackets);
+    fn(info.inactiveTime);
+    fn(info.rxDuration);
+    fn(info.txDuration);
+    fn(info.beaconRx);
+    fn(info.connectedTime);
+    fn(info.rxBitrate);
+    fn(info.txBitrate);
+    fn(info.rxMcs);
+    fn(info.txMcs);
+    fn(info.ackSignal);
+    fn(info.ackSignalAvg);
+    fn(info.beaconSignalAvg);
+    fn(info.txRetries);
+    fn(info.txFailed);
+    fn(info.rxDropMisc);
+    fn(info.beaconLoss);
+    fn(info.fcsErrorCount);
+    fn(info.expectedThroughput);
+    for (auto &chain : info.chainSignal) {
+        fn(chain);
+    }
+    for (auto &chain : info.chainSignalAvg) {
+        fn(chain);
+    }
+    fn(info.rxNss);
+    fn(info.txNss);
+    fn(info.rxChannelWidth);
+    fn(info.txChannelWidth);
+    fn(info.rxMode);
+    fn(info.txMode);
+    fn(info.rxGuardInterval);
+    fn(info.txGuardInterval);
+    fn(info.rxDcm);
+    fn(info.txDcm);
+    fn(info.chainCount);
+    fn(info.linkCount);
+    fn(info.hasAckSignal);
+    fn(info.valid);
+}
+
+// Same for one MLO link. Links get their own bitmap so that the record
+// bitmap stays a single u64.
+template<typename Link, typename Fn>
+constexpr void forEachLinkField(Link &link, Fn &&fn)
+{
+    fn(link.signalDbm);
+    fn(link.signalAvgDbm);
+    fn(link.rxBytes);
+    fn(link.txBytes);
+    fn(link.rxPackets);
+    fn(link.txPackets);
+    fn(link.rxBitrate);
+    fn(link.txBitrate);
+    fn(link.rxMcs);
+    fn(link.txMcs);
+    fn(link.txRetries);
+    fn(link.txFailed);
+    fn(link.rxNss);
+    fn(link.txNss);
+    fn(link.rxChannelWidth);
+    fn(link.txChannelWidth);
+    fn(link.rxMode);
+    fn(link.txMode);
+    fn(link.frequencyMhz);
+    fn(link.linkId);
+    for (auto &octet : link.address) {
+        fn(octet);
+    }
+}
+
+constexpr int countFields()
+{
+    Nl80211StationInfo info;
+    int count = 0;
+    forEachField(info, [&count](auto &) {
+        ++count;
+    });
+    return count;
+}
+
+constexpr int countLinkFields()
+{
+    Nl80211StationInfo::Link link;
+    int count = 0;
+    forEachLinkField(link, [&count](auto &) {
+        ++count;
+    });
+    return count;
+}
+
+inline constexpr int fieldCount = countFields();
+inline constexpr int linkFieldCount = countLinkFields();
+static_assert(fieldCount <= 64, "field bitmap must fit in a u64");
+static_assert(linkFieldCount <= 64, "link bitmap must fit in a u64");
+
+inline constexpr uint8_t keyframeFlag = 0x01;
+
+// Upper bound of a single encoded record.
+inline constexpr size_t maxRecordSize = 1 + 10 + 10 + 10 * fieldCount
+    + Nl80211StationInfo::maxLinks * (10 + 10 * linkFieldCount);
+
+class Encoder
+{
+public:
+    explicit Encoder(int keyframeInterval = 60);
+
+    // Forces the next record to be a keyframe.
+    void reset();
+
+    // Encodes one sample into @p out (at least maxRecordSize bytes), returns the record size.
+    size_t encode(uint64_t timestampUs, const Nl80211StationInfo &info, uint8_t *out);
+
+private:
+    uint64_t m_previous[fieldCount] = {};
+    uint64_t m_previousLinks[Nl80211StationInfo::maxLinks][linkFieldCount] = {};
+    uint64_t m_previousTimestamp = 0;
+    int m_keyframeInterval;
+    int m_sinceKeyframe = -1;
+};
+
+class Decoder
+{
+public:
+    void reset();
+
+    // Decodes one record, returns the bytes consumed or 0 on malformed or
+    // truncated input (or a delta record before the first keyframe).
+    size_t decode(const uint8_t *data, size_t size, uint64_t &timestampUs, Nl80211StationInfo &info);
+
+private:
+    uint64_t m_previous[fieldCount] = {};
+    uint64_t m_previousLinks[Nl80211StationInfo::maxLinks][linkFieldCount] = {};
+    uint64_t m_previousTimestamp = 0;
+    bool m_synced = false;
+};
+
+} // namespace SampleCodec
@@ -0,0 +1,215 @@
+#include "signalfilter.h"
+
+#include <QStringList>
+#include <QtGlobal>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace {
+
+// Band of @p value among ascending @p thresholds: 0 below the first one.
+int bandOf(const double *thresholds, int count, double value)
+{
+    int band = 0;
+    while (band < count && value >= thresholds[band]) {
+        ++band;
+    }
+    return band;
+}
+
+} // namespace
+
+SignalFilter::SignalFilter(const QString &spec)
+{
+    setSpec(spec, nullptr);
+}
+
+bool SignalFilter::setSpec(const QString &spec, QString *error)
+{
+    const auto fail = [error](const QString &message) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    };
+
+    Stage stages[maxStages];
+    int count = 0;
+    const QStringList parts = spec.split(QLatin1Char(','), Qt::SkipEmptyParts);
+    for (const QString &part : parts) {
+        const QStringList fields = part.trimmed().split(QLatin1Char(':'));
+        const QString &name = fields.first();
+        if (count == maxStages) {
+            return fail(QStringLiteral("At most %1 filter stages are supported").arg(maxStages));
+        }
+        Stage &stage = stages[count];
+
+        bool ok = fields.size() >= 2;
+        const double first = ok ? fields.at(1).toDouble(&ok) : 0.0;
+        if (!ok) {
+            return fail(QStringLiteral("Filter stage \"%1\" needs a numeric parameter").arg(part.trimmed()));
+        }
+
+        if (name == QLatin1String("ewma")) {
+            if (fields.size() != 2 || first <= 0.0 || first > 1.0) {
+                return fail(QStringLiteral("ewma takes one alpha in (0, 1]"));
+            }
+            stage.kind = Kind::Ewma;
+            stage.a = first;
+        } else if (name == QLatin1String("median")) {
+            const int n = static_cast<int>(first);
+            if (fields.size() != 2 || n != first || n < 1 || n > maxMedian) {
+                return fail(QStringLiteral("median takes a window of 1 to %1 samples").arg(maxMedian));
+            }
+            stage.kind = Kind::Median;
+            stage.size = n;
+        } else if (name == QLatin1String("kalman")) {
+            const double r = fields.size() == 3 ? fields.at(2).toDouble(&ok) : 0.0;
+            if (fields.size() != 3 || !ok || first <= 0.0 || r <= 0.0) {
+                return fail(QStringLiteral("kalman takes a positive process and measurement noise, e.g. kalman:0.5:4"));
+            }
+            stage.kind = Kind::Kalman;
+            stage.a = first;
+            stage.b = r;
+        } else if (name == QLatin1String("hysteresis")) {
+            if (fields.size() > 3 || first < 0.0) {
+                return fail(QStringLiteral("hysteresis takes a margin and optionally thresholds, e.g. hysteresis:2:-70/-60"));
+            }
+            stage.kind = Kind::Hysteresis;
+            stage.a = first;
+            if (fields.size() == 3) {
+                const QStringList thresholds = fields.at(2).split(QLatin1Char('/'), Qt::SkipEmptyParts);
+                if (thresholds.isEmpty() || thresholds.size() > maxThresholds) {
+                    return fail(QStringLiteral("hysteresis takes 1 to %1 thresholds").arg(maxThresholds));
+                }
+                for (const QString &threshold : thresholds) {
+                    stage.thresholds[stage.thresholdCount++] = threshold.toDouble(&ok);
+                    if (!ok) {
+                        return fail(QStringLiteral("Invalid hysteresis threshold \"%1\"").arg(threshold));
+                    }
+                }
+                std::sort(stage.thresholds, stage.thresholds + stage.thresholdCount);
+            } else {
+                std::copy(std::begin(signalThresholds), std::end(signalThresholds), stage.thresholds);
+                stage.thresholdCount = static_cast<int>(std::size(signalThresholds));
+            }
+        } else {
+            return fail(QStringLiteral("Unknown filter stage \"%1\"").arg(name));
+        }
+        ++count;
+    }
+
+    std::copy(stages, stages + count, m_stages);
+    m_stageCount = count;
+    m_spec = spec;
+    return true;
+}
+
+QString SignalFilter::spec() const
+{
+    return m_spec;
+}
+
+double SignalFilter::apply(double value)
+{
+    for (int i = 0; i < m_stageCount; ++i) {
+        value = applyStage(m_stages[i], value);
+    }
+    return value;
+}
+
+double SignalFilter::applyStage(Stage &stage, double value)
+{
+    switch (stage.kind) {
+    case Kind::Ewma:
+        stage.x = stage.primed ? stage.a * value + (1.0 - stage.a) * stage.x : value;
+        stage.primed = true;
+        return stage.x;
+
+    case Kind::Median: {
+        stage.window[stage.next] = value;
+        stage.next = (stage.next + 1) % stage.size;
+        stage.count = qMin(stage.count + 1, stage.size);
+        double sorted[maxMedian];
+        std::copy(stage.window, stage.window + stage.count, sorted);
+        std::sort(sorted, sorted + stage.count);
+        const int mid = stage.count / 2;
+        return stage.count % 2 ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2.0;
+    }
+
+    case Kind::Kalman: {
+        if (!stage.primed) {
+            stage.x = value;
+            stage.p = stage.b;
+            stage.primed = true;
+            return value;
+        }
+        stage.p += stage.a;
+        const double gain = stage.p / (stage.p + stage.b);
+        stage.x += gain * (value - stage.x);
+        stage.p *= 1.0 - gain;
+        return stage.x;
+    }
+
+    case Kind::Hysteresis: {
+        // Step one band at a time, and only once the value is clear of the
+        // edge by the margin, so noise around a threshold can't flip it.
+        if (!stage.primed) {
+            stage.band = bandOf(stage.thresholds, stage.thresholdCount, value);
+            stage.primed = true;
+        }
+        while (stage.band < stage.thresholdCount && value >= stage.thresholds[stage.band] + stage.a) {
+            ++stage.band;
+        }
+        while (stage.band > 0 && value < stage.thresholds[stage.band - 1] - stage.a) {
+            --stage.band;
+        }
+        // Clamp into the held band so any consumer applying the same
+        // thresholds sees the same level. The edges are the band's outermost
+        // whole units, so rounding the output to an integer keeps it in band.
+        if (stage.band > 0) {
+            value = qMax(value, std::ceil(stage.thresholds[stage.band - 1]));
+        }
+        if (stage.band < stage.thresholdCount) {
+            const double top = std::ceil(stage.thresholds[stage.band]) - 1.0;
+            const double bottom = stage.band > 0 ? std::ceil(stage.thresholds[stage.band - 1]) : top;
+            value = qMin(value, qMax(bottom, top));
+        }
+        return value;
+    }
+    }
+    return value;
+}
+
+void SignalFilter::reset()
+{
+    for (int i = 0; i < m_stageCount; ++i) {
+        Stage &stage = m_stages[i];
+        stage.primed = false;
+        stage.count = 0;
+        stage.next = 0;
+    }
+}
+
+int SignalFilter::stageCount() const
+{
+    return m_stageCount;
+}
+
+SignalFilter::Kind SignalFilter::stageKind(int index) const
+{
+    return m_stages[index].kind;
+}
+
+const char *SignalFilter::kindName(Kind kind)
+{
+    switch (kind) {
+        case Kind::Ewma:       return "ewma";
+        case Kind::Median:     return "median";
+        case Kind::Kalman:     return "kalman";
+        case Kind::Hysteresis: return "hysteresis";
+    }
+    return "unknown";
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <QString>
+
+#include <cstdint>
+
+/**
+ * @brief Composable per-metric smoothing with fixed-size state
+ *
+ * A pipeline of up to maxStages stages, applied in order, described by a
+ * spec string such as "median:3,ewma:0.4,hysteresis:2":
+ *
+ *   ewma:<alpha>                 exponential moving average, 0 < alpha <= 1
+ *   median:<n>                   median of the last n samples, n <= maxMedian
+ *   kalman:<q>:<r>               1-D Kalman filter with process noise q and
+ *                                measurement noise r (variances)
+ *   hysteresis:<margin>[:<t>/..] holds the value inside its current band until
+ *                                it passes a band threshold by more than margin;
+ *                                thresholds default to the signal quality bands
+ *
+ * An empty spec passes values through. All state lives in the object, so
+ * apply() never allocates; parsing a spec does, but only on configuration.
+ */
+class SignalFilter
+{
+public:
+    static constexpr int maxStages = 4;
+    static constexpr int maxMedian = 9;
+    static constexpr int maxThresholds = 6;
+
+    // Edges of the signal levels used for the tray icon and status colour.
+    static constexpr double signalThresholds[] = {-80.0, -70.0, -60.0, -50.0};
+
+    enum class Kind : uint8_t {
+        Ewma = 0,
+        Median,
+        Kalman,
+        Hysteresis,
+    };
+
+    SignalFilter() = default;
+    explicit SignalFilter(const QString &spec);
+
+    /**
+     * Replaces the pipeline with @p spec and resets its state. On a syntax
+     * error returns false, sets @p error and leaves the pipeline unchanged.
+     */
+    bool setSpec(const QString &spec, QString *error);
+    [[nodiscard]] QString spec() const;
+
+    double apply(double value);
+    void reset();
+
+    [[nodiscard]] int stageCount() const;
+    [[nodiscard]] Kind stageKind(int index) const;
+
+    static const char *kindName(Kind kind);
+
+private:
+    struct Stage {
+        Kind kind = Kind::Ewma;
+        bool primed = false;
+        // Ewma: alpha. Kalman: q, r. Hysteresis: margin.
+        double a = 0.0;
+        double b = 0.0;
+        // Ewma and Kalman estimate, Hysteresis output.
+        double x = 0.0;
+        // Kalman error variance.
+        double p = 0.0;
+        // Median ring.
+        int size = 0;
+        int count = 0;
+        int next = 0;
+        double window[maxMedian] = {};
+        // Hysteresis bands, ascending; band i lies above threshold i - 1.
+        int thresholdCount = 0;
+        double thresholds[maxThresholds] = {};
+        int band = 0;
+    };
+
+    static double applyStage(Stage &stage, double value);
+
+    Stage m_stages[maxStages];
+    int m_stageCount = 0;
+    QString m_spec;
+};
@@ -0,0 +1,172 @@
+#include "stationmodel.h"
+#include "stationtable.h"
+
+#include <algorithm>
+
+namespace {
+
+double sortKey(const Nl80211StationInfo &info, uint64_t key, int role)
+{
+    switch (role) {
+        case StationModel::SignalRole:             return info.signalDbm;
+        case StationModel::SignalAvgRole:          return info.signalAvgDbm;
+        case StationModel::RxRateRole:             return info.rxBitrate;
+        case StationModel::TxRateRole:             return info.txBitrate;
+        case StationModel::GenerationRole:         return static_cast<int>(info.rxMode);
+        case StationModel::McsRole:                return info.rxMcs;
+        case StationModel::NssRole:                return info.rxNss;
+        case StationModel::ChannelWidthRole:       return Nl80211Helper::channelWidthToMhz(info.rxChannelWidth);
+        case StationModel::RxBytesRole:            return static_cast<double>(info.rxBytes);
+        case StationModel::TxBytesRole:            return static_cast<double>(info.txBytes);
+        case StationModel::InactiveTimeRole:       return info.inactiveTime;
+        case StationModel::ConnectedTimeRole:      return info.connectedTime;
+        case StationModel::ExpectedThroughputRole: return info.expectedThroughput;
+        default:                                   return static_cast<double>(key);
+    }
+}
+
+} // namespace
+
+StationModel::StationModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int StationModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+QVariant StationModel::data(const QModelIndex &index, int role) const
+{
+    if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid)) {
+        return {};
+    }
+
+    const Row &row = m_rows[index.row()];
+    const Nl80211StationInfo &info = row.info;
+    switch (role) {
+        case Qt::DisplayRole:
+        case MacRole:                return StationTable::macToString(row.key);
+        case SignalRole:             return info.signalDbm;
+        case SignalAvgRole:          return info.signalAvgDbm;
+        case RxRateRole:             return info.rxBitrate / 10.0;
+        case TxRateRole:             return info.txBitrate / 10.0;
+        case GenerationRole:         return QString::fromLatin1(Nl80211Helper::wifiModeToGeneration(info.rxMode));
+        case McsRole:                return info.rxMcs;
+        case NssRole:                return info.rxNss;
+        case ChannelWidthRole:       return Nl80211Helper::channelWidthToMhz(info.rxChannelWidth);
+        case RxBytesRole:            return static_cast<qulonglong>(info.rxBytes);
+        case TxBytesRole:            return static_cast<qulonglong>(info.txBytes);
+        case InactiveTimeRole:       return info.inactiveTime;
+        case ConnectedTimeRole:      return info.connectedTime;
+        case ExpectedThroughputRole: return info.expectedThroughput / 1000.0;
+        default:                     return {};
+    }
+}
+
+QHash<int, QByteArray> StationModel::roleNames() const
+{
+    return {
+        {MacRole, QByteArrayLiteral("mac")},
+        {SignalRole, QByteArrayLiteral("signal")},
+        {SignalAvgRole, QByteArrayLiteral("signalAvg")},
+        {RxRateRole, QByteArrayLiteral("rxRate")},
+        {TxRateRole, QByteArrayLiteral("txRate")},
+        {GenerationRole, QByteArrayLiteral("generation")},
+        {McsRole, QByteArrayLiteral("mcs")},
+        {NssRole, QByteArrayLiteral("nss")},
+        {ChannelWidthRole, QByteArrayLiteral("channelWidth")},
+        {RxBytesRole, QByteArrayLiteral("rxBytes")},
+        {TxBytesRole, QByteArrayLiteral("txBytes")},
+        {InactiveTimeRole, QByteArrayLiteral("inactiveTime")},
+        {ConnectedTimeRole, QByteArrayLiteral("connectedTime")},
+        {ExpectedThroughputRole, QByteArrayLiteral("expectedThroughput")},
+    };
+}
+
+QString StationModel::sortRoleName() const
+{
+    return QString::fromLatin1(roleNames().value(m_sortRole));
+}
+
+void StationModel::setSortRoleName(const QString &name)
+{
+    const int role = roleNames().key(name.toLatin1(), -1);
+    if (role < 0 || role == m_sortRole) {
+        return;
+    }
+    m_sortRole = role;
+    resort();
+    Q_EMIT sortChanged();
+}
+
+Qt::SortOrder StationModel::sortOrder() const
+{
+    return m_sortOrder;
+}
+
+void StationModel::setSortOrder(Qt::SortOrder order)
+{
+    if (order == m_sortOrder) {
+        return;
+    }
+    m_sortOrder = order;
+    resort();
+    Q_EMIT sortChanged();
+}
+
+void StationModel::update(const StationTable &table)
+{
+    m_scratch.clear();
+    for (int i = 0; i < table.size(); ++i) {
+        const StationTable::Entry &entry = table.at(i);
+        m_scratch.append(Row{entry.key, entry.info});
+    }
+    sortRows(m_scratch);
+
+    const bool sameLayout = std::equal(m_rows.cbegin(), m_rows.cend(), m_scratch.cbegin(), m_scratch.cend(),
+                                       [](const Row &a, const Row &b) {
+                                           return a.key == b.key;
+                                       });
+    if (sameLayout) {
+        m_rows.swap(m_scratch);
+        if (!m_rows.isEmpty()) {
+            Q_EMIT dataChanged(index(0), index(m_rows.size() - 1));
+        }
+        return;
+    }
+
+    const bool countChanging = m_rows.size() != m_scratch.size();
+    beginResetModel();
+    m_rows.swap(m_scratch);
+    endResetModel();
+    if (countChanging) {
+        Q_EMIT countChanged();
+    }
+}
+
+void StationModel::sortRows(QVector<Row> &rows) const
+{
+    const int role = m_sortRole;
+    const bool descending = m_sortOrder == Qt::DescendingOrder;
+    // Ties fall back to the MAC so equal rows do not swap places every tick.
+    std::sort(rows.begin(), rows.end(), [role, descending](const Row &a, const Row &b) {
+        const double ka = sortKey(a.info, a.key, role);
+        const double kb = sortKey(b.info, b.key, role);
+        if (ka != kb) {
+            return descending ? ka > kb : ka < kb;
+        }
+        return a.key < b.key;
+    });
+}
+
+void StationModel::resort()
+{
+    if (m_rows.size() < 2) {
+        return;
+    }
+    beginResetModel();
+    sortRows(m_rows);
+    endResetModel();
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QVector>
+
+#include "nl80211helper.h"
+
+class StationTable;
+
+/**
+ * @brief Stations of an AP, mesh or P2P-GO interface for QML views
+ *
+ * Rows are copied out of the StationTable once per tick into storage that
+ * is reused between ticks. When the sorted station list did not change
+ * only dataChanged() is emitted, so delegates are updated in place instead
+ * of being recreated.
+ */
+class StationModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+    // Role name to sort by, e.g. "signal" or "rxRate".
+    Q_PROPERTY(QString sortRole READ sortRoleName WRITE setSortRoleName NOTIFY sortChanged)
+    Q_PROPERTY(Qt::SortOrder sortOrder READ sortOrder WRITE setSortOrder NOTIFY sortChanged)
+
+public:
+    enum Roles {
+        MacRole = Qt::UserRole + 1,
+        SignalRole,
+        SignalAvgRole,
+        RxRateRole,
+        TxRateRole,
+        GenerationRole,
+        McsRole,
+        NssRole,
+        ChannelWidthRole,
+        RxBytesRole,
+        TxBytesRole,
+        InactiveTimeRole,
+        ConnectedTimeRole,
+        ExpectedThroughputRole,
+    };
+    Q_ENUM(Roles)
+
+    explicit StationModel(QObject *parent = nullptr);
+
+    [[nodiscard]] int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    [[nodiscard]] QVariant data(const QModelIndex &index, int role) const override;
+    [[nodiscard]] QHash<int, QByteArray> roleNames() const override;
+
+    [[nodiscard]] QString sortRoleName() const;
+    void setSortRoleName(const QString &name);
+    [[nodiscard]] Qt::SortOrder sortOrder() const;
+    void setSortOrder(Qt::SortOrder order);
+
+    // Replaces the rows with the current contents of @p table.
+    void update(const StationTable &table);
+
+Q_SIGNALS:
+    void countChanged();
+    void sortChanged();
+
+private:
+    struct Row {
+        uint64_t key = 0;
+        Nl80211StationInfo info;
+    };
+
+    void sortRows(QVector<Row> &rows) const;
+    void resort();
+
+    QVector<Row> m_rows;
+    // Filled by update() and swapped with m_rows, so neither reallocates once warm.
+    QVector<Row> m_scratch;
+    int m_sortRole = SignalRole;
+    Qt::SortOrder m_sortOrder = Qt::DescendingOrder;
+};
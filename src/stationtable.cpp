@@ -0,0 +1,176 @@
+#include "stationtable.h"
+
+namespace {
+
+uint32_t hashKey(uint64_t key)
+{
+    // Fibonacci hashing; vendor OUIs make the low bytes of neighbouring MACs very similar.
+    return static_cast<uint32_t>((key * 0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+int slotCountFor(int stations)
+{
+    // Keep the load factor at or below 1/2 so probe sequences stay short.
+    int count = 16;
+    while (count < stations * 2) {
+        count *= 2;
+    }
+    return count;
+}
+
+} // namespace
+
+StationTable::StationTable(int expectedStations)
+{
+    m_entries.reserve(expectedStations);
+    rehash(slotCountFor(expectedStations));
+}
+
+void StationTable::beginUpdate()
+{
+    ++m_generation;
+}
+
+Nl80211StationInfo &StationTable::upsert(const uint8_t *mac)
+{
+    const uint64_t key = packMac(mac);
+    const int slot = slotFor(key);
+
+    int index = slot >= 0 ? m_slots[slot].index : -1;
+    if (index < 0) {
+        if ((m_entries.size() + 1) * 2 > m_slots.size()) {
+            rehash(m_slots.size() * 2);
+        }
+        index = m_entries.size();
+        m_entries.append(Entry{key, m_generation, {}});
+        insertSlot(key, index);
+    }
+
+    Entry &entry = m_entries[index];
+    entry.generation = m_generation;
+    entry.info = Nl80211StationInfo{};
+    return entry.info;
+}
+
+int StationTable::endUpdate()
+{
+    int evicted = 0;
+    for (int i = m_entries.size() - 1; i >= 0; --i) {
+        if (m_entries[i].generation == m_generation) {
+            continue;
+        }
+        eraseSlot(m_entries[i].key);
+        const int last = m_entries.size() - 1;
+        if (i != last) {
+            m_entries[i] = m_entries[last];
+            m_slots[slotFor(m_entries[i].key)].index = i;
+        }
+        // removeLast() keeps the capacity, so the next dump reuses the storage.
+        m_entries.removeLast();
+        ++evicted;
+    }
+    return evicted;
+}
+
+const Nl80211StationInfo *StationTable::find(const uint8_t *mac) const
+{
+    const int slot = slotFor(packMac(mac));
+    return slot >= 0 ? &m_entries[m_slots[slot].index].info : nullptr;
+}
+
+int StationTable::size() const
+{
+    return m_entries.size();
+}
+
+bool StationTable::isEmpty() const
+{
+    return m_entries.isEmpty();
+}
+
+const StationTable::Entry &StationTable::at(int index) const
+{
+    return m_entries[index];
+}
+
+void StationTable::clear()
+{
+    m_entries.clear();
+    for (Slot &slot : m_slots) {
+        slot = Slot{};
+    }
+}
+
+uint64_t StationTable::packMac(const uint8_t *mac)
+{
+    uint64_t key = 0;
+    for (int i = 0; i < 6; ++i) {
+        key = (key << 8) | mac[i];
+    }
+    return key;
+}
+
+QString StationTable::macToString(uint64_t key)
+{
+    static const char hex[] = "0123456789abcdef";
+    QString text(17, QLatin1Char(':'));
+    for (int i = 0; i < 6; ++i) {
+        const auto byte = static_cast<uint8_t>(key >> (8 * (5 - i)));
+        text[i * 3] = QLatin1Char(hex[byte >> 4]);
+        text[i * 3 + 1] = QLatin1Char(hex[byte & 0xf]);
+    }
+    return text;
+}
+
+int StationTable::slotFor(uint64_t key) const
+{
+    for (uint32_t i = hashKey(key) & m_mask;; i = (i + 1) & m_mask) {
+        const Slot &slot = m_slots[i];
+        if (slot.key == key) {
+            return static_cast<int>(i);
+        }
+        if (slot.key == emptyKey) {
+            return -1;
+        }
+    }
+}
+
+void StationTable::insertSlot(uint64_t key, int32_t index)
+{
+    uint32_t i = hashKey(key) & m_mask;
+    while (m_slots[i].key != emptyKey) {
+        i = (i + 1) & m_mask;
+    }
+    m_slots[i] = Slot{key, index};
+}
+
+void StationTable::eraseSlot(uint64_t key)
+{
+    int found = slotFor(key);
+    if (found < 0) {
+        return;
+    }
+
+    // Backward-shift deletion: pull later members of the probe run into the
+    // hole so lookups never need tombstones.
+    auto hole = static_cast<uint32_t>(found);
+    for (uint32_t i = (hole + 1) & m_mask; m_slots[i].key != emptyKey; i = (i + 1) & m_mask) {
+        const uint32_t home = hashKey(m_slots[i].key) & m_mask;
+        // Move the entry unless its home lies cyclically in (hole, i].
+        const bool homeInRange = hole <= i ? (hole < home && home <= i) : (hole < home || home <= i);
+        if (!homeInRange) {
+            m_slots[hole] = m_slots[i];
+            hole = i;
+        }
+    }
+    m_slots[hole] = Slot{};
+}
+
+void StationTable::rehash(int slotCount)
+{
+    m_slots.fill(Slot{}, slotCount);
+    m_mask = static_cast<uint32_t>(slotCount - 1);
+    for (int i = 0; i < m_entries.size(); ++i) {
+        insertSlot(m_entries[i].key, i);
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "nl80211helper.h"
+
+#include <QString>
+#include <QVector>
+
+#include <cstdint>
+
+/**
+ * @brief Stations of one interface, keyed by MAC address
+ *
+ * AP, mesh and P2P-GO interfaces report one station per peer in a single
+ * NL80211_CMD_GET_STATION dump. The table keeps them in a dense array and
+ * finds them through an open-addressing (linear probing) index keyed by the
+ * packed 48-bit MAC, so a dump of hundreds of stations is a lookup and an
+ * in-place overwrite per station. Storage only grows when the peer count
+ * exceeds anything seen before; stations missing from a dump are evicted
+ * in endUpdate() by comparing generations.
+ */
+class StationTable
+{
+public:
+    struct Entry {
+        uint64_t key = 0;
+        uint32_t generation = 0;
+        Nl80211StationInfo info;
+    };
+
+    explicit StationTable(int expectedStations = 32);
+
+    // Starts a new dump. Stations not upserted before endUpdate() are dropped.
+    void beginUpdate();
+    // Entry for @p mac (6 bytes), reset to a default Nl80211StationInfo and marked as seen.
+    Nl80211StationInfo &upsert(const uint8_t *mac);
+    // Evicts stations not seen since beginUpdate(); returns how many were removed.
+    int endUpdate();
+
+    [[nodiscard]] const Nl80211StationInfo *find(const uint8_t *mac) const;
+    [[nodiscard]] int size() const;
+    [[nodiscard]] bool isEmpty() const;
+    [[nodiscard]] const Entry &at(int index) const;
+    void clear();
+
+    static uint64_t packMac(const uint8_t *mac);
+    static QString macToString(uint64_t key);
+
+private:
+    struct Slot {
+        uint64_t key = emptyKey;
+        int32_t index = -1;
+    };
+
+    // A packed MAC only uses the low 48 bits, so this never collides with a station.
+    static constexpr uint64_t emptyKey = ~uint64_t(0);
+
+    [[nodiscard]] int slotFor(uint64_t key) const;
+    void insertSlot(uint64_t key, int32_t index);
+    void eraseSlot(uint64_t key);
+    void rehash(int slotCount);
+
+    QVector<Entry> m_entries;
+    QVector<Slot> m_slots;
+    uint32_t m_mask = 0;
+    uint32_t m_generation = 0;
+};
@@ -0,0 +1,272 @@
+#include "statsbackend.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char procWirelessPath[] = "/proc/net/wireless";
+
+// One pread() of a small kernel-generated file into @p buffer, NUL-terminated.
+int readAt0(int fd, char *buffer, int size)
+{
+    ssize_t length;
+    do {
+        length = pread(fd, buffer, static_cast<size_t>(size - 1), 0);
+    } while (length < 0 && errno == EINTR);
+    if (length < 0) {
+        return -1;
+    }
+    buffer[length] = '\0';
+    return static_cast<int>(length);
+}
+
+// Integer part of a /proc/net/wireless column such as "-52." or "0000".
+const char *parseColumn(const char *p, long *value, int base = 10)
+{
+    char *end = nullptr;
+    *value = std::strtol(p, &end, base);
+    if (end == p) {
+        return nullptr;
+    }
+    while (*end == '.' || (*end >= '0' && *end <= '9')) {
+        ++end;
+    }
+    return end;
+}
+
+} // namespace
+
+StatsBackend *StatsBackend::select(StatsBackend *const *backends, int count, uint32_t required)
+{
+    for (int i = 0; i < count; ++i) {
+        if ((backends[i]->fields() & required) == required) {
+            return backends[i];
+        }
+    }
+    return nullptr;
+}
+
+Nl80211Backend::Nl80211Backend(Nl80211Helper &helper)
+    : m_helper(helper)
+{
+}
+
+const char *Nl80211Backend::name() const
+{
+    return "nl80211";
+}
+
+uint32_t Nl80211Backend::fields() const
+{
+    return AllFields;
+}
+
+Nl80211StationInfo Nl80211Backend::sample(const char *ifname, const uint8_t *bssid)
+{
+    return m_helper.getStationInfo(ifname, bssid);
+}
+
+QString Nl80211Backend::lastError() const
+{
+    return m_helper.lastError();
+}
+
+ProcWirelessBackend::~ProcWirelessBackend()
+{
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+}
+
+const char *ProcWirelessBackend::name() const
+{
+    return "proc";
+}
+
+uint32_t ProcWirelessBackend::fields() const
+{
+    return Signal;
+}
+
+Nl80211StationInfo ProcWirelessBackend::sample(const char *ifname, const uint8_t *bssid)
+{
+    Q_UNUSED(bssid)
+    Nl80211StationInfo info;
+
+    if (m_fd < 0) {
+        m_fd = ::open(procWirelessPath, O_RDONLY | O_CLOEXEC);
+        if (m_fd < 0) {
+            m_lastError = QStringLiteral("Cannot open %1: %2")
+                .arg(QLatin1String(procWirelessPath), QString::fromLocal8Bit(std::strerror(errno)));
+            return info;
+        }
+    }
+
+    // A line per wireless interface plus two header lines.
+    char buffer[2048];
+    const int length = readAt0(m_fd, buffer, sizeof(buffer));
+    if (length < 0) {
+        m_lastError = QStringLiteral("Cannot read %1: %2")
+            .arg(QLatin1String(procWirelessPath), QString::fromLocal8Bit(std::strerror(errno)));
+        ::close(m_fd);
+        m_fd = -1;
+        return info;
+    }
+
+    if (!parse(buffer, length, ifname, &info.signalDbm)) {
+        m_lastError = QStringLiteral("%1 not listed in %2").arg(QString::fromUtf8(ifname), QLatin1String(procWirelessPath));
+        return info;
+    }
+    m_lastError.clear();
+    info.valid = true;
+    return info;
+}
+
+QString ProcWirelessBackend::lastError() const
+{
+    return m_lastError;
+}
+
+bool ProcWirelessBackend::parse(const char *text, int length, const char *ifname, int32_t *signalDbm)
+{
+    const size_t nameLength = std::strlen(ifname);
+    const char *end = text + length;
+    for (const char *line = text; line < end;) {
+        const char *next = static_cast<const char *>(std::memchr(line, '\n', static_cast<size_t>(end - line)));
+        next = next ? next + 1 : end;
+
+        const char *p = line;
+        while (p < next && *p == ' ') {
+            ++p;
+        }
+        // "wlan0: 0000   58.  -52.  -256  ..." - status, link, level, noise.
+        if (static_cast<size_t>(next - p) > nameLength && std::memcmp(p, ifname, nameLength) == 0 && p[nameLength] == ':') {
+            long status = 0;
+            long link = 0;
+            long level = 0;
+            p = parseColumn(p + nameLength + 1, &status, 16);
+            p = p ? parseColumn(p, &link) : nullptr;
+            p = p ? parseColumn(p, &level) : nullptr;
+            if (!p || level == 0) {
+                return false; // not associated
+            }
+            // Drivers without IW_QUAL_DBM report the level as an unsigned byte.
+            *signalDbm = static_cast<int32_t>(level > 0 ? level - 256 : level);
+            return true;
+        }
+        line = next;
+    }
+    return false;
+}
+
+SysfsBackend::~SysfsBackend()
+{
+    close();
+}
+
+const char *SysfsBackend::name() const
+{
+    return "sysfs";
+}
+
+uint32_t SysfsBackend::fields() const
+{
+    return Counters;
+}
+
+Nl80211StationInfo SysfsBackend::sample(const char *ifname, const uint8_t *bssid)
+{
+    Q_UNUSED(bssid)
+    Nl80211StationInfo info;
+
+    if (m_ifname != ifname && !open(ifname)) {
+        return info;
+    }
+
+    uint64_t values[CounterFileCount] = {};
+    for (int i = 0; i < CounterFileCount; ++i) {
+        char buffer[32];
+        if (readAt0(m_fds[i], buffer, sizeof(buffer)) <= 0) {
+            m_lastError = QStringLiteral("Cannot read statistics of %1: %2")
+                .arg(QString::fromUtf8(ifname), QString::fromLocal8Bit(std::strerror(errno)));
+            close(); // the interface may have gone; reopen next time
+            return info;
+        }
+        values[i] = std::strtoull(buffer, nullptr, 10);
+    }
+
+    info.rxBytes = values[RxBytes];
+    info.txBytes = values[TxBytes];
+    info.rxPackets = static_cast<uint32_t>(values[RxPackets]);
+    info.txPackets = static_cast<uint32_t>(values[TxPackets]);
+    m_lastError.clear();
+    info.valid = true;
+    return info;
+}
+
+QString SysfsBackend::lastError() const
+{
+    return m_lastError;
+}
+
+bool SysfsBackend::open(const char *ifname)
+{
+    static constexpr const char *fileNames[CounterFileCount] = {"rx_bytes", "tx_bytes", "rx_packets", "tx_packets"};
+
+    close();
+    for (int i = 0; i < CounterFileCount; ++i) {
+        const QByteArray path = QByteArray("/sys/class/net/") + ifname + "/statistics/" + fileNames[i];
+        m_fds[i] = ::open(path.constData(), O_RDONLY | O_CLOEXEC);
+        if (m_fds[i] < 0) {
+            m_lastError = QStringLiteral("Cannot open %1: %2")
+                .arg(QString::fromUtf8(path), QString::fromLocal8Bit(std::strerror(errno)));
+            close();
+            return false;
+        }
+    }
+    m_ifname = ifname;
+    return true;
+}
+
+void SysfsBackend::close()
+{
+    for (int &fd : m_fds) {
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    m_ifname.clear();
+}
+
+SyntheticBackend::SyntheticBackend(int intervalMs, uint32_t seed)
+    : m_station(seed)
+    , m_intervalMs(intervalMs)
+{
+}
+
+const char *SyntheticBackend::name() const
+{
+    return "synthetic";
+}
+
+uint32_t SyntheticBackend::fields() const
+{
+    return AllFields;
+}
+
+Nl80211StationInfo SyntheticBackend::sample(const char *ifname, const uint8_t *bssid)
+{
+    Q_UNUSED(ifname)
+    Q_UNUSED(bssid)
+    return m_station.next(m_intervalMs);
+}
+
+QString SyntheticBackend::lastError() const
+{
+    return QString();
+}
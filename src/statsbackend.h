@@ -0,0 +1,153 @@
+#pragma once
+
+#include "nl80211helper.h"
+#include "syntheticstation.h"
+
+#include <QByteArray>
+#include <QString>
+
+#include <cstdint>
+
+/**
+ * @brief Source of per-sample station statistics
+ *
+ * Backends differ in cost and in which Nl80211StationInfo fields they can
+ * fill. The caller states the fields it needs and select() picks the
+ * cheapest backend that covers them, so an icon that only shows the signal
+ * level does not pay for a full nl80211 GET_STATION round trip.
+ */
+class StatsBackend
+{
+public:
+    enum Field : uint32_t {
+        Signal = 1 << 0,   // signalDbm
+        Counters = 1 << 1, // rx/tx bytes and packets
+        Rates = 1 << 2,    // bitrates, MCS, NSS, width, mode, guard interval
+        Extended = 1 << 3, // retries, beacons, chains, ACK signal, airtime, timers
+        AllFields = Signal | Counters | Rates | Extended,
+    };
+
+    virtual ~StatsBackend() = default;
+
+    [[nodiscard]] virtual const char *name() const = 0;
+    // Bit mask of Field values this backend fills in.
+    [[nodiscard]] virtual uint32_t fields() const = 0;
+    // Fields outside fields() are left at their defaults; valid is false on failure.
+    [[nodiscard]] virtual Nl80211StationInfo sample(const char *ifname, const uint8_t *bssid) = 0;
+    [[nodiscard]] virtual QString lastError() const = 0;
+
+    /**
+     * First of @p backends (ordered cheapest first) whose fields() cover
+     * @p required, or nullptr if none does.
+     */
+    static StatsBackend *select(StatsBackend *const *backends, int count, uint32_t required);
+};
+
+/**
+ * @brief Full station statistics from nl80211 GET_STATION
+ *
+ * Wraps a helper owned by the caller, which also uses it for wiphy and
+ * station dumps.
+ */
+class Nl80211Backend : public StatsBackend
+{
+public:
+    explicit Nl80211Backend(Nl80211Helper &helper);
+
+    [[nodiscard]] const char *name() const override;
+    [[nodiscard]] uint32_t fields() const override;
+    [[nodiscard]] Nl80211StationInfo sample(const char *ifname, const uint8_t *bssid) override;
+    [[nodiscard]] QString lastError() const override;
+
+private:
+    Nl80211Helper &m_helper;
+};
+
+/**
+ * @brief Signal level from /proc/net/wireless
+ *
+ * The file is opened once and re-read with pread() at offset 0, which makes
+ * the kernel regenerate it, so a sample is one syscall and a short parse.
+ * Only the associated AP's signal is available; @p bssid is ignored.
+ */
+class ProcWirelessBackend : public StatsBackend
+{
+public:
+    ProcWirelessBackend() = default;
+    ~ProcWirelessBackend() override;
+
+    ProcWirelessBackend(const ProcWirelessBackend &) = delete;
+    ProcWirelessBackend &operator=(const ProcWirelessBackend &) = delete;
+
+    [[nodiscard]] const char *name() const override;
+    [[nodiscard]] uint32_t fields() const override;
+    [[nodiscard]] Nl80211StationInfo sample(const char *ifname, const uint8_t *bssid) override;
+    [[nodiscard]] QString lastError() const override;
+
+    // Parses one /proc/net/wireless snapshot; false if @p ifname has no line.
+    static bool parse(const char *text, int length, const char *ifname, int32_t *signalDbm);
+
+private:
+    int m_fd = -1;
+    QString m_lastError;
+};
+
+/**
+ * @brief Interface traffic counters from /sys/class/net/<ifname>/statistics
+ *
+ * Keeps one descriptor per counter file open for the current interface and
+ * re-reads them with pread(). These count the whole interface rather than
+ * one peer, which on a station interface is the same thing.
+ */
+class SysfsBackend : public StatsBackend
+{
+public:
+    SysfsBackend() = default;
+    ~SysfsBackend() override;
+
+    SysfsBackend(const SysfsBackend &) = delete;
+    SysfsBackend &operator=(const SysfsBackend &) = delete;
+
+    [[nodiscard]] const char *name() const override;
+    [[nodiscard]] uint32_t fields() const override;
+    [[nodiscard]] Nl80211StationInfo sample(const char *ifname, const uint8_t *bssid) override;
+    [[nodiscard]] QString lastError() const override;
+
+private:
+    enum CounterFile {
+        RxBytes = 0,
+        TxBytes,
+        RxPackets,
+        TxPackets,
+        CounterFileCount,
+    };
+
+    bool open(const char *ifname);
+    void close();
+
+    QByteArray m_ifname;
+    int m_fds[CounterFileCount] = {-1, -1, -1, -1};
+    QString m_lastError;
+};
+
+/**
+ * @brief Samples from a SyntheticStation instead of the kernel
+ *
+ * Lets the UI and the sampling pipeline be exercised at any rate on
+ * machines without a wireless link, e.g. by the QML benchmark.
+ */
+class SyntheticBackend : public StatsBackend
+{
+public:
+    // @p intervalMs is how far the simulated link advances per sample.
+    explicit SyntheticBackend(int intervalMs, uint32_t seed = 1);
+
+    [[nodiscard]] const char *name() const override;
+    [[nodiscard]] uint32_t fields() const override;
+    [[nodiscard]] Nl80211StationInfo sample(const char *ifname, const uint8_t *bssid) override;
+    [[nodiscard]] QString lastError() const override;
+
+private:
+    SyntheticStation m_station;
+    int m_intervalMs;
+};
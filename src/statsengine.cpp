@@ -0,0 +1,310 @@
+#include "statsengine.h"
+#include "phyrates.h"
+#include "profiler.h"
+
+#include <QtGlobal>
+
+#include <algorithm>
+
+namespace {
+
+// Appends @p value to a window of at most StatsEngine::historySize samples.
+// Once full the window is shifted in place: removeFirst() plus append() on a
+// QVector eventually reallocates to reclaim the space freed at the front.
+void pushToWindow(QVector<double> &window, double value)
+{
+    if (window.size() < StatsEngine::historySize) {
+        if (window.capacity() < StatsEngine::historySize) {
+            window.reserve(StatsEngine::historySize);
+        }
+        window.append(value);
+        return;
+    }
+    std::move(window.begin() + 1, window.end(), window.begin());
+    window.last() = value;
+}
+
+} // namespace
+
+void StatsEngine::addSample(const Nl80211StationInfo &info, int64_t timestampMs)
+{
+    const Profiler::Scope profile(Profiler::Stage::History);
+    Profiler::increment(Profiler::Counter::Samples);
+
+    m_stationInfo = info;
+    m_lastFullSample = info;
+
+    m_smoothedTxRate = m_txFilter.apply(info.txBitrate / 10.0);
+    m_smoothedRxRate = m_rxFilter.apply(info.rxBitrate / 10.0);
+    if (info.signalDbm != 0) {
+        m_filteredSignalDbm = m_signalFilter.apply(info.signalDbm);
+    }
+
+    addToHistory(m_smoothedRxRate, m_smoothedTxRate);
+    addChainsToHistory(info);
+    updateEfficiency(info);
+
+    m_lastEventCount = m_detector.addSample(timestampMs, info, m_lastEvents);
+}
+
+void StatsEngine::updateSignal(int32_t signalDbm, int64_t timestampMs)
+{
+    Profiler::increment(Profiler::Counter::Samples);
+    m_stationInfo = Nl80211StationInfo{};
+    m_stationInfo.valid = true;
+    m_stationInfo.signalDbm = signalDbm;
+    // Nothing current to derive these from; the filters keep their state
+    // for when full samples resume.
+    m_smoothedTxRate = 0.0;
+    m_smoothedRxRate = 0.0;
+    m_rxMaxRate = 0;
+    m_txMaxRate = 0;
+    m_rxEfficiency = 0.0;
+    m_txEfficiency = 0.0;
+    m_smoothedEfficiency = 0.0;
+    if (signalDbm != 0) {
+        m_filteredSignalDbm = m_signalFilter.apply(signalDbm);
+    }
+
+    m_lastEventCount = m_detector.addSignal(timestampMs, signalDbm, m_lastEvents);
+}
+
+void StatsEngine::reset()
+{
+    m_stationInfo = Nl80211StationInfo{};
+    m_lastFullSample = Nl80211StationInfo{};
+    m_signalFilter.reset();
+    m_rxFilter.reset();
+    m_txFilter.reset();
+    m_efficiencyFilter.reset();
+    m_filteredSignalDbm = 0.0;
+    m_smoothedTxRate = 0.0;
+    m_smoothedRxRate = 0.0;
+    m_rxHistory.clear();
+    m_txHistory.clear();
+    m_maxRate = 100.0;
+    for (QVector<double> &buffer : m_chainHistory) {
+        buffer.clear();
+    }
+    m_chainImbalanceDb = 0.0;
+    m_rxMaxRate = 0;
+    m_txMaxRate = 0;
+    m_rxEfficiency = 0.0;
+    m_txEfficiency = 0.0;
+    m_smoothedEfficiency = 0.0;
+    m_detector.reset();
+    m_lastEventCount = 0;
+}
+
+bool StatsEngine::setSignalFilter(const QString &spec, QString *error)
+{
+    return m_signalFilter.setSpec(spec, error);
+}
+
+bool StatsEngine::setRateFilter(const QString &spec, QString *error)
+{
+    // Validated once so the two directions can't end up with different pipelines.
+    if (!m_rxFilter.setSpec(spec, error)) {
+        return false;
+    }
+    m_txFilter.setSpec(spec, nullptr);
+    return true;
+}
+
+bool StatsEngine::setEfficiencyFilter(const QString &spec, QString *error)
+{
+    return m_efficiencyFilter.setSpec(spec, error);
+}
+
+QString StatsEngine::signalFilter() const
+{
+    return m_signalFilter.spec();
+}
+
+QString StatsEngine::rateFilter() const
+{
+    return m_rxFilter.spec();
+}
+
+QString StatsEngine::efficiencyFilter() const
+{
+    return m_efficiencyFilter.spec();
+}
+
+const Nl80211StationInfo &StatsEngine::stationInfo() const
+{
+    return m_stationInfo;
+}
+
+const Nl80211StationInfo &StatsEngine::lastFullSample() const
+{
+    return m_lastFullSample;
+}
+
+double StatsEngine::filteredSignalDbm() const
+{
+    return m_filteredSignalDbm;
+}
+
+double StatsEngine::smoothedTxRate() const
+{
+    return m_smoothedTxRate;
+}
+
+double StatsEngine::smoothedRxRate() const
+{
+    return m_smoothedRxRate;
+}
+
+const QVector<double> &StatsEngine::rxHistory() const
+{
+    return m_rxHistory;
+}
+
+const QVector<double> &StatsEngine::txHistory() const
+{
+    return m_txHistory;
+}
+
+double StatsEngine::maxHistoryRate() const
+{
+    return m_maxRate;
+}
+
+const QVector<double> &StatsEngine::chainHistory(int chain) const
+{
+    Q_ASSERT(chain >= 0 && chain < Nl80211StationInfo::maxChains);
+    return m_chainHistory[chain];
+}
+
+double StatsEngine::chainImbalanceDb() const
+{
+    return m_chainImbalanceDb;
+}
+
+bool StatsEngine::chainImbalanced() const
+{
+    return m_chainImbalanceDb >= chainImbalanceThresholdDb;
+}
+
+uint32_t StatsEngine::rxMaxRate() const
+{
+    return m_rxMaxRate;
+}
+
+uint32_t StatsEngine::txMaxRate() const
+{
+    return m_txMaxRate;
+}
+
+double StatsEngine::rxEfficiency() const
+{
+    return m_rxEfficiency;
+}
+
+double StatsEngine::txEfficiency() const
+{
+    return m_txEfficiency;
+}
+
+double StatsEngine::smoothedEfficiency() const
+{
+    return m_smoothedEfficiency;
+}
+
+bool StatsEngine::belowCapability() const
+{
+    return m_smoothedEfficiency > 0.0
+        && m_smoothedEfficiency < belowCapabilityEfficiency
+        && m_stationInfo.signalDbm >= belowCapabilityMinSignalDbm
+        && m_stationInfo.signalDbm != 0;
+}
+
+int StatsEngine::lastEventCount() const
+{
+    return m_lastEventCount;
+}
+
+const LinkDetector::Event &StatsEngine::lastEvent(int index) const
+{
+    Q_ASSERT(index >= 0 && index < m_lastEventCount);
+    return m_lastEvents[index];
+}
+
+bool StatsEngine::linkDegraded() const
+{
+    return m_detector.anyDegraded();
+}
+
+int32_t StatsEngine::chainSignalDbm(const Nl80211StationInfo &info, int chain)
+{
+    return info.chainSignal[chain] != 0 ? info.chainSignal[chain] : info.chainSignalAvg[chain];
+}
+
+void StatsEngine::addToHistory(double rx, double tx)
+{
+    pushToWindow(m_rxHistory, rx);
+    pushToWindow(m_txHistory, tx);
+    m_maxRate = 100.0;
+    for (double v : m_rxHistory) m_maxRate = qMax(m_maxRate, v);
+    for (double v : m_txHistory) m_maxRate = qMax(m_maxRate, v);
+}
+
+void StatsEngine::addChainsToHistory(const Nl80211StationInfo &info)
+{
+    for (int i = 0; i < Nl80211StationInfo::maxChains; ++i) {
+        QVector<double> &buffer = m_chainHistory[i];
+        if (i >= info.chainCount) {
+            buffer.clear();
+            continue;
+        }
+        pushToWindow(buffer, chainSignalDbm(info, i));
+    }
+
+    double strongest = 0.0;
+    double weakest = 0.0;
+    int chains = 0;
+    for (int i = 0; i < info.chainCount; ++i) {
+        const QVector<double> &buffer = m_chainHistory[i];
+        if (buffer.size() < chainImbalanceMinSamples) {
+            continue;
+        }
+        double sum = 0.0;
+        for (double v : buffer) sum += v;
+        const double mean = sum / buffer.size();
+        strongest = chains == 0 ? mean : qMax(strongest, mean);
+        weakest = chains == 0 ? mean : qMin(weakest, mean);
+        ++chains;
+    }
+    m_chainImbalanceDb = chains >= 2 ? strongest - weakest : 0.0;
+}
+
+void StatsEngine::updateEfficiency(const Nl80211StationInfo &info)
+{
+    if (info.linkCount > 0) {
+        // MLO: the bitrates are summed over the links, so are the ceilings.
+        m_rxMaxRate = 0;
+        m_txMaxRate = 0;
+        for (int i = 0; i < info.linkCount; ++i) {
+            const Nl80211StationInfo::Link &link = info.links[i];
+            m_rxMaxRate += PhyRates::maxRate(link.rxMode, link.rxChannelWidth, link.rxNss);
+            m_txMaxRate += PhyRates::maxRate(link.txMode, link.txChannelWidth, link.txNss);
+        }
+    } else {
+        m_rxMaxRate = PhyRates::maxRate(info.rxMode, info.rxChannelWidth, info.rxNss);
+        m_txMaxRate = PhyRates::maxRate(info.txMode, info.txChannelWidth, info.txNss);
+    }
+    m_rxEfficiency = m_rxMaxRate > 0 ? qMin(1.0, static_cast<double>(info.rxBitrate) / m_rxMaxRate) : 0.0;
+    m_txEfficiency = m_txMaxRate > 0 ? qMin(1.0, static_cast<double>(info.txBitrate) / m_txMaxRate) : 0.0;
+
+    // Rate control hops around constantly, so judge the link on the smoothed
+    // value of the better direction rather than a single tick. Without a
+    // rate there is nothing to judge, and the filter starts over.
+    const double efficiency = qMax(m_rxEfficiency, m_txEfficiency);
+    if (efficiency <= 0.0) {
+        m_efficiencyFilter.reset();
+        m_smoothedEfficiency = 0.0;
+    } else {
+        m_smoothedEfficiency = m_efficiencyFilter.apply(efficiency);
+    }
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "linkdetector.h"
+#include "nl80211helper.h"
+#include "signalfilter.h"
+
+#include <QVector>
+
+/**
+ * @brief Per-sample processing shared by the plasmoid and the command-line sampler
+ *
+ * Holds the latest station info, the filtered signal and PHY rates and the
+ * rolling history windows. Has no QtQuick or NetworkManager dependency so it
+ * can be driven from a headless event loop.
+ */
+class StatsEngine
+{
+public:
+    // Default filter specs, see SignalFilter. The rate and efficiency
+    // defaults are the EWMA both have always used.
+    static constexpr const char *defaultSignalFilter = "median:3,ewma:0.5,hysteresis:2";
+    static constexpr const char *defaultRateFilter = "ewma:0.3";
+    static constexpr const char *defaultEfficiencyFilter = "ewma:0.3";
+    static constexpr int historySize = 60;
+
+    static constexpr double chainImbalanceThresholdDb = 10.0;
+    static constexpr int chainImbalanceMinSamples = 5;
+
+    // A strong link that runs below this fraction of its negotiated PHY
+    // capability is usually a rate control, power save or config problem.
+    static constexpr double belowCapabilityEfficiency = 0.4;
+    static constexpr int32_t belowCapabilityMinSignalDbm = -65;
+
+    void addSample(const Nl80211StationInfo &info, int64_t timestampMs);
+    // Refreshes only the signal level, for samples from a backend that reports
+    // nothing else. The signal filter and the detector's signal metric are
+    // fed; the rate histories and their smoothing are left untouched.
+    // stationInfo() then holds the signal alone, so rates, counters and link
+    // details of an older sample are not shown as current.
+    void updateSignal(int32_t signalDbm, int64_t timestampMs);
+    void reset();
+
+    // Replace the filter pipelines and restart them. On a bad spec the
+    // current pipeline stays and @p error says why.
+    bool setSignalFilter(const QString &spec, QString *error);
+    bool setRateFilter(const QString &spec, QString *error);
+    bool setEfficiencyFilter(const QString &spec, QString *error);
+    [[nodiscard]] QString signalFilter() const;
+    [[nodiscard]] QString rateFilter() const;
+    [[nodiscard]] QString efficiencyFilter() const;
+
+    [[nodiscard]] const Nl80211StationInfo &stationInfo() const;
+    // The last sample passed to addSample(), for deltas across signal-only samples.
+    [[nodiscard]] const Nl80211StationInfo &lastFullSample() const;
+    // Signal after the signal filter, in dBm; 0 before the first sample.
+    [[nodiscard]] double filteredSignalDbm() const;
+    [[nodiscard]] double smoothedTxRate() const;
+    [[nodiscard]] double smoothedRxRate() const;
+
+    [[nodiscard]] const QVector<double> &rxHistory() const;
+    [[nodiscard]] const QVector<double> &txHistory() const;
+    [[nodiscard]] double maxHistoryRate() const;
+
+    [[nodiscard]] const QVector<double> &chainHistory(int chain) const;
+    [[nodiscard]] double chainImbalanceDb() const;
+    [[nodiscard]] bool chainImbalanced() const;
+
+    // Best rate for the negotiated mode, width and NSS (100 kbit/s), and the
+    // current rate as a fraction of it. 0 when the mode has no MCS table.
+    [[nodiscard]] uint32_t rxMaxRate() const;
+    [[nodiscard]] uint32_t txMaxRate() const;
+    [[nodiscard]] double rxEfficiency() const;
+    [[nodiscard]] double txEfficiency() const;
+    [[nodiscard]] double smoothedEfficiency() const;
+    [[nodiscard]] bool belowCapability() const;
+
+    // Link degradation/recovery events raised by the most recent addSample() call.
+    [[nodiscard]] int lastEventCount() const;
+    [[nodiscard]] const LinkDetector::Event &lastEvent(int index) const;
+    [[nodiscard]] bool linkDegraded() const;
+
+    // Instantaneous chain signal, falling back to the kernel average when only that is reported.
+    [[nodiscard]] static int32_t chainSignalDbm(const Nl80211StationInfo &info, int chain);
+
+private:
+    void addToHistory(double rx, double tx);
+    void addChainsToHistory(const Nl80211StationInfo &info);
+    void updateEfficiency(const Nl80211StationInfo &info);
+
+    Nl80211StationInfo m_stationInfo;
+    Nl80211StationInfo m_lastFullSample;
+
+    SignalFilter m_signalFilter{QLatin1String(defaultSignalFilter)};
+    SignalFilter m_rxFilter{QLatin1String(defaultRateFilter)};
+    SignalFilter m_txFilter{QLatin1String(defaultRateFilter)};
+    SignalFilter m_efficiencyFilter{QLatin1String(defaultEfficiencyFilter)};
+    double m_filteredSignalDbm = 0.0;
+
+    double m_smoothedTxRate = 0.0;
+    double m_smoothedRxRate = 0.0;
+
+    QVector<double> m_rxHistory;
+    QVector<double> m_txHistory;
+    double m_maxRate = 100.0;
+
+    // Per-chain signal over the same window; a chain that sits far below its
+    // siblings for the whole window usually means a loose or broken antenna lead.
+    QVector<double> m_chainHistory[Nl80211StationInfo::maxChains];
+    double m_chainImbalanceDb = 0.0;
+
+    uint32_t m_rxMaxRate = 0;
+    uint32_t m_txMaxRate = 0;
+    double m_rxEfficiency = 0.0;
+    double m_txEfficiency = 0.0;
+    double m_smoothedEfficiency = 0.0;
+
+    LinkDetector m_detector;
+    LinkDetector::Event m_lastEvents[LinkDetector::metricCount];
+    int m_lastEventCount = 0;
+};
@@ -0,0 +1,99 @@
+#include "syntheticstation.h"
+
+#include <algorithm>
+
+namespace {
+
+// HE 80 MHz, 0.8 us GI, per spatial stream (100 kbit/s units)
+constexpr uint32_t heRates[12] = {360, 721, 1081, 1441, 2161, 2882, 3242, 3603, 4324, 4804, 5404, 6004};
+
+} // namespace
+
+SyntheticStation::SyntheticStation(uint32_t seed)
+    : m_state(seed ? seed : 1)
+{
+    m_info.valid = true;
+    m_info.signalDbm = -55;
+    m_info.signalAvgDbm = -55;
+    m_info.beaconSignalAvg = -54;
+    m_info.ackSignal = -52;
+    m_info.ackSignalAvg = -52;
+    m_info.hasAckSignal = true;
+    m_info.chainCount = 2;
+    m_info.chainSignal[0] = -56;
+    m_info.chainSignal[1] = -58;
+    m_info.chainSignalAvg[0] = -56;
+    m_info.chainSignalAvg[1] = -58;
+    m_info.rxMode = Nl80211StationInfo::WifiMode::HE;
+    m_info.txMode = Nl80211StationInfo::WifiMode::HE;
+    m_info.rxNss = 2;
+    m_info.txNss = 2;
+    m_info.rxChannelWidth = 2;
+    m_info.txChannelWidth = 2;
+    m_info.rxMcs = 9;
+    m_info.txMcs = 9;
+    m_info.expectedThroughput = 650000;
+}
+
+uint32_t SyntheticStation::random()
+{
+    // xorshift32
+    m_state ^= m_state << 13;
+    m_state ^= m_state >> 17;
+    m_state ^= m_state << 5;
+    return m_state;
+}
+
+int SyntheticStation::randomStep(int range)
+{
+    return static_cast<int>(random() % (2 * range + 1)) - range;
+}
+
+Nl80211StationInfo SyntheticStation::next(int elapsedMs)
+{
+    m_elapsedMs += elapsedMs;
+
+    auto &info = m_info;
+    // Slowly wandering mean around -55 dBm plus per-sample fading noise.
+    if (random() % 32 == 0) {
+        m_signalMean = std::clamp(m_signalMean + randomStep(1) - (m_signalMean + 55) / 8, -70, -40);
+    }
+    info.signalDbm = std::clamp(m_signalMean + randomStep(2), -90, -30);
+    info.signalAvgDbm = (info.signalAvgDbm * 7 + info.signalDbm) / 8;
+    info.beaconSignalAvg = info.signalAvgDbm + 1;
+    info.ackSignal = std::clamp(info.signalDbm + 3 + randomStep(1), -90, -30);
+    info.ackSignalAvg = (info.ackSignalAvg * 7 + info.ackSignal) / 8;
+    for (int i = 0; i < info.chainCount; ++i) {
+        info.chainSignal[i] = info.signalDbm - 1 - 2 * i + randomStep(1);
+        info.chainSignalAvg[i] = (info.chainSignalAvg[i] * 7 + info.chainSignal[i]) / 8;
+    }
+
+    // Rate control follows the signal with some flapping around the target MCS.
+    const int targetMcs = std::clamp((info.signalDbm + 85) / 4, 0, 11);
+    info.rxMcs = static_cast<uint8_t>(std::clamp(targetMcs + randomStep(1), 0, 11));
+    info.txMcs = static_cast<uint8_t>(std::clamp(targetMcs + randomStep(1), 0, 11));
+    info.rxBitrate = heRates[info.rxMcs] * info.rxNss;
+    info.txBitrate = heRates[info.txMcs] * info.txNss;
+
+    // Traffic scales with the interval so counters look the same at any rate.
+    const uint32_t rxPackets = static_cast<uint32_t>(random() % 200 + 50) * elapsedMs / 1000 + 1;
+    const uint32_t txPackets = rxPackets / 2 + 1;
+    info.rxPackets += rxPackets;
+    info.txPackets += txPackets;
+    info.rxBytes += static_cast<uint64_t>(rxPackets) * 1200;
+    info.txBytes += static_cast<uint64_t>(txPackets) * 400;
+    info.txRetries += random() % (txPackets / 10 + 1);
+    if (random() % 100 == 0) {
+        ++info.txFailed;
+    }
+    if (random() % 500 == 0) {
+        ++info.beaconLoss;
+    }
+    info.beaconRx = m_elapsedMs / 102;
+    info.rxDuration += rxPackets * 120;
+    info.txDuration += txPackets * 60;
+    info.inactiveTime = random() % 50;
+    info.connectedTime = static_cast<uint32_t>(m_elapsedMs / 1000);
+
+    return info;
+}
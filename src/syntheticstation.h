@@ -0,0 +1,30 @@
+#pragma once
+
+#include "nl80211helper.h"
+
+#include <cstdint>
+
+/**
+ * @brief Deterministic fake station for benchmarks and offline runs
+ *
+ * Produces a plausible stream of station samples (random-walk signal, rate
+ * control flapping between neighbouring MCS, monotonically growing counters)
+ * without touching the kernel. The same seed always yields the same stream.
+ */
+class SyntheticStation
+{
+public:
+    explicit SyntheticStation(uint32_t seed = 1);
+
+    // Advances the simulated link by @p elapsedMs and returns the new sample.
+    Nl80211StationInfo next(int elapsedMs);
+
+private:
+    uint32_t random();
+    int randomStep(int range);
+
+    uint32_t m_state;
+    Nl80211StationInfo m_info;
+    int32_t m_signalMean = -55;
+    uint64_t m_elapsedMs = 0;
+};
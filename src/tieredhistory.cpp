@@ -0,0 +1,151 @@
+#include "tieredhistory.h"
+
+#include <limits>
+
+namespace {
+
+constexpr int capacities[TieredHistory::tierCount] = {
+    3600, // one hour of seconds
+    1440, // one day of minutes
+    168,  // one week of hours
+};
+
+constexpr int64_t durationsMs[TieredHistory::tierCount] = {
+    1000,
+    60 * 1000,
+    60 * 60 * 1000,
+};
+
+} // namespace
+
+TieredHistory::TieredHistory()
+{
+    for (int tier = 0; tier < tierCount; ++tier) {
+        m_rings[tier].buckets.resize(capacities[tier] * metricCount);
+        m_rings[tier].timestamps.resize(capacities[tier]);
+    }
+}
+
+int TieredHistory::addSample(int64_t timestampMs, const float (&values)[metricCount], uint32_t metrics)
+{
+    int committed = 0;
+    for (int tier = 0; tier < tierCount; ++tier) {
+        Accumulator &acc = m_accumulators[tier];
+        const int64_t period = timestampMs / durationsMs[tier];
+        if (acc.count > 0 && period != acc.period) {
+            commit(tier);
+            committed |= 1 << tier;
+        }
+
+        if (acc.count == 0) {
+            acc.period = period;
+            for (int m = 0; m < metricCount; ++m) {
+                acc.samples[m] = 0;
+                acc.sum[m] = 0.0;
+            }
+        }
+        for (int m = 0; m < metricCount; ++m) {
+            if (!(metrics & (1u << m))) {
+                continue;
+            }
+            if (acc.samples[m]++ == 0) {
+                acc.min[m] = values[m];
+                acc.max[m] = values[m];
+            }
+            acc.min[m] = values[m] < acc.min[m] ? values[m] : acc.min[m];
+            acc.max[m] = values[m] > acc.max[m] ? values[m] : acc.max[m];
+            acc.sum[m] += values[m];
+            acc.last[m] = values[m];
+        }
+        ++acc.count;
+    }
+    return committed;
+}
+
+void TieredHistory::reset()
+{
+    for (int tier = 0; tier < tierCount; ++tier) {
+        m_rings[tier].head = 0;
+        m_rings[tier].size = 0;
+        m_accumulators[tier] = Accumulator{};
+    }
+}
+
+int TieredHistory::capacity(Tier tier)
+{
+    return capacities[static_cast<int>(tier)];
+}
+
+int64_t TieredHistory::bucketDurationMs(Tier tier)
+{
+    return durationsMs[static_cast<int>(tier)];
+}
+
+int TieredHistory::size(Tier tier) const
+{
+    return m_rings[static_cast<int>(tier)].size;
+}
+
+const TieredHistory::Bucket &TieredHistory::bucket(Tier tier, Metric metric, int index) const
+{
+    const int t = static_cast<int>(tier);
+    return m_rings[t].buckets[slot(t, index) * metricCount + static_cast<int>(metric)];
+}
+
+int64_t TieredHistory::timestampMs(Tier tier, int index) const
+{
+    const int t = static_cast<int>(tier);
+    return m_rings[t].timestamps[slot(t, index)];
+}
+
+const char *TieredHistory::tierName(Tier tier)
+{
+    switch (tier) {
+        case Tier::Seconds: return "seconds";
+        case Tier::Minutes: return "minutes";
+        case Tier::Hours:   return "hours";
+    }
+    return "unknown";
+}
+
+const char *TieredHistory::metricName(Metric metric)
+{
+    switch (metric) {
+        case Metric::RxRate: return "rxRate";
+        case Metric::TxRate: return "txRate";
+        case Metric::Signal: return "signal";
+    }
+    return "unknown";
+}
+
+void TieredHistory::commit(int tier)
+{
+    Ring &ring = m_rings[tier];
+    Accumulator &acc = m_accumulators[tier];
+
+    Bucket *out = &ring.buckets[ring.head * metricCount];
+    for (int m = 0; m < metricCount; ++m) {
+        if (acc.samples[m] == 0) {
+            constexpr float missing = std::numeric_limits<float>::quiet_NaN();
+            out[m] = Bucket{missing, missing, missing, missing};
+            continue;
+        }
+        out[m].min = acc.min[m];
+        out[m].max = acc.max[m];
+        out[m].mean = static_cast<float>(acc.sum[m] / acc.samples[m]);
+        out[m].last = acc.last[m];
+    }
+    ring.timestamps[ring.head] = acc.period * durationsMs[tier];
+
+    const int cap = capacities[tier];
+    ring.head = (ring.head + 1) % cap;
+    ring.size = ring.size < cap ? ring.size + 1 : cap;
+    acc.count = 0;
+}
+
+int TieredHistory::slot(int tier, int index) const
+{
+    const Ring &ring = m_rings[tier];
+    const int cap = capacities[tier];
+    return (ring.head - ring.size + index + cap) % cap;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QVector>
+
+#include <cstdint>
+
+/**
+ * @brief Multi-resolution history: per-second, per-minute and per-hour buckets
+ *
+ * Every sample updates one accumulator per tier. When a sample falls into a
+ * new second, minute or hour, the finished accumulator is committed as a
+ * bucket (min, max, mean and last value per metric) into that tier's ring.
+ * The rings are allocated once, so memory stays fixed at roughly 300 KB for
+ * an hour of seconds, a day of minutes and a week of hours. Periods without
+ * samples (disconnected, screen locked) take no space. A sample may carry
+ * only some metrics, e.g. the signal from /proc/net/wireless; a metric
+ * with no sample in a bucket's period is committed as NaN.
+ */
+class TieredHistory
+{
+public:
+    enum class Tier : uint8_t {
+        Seconds = 0,
+        Minutes,
+        Hours,
+    };
+    static constexpr int tierCount = 3;
+
+    enum class Metric : uint8_t {
+        RxRate = 0, // Mbps
+        TxRate,     // Mbps
+        Signal,     // dBm
+    };
+    static constexpr int metricCount = 3;
+    static constexpr uint32_t allMetrics = (1u << metricCount) - 1;
+
+    struct Bucket {
+        float min = 0.0f;
+        float max = 0.0f;
+        float mean = 0.0f;
+        float last = 0.0f;
+    };
+
+    TieredHistory();
+
+    // Feeds one sample. Only the metrics in @p metrics (bits 1 << Metric) are
+    // read from @p values. Returns a bit mask (1 << tier) of the tiers that
+    // committed a bucket.
+    int addSample(int64_t timestampMs, const float (&values)[metricCount], uint32_t metrics = allMetrics);
+    void reset();
+
+    static int capacity(Tier tier);
+    static int64_t bucketDurationMs(Tier tier);
+
+    // Committed buckets, index 0 being the oldest.
+    [[nodiscard]] int size(Tier tier) const;
+    [[nodiscard]] const Bucket &bucket(Tier tier, Metric metric, int index) const;
+    // Start of the bucket's period, ms since the epoch.
+    [[nodiscard]] int64_t timestampMs(Tier tier, int index) const;
+
+    static const char *tierName(Tier tier);
+    static const char *metricName(Metric metric);
+
+private:
+    struct Accumulator {
+        int64_t period = -1;
+        int count = 0;
+        int samples[metricCount] = {};
+        float min[metricCount] = {};
+        float max[metricCount] = {};
+        double sum[metricCount] = {};
+        float last[metricCount] = {};
+    };
+
+    struct Ring {
+        QVector<Bucket> buckets;    // capacity * metricCount, metric-major per slot
+        QVector<int64_t> timestamps;
+        int head = 0;               // next slot to write
+        int size = 0;
+    };
+
+    void commit(int tier);
+    [[nodiscard]] int slot(int tier, int index) const;
+
+    Ring m_rings[tierCount];
+    Accumulator m_accumulators[tierCount];
+};
@@ -0,0 +1,213 @@
+#include "tracer.h"
+
+#include <QFile>
+#include <QtGlobal>
+
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace Tracer {
+
+namespace detail {
+std::atomic<bool> enabled{false};
+}
+
+namespace {
+
+struct Span {
+    uint64_t startNs;
+    uint64_t durationNs;
+    const char *name;
+    const char *category;
+};
+
+struct Ring {
+    Span spans[ringCapacity];
+    std::atomic<uint64_t> head{0}; // written by the owning thread
+    std::atomic<uint64_t> tail{0}; // written by the flusher
+    long tid = 0;
+    char threadName[16] = {};
+    bool named = false;            // flusher: thread_name metadata written
+};
+
+// Rings outlive their threads: a thread that exits between two flushes
+// still has its last spans written, and tids aren't reused within a trace.
+std::mutex s_registryMutex;
+std::vector<std::unique_ptr<Ring>> s_rings;
+thread_local Ring *t_ring = nullptr;
+
+std::atomic<uint64_t> s_dropped{0};
+
+// Owned by start()/stop(); between them only the flusher touches the file.
+std::mutex s_controlMutex;
+std::condition_variable s_wake;
+bool s_stopping = false;
+std::thread s_flusher;
+std::unique_ptr<QFile> s_file;
+QString s_path;
+bool s_firstEvent = true;
+
+Ring *ring()
+{
+    if (!t_ring) {
+        auto ring = std::make_unique<Ring>();
+        ring->tid = syscall(SYS_gettid);
+        pthread_getname_np(pthread_self(), ring->threadName, sizeof(ring->threadName));
+        t_ring = ring.get();
+        const std::lock_guard lock(s_registryMutex);
+        s_rings.push_back(std::move(ring));
+    }
+    return t_ring;
+}
+
+void appendEvent(QByteArray &out, const char *event)
+{
+    out.append(s_firstEvent ? "\n" : ",\n");
+    out.append(event);
+    s_firstEvent = false;
+}
+
+void drain()
+{
+    QByteArray out;
+    char event[256];
+    const int pid = getpid();
+
+    const std::lock_guard lock(s_registryMutex);
+    for (const auto &ring : s_rings) {
+        const uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+        const uint64_t head = ring->head.load(std::memory_order_acquire);
+        if (tail == head) {
+            continue;
+        }
+        if (!ring->named) {
+            ring->named = true;
+            std::snprintf(event, sizeof(event),
+                          "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%ld,\"args\":{\"name\":\"%s\"}}",
+                          pid, ring->tid, ring->threadName);
+            appendEvent(out, event);
+        }
+        for (uint64_t i = tail; i < head; ++i) {
+            const Span &span = ring->spans[i % ringCapacity];
+            std::snprintf(event, sizeof(event),
+                          "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%ld}",
+                          span.name, span.category, span.startNs / 1000.0, span.durationNs / 1000.0, pid, ring->tid);
+            appendEvent(out, event);
+        }
+        ring->tail.store(head, std::memory_order_release);
+    }
+    if (!out.isEmpty()) {
+        s_file->write(out);
+        s_file->flush();
+    }
+}
+
+void flushLoop()
+{
+    std::unique_lock lock(s_controlMutex);
+    while (!s_stopping) {
+        s_wake.wait_for(lock, std::chrono::milliseconds(flushIntervalMs));
+        drain();
+    }
+}
+
+} // namespace
+
+bool start(const QString &path, QString *error)
+{
+    const std::lock_guard lock(s_controlMutex);
+    if (s_flusher.joinable()) {
+        if (error) {
+            *error = QStringLiteral("A trace is already being written to %1").arg(s_path);
+        }
+        return false;
+    }
+    auto file = std::make_unique<QFile>(path);
+    if (!file->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (error) {
+            *error = file->errorString();
+        }
+        return false;
+    }
+    file->write("[");
+    s_file = std::move(file);
+    s_path = path;
+    s_firstEvent = true;
+    s_stopping = false;
+    // Spans recorded before a previous stop() belong to that trace.
+    {
+        const std::lock_guard registryLock(s_registryMutex);
+        for (const auto &ring : s_rings) {
+            ring->tail.store(ring->head.load(std::memory_order_acquire), std::memory_order_release);
+            ring->named = false;
+        }
+    }
+    s_flusher = std::thread(flushLoop);
+    detail::enabled.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+void stop()
+{
+    std::unique_lock lock(s_controlMutex);
+    if (!s_flusher.joinable()) {
+        return;
+    }
+    detail::enabled.store(false, std::memory_order_relaxed);
+    s_stopping = true;
+    lock.unlock();
+    s_wake.notify_one();
+    s_flusher.join();
+
+    lock.lock();
+    // A span that began before tracing went off may still land after this
+    // drain; the next start() discards it.
+    drain();
+    s_file->write("\n]\n");
+    s_file.reset();
+}
+
+QString path()
+{
+    const std::lock_guard lock(s_controlMutex);
+    return s_flusher.joinable() ? s_path : QString();
+}
+
+uint64_t dropped()
+{
+    return s_dropped.load(std::memory_order_relaxed);
+}
+
+QString environmentPath()
+{
+    const QString value = qEnvironmentVariable("TRUELINK_TRACE");
+    if (value.isEmpty() || value == QLatin1String("0")) {
+        return QString();
+    }
+    if (value == QLatin1String("1")) {
+        return QStringLiteral("/tmp/truelink-trace-%1.json").arg(getpid());
+    }
+    return value;
+}
+
+void complete(const char *name, const char *category, uint64_t startNs, uint64_t durationNs)
+{
+    Ring *r = ring();
+    const uint64_t head = r->head.load(std::memory_order_relaxed);
+    if (head - r->tail.load(std::memory_order_acquire) >= ringCapacity) {
+        s_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    r->spans[head % ringCapacity] = Span{startNs, durationNs, name, category};
+    r->head.store(head + 1, std::memory_order_release);
+}
+
+} // namespace Tracer
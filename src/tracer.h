@@ -0,0 +1,86 @@
+#pragma once
+
+#include "profiler.h"
+
+#include <QString>
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Optional Chrome trace-event output of the monitor's own spans
+ *
+ * For lining up the plugin's work with plasmashell's rendering in
+ * chrome://tracing or ui.perfetto.dev. Each thread records into its own
+ * fixed ring (single producer, single consumer), so recording is two clock
+ * reads and a 32-byte copy with no lock and no allocation after the
+ * thread's first span. A background thread drains the rings a few times a
+ * second and appends the spans to the file as complete ("X") events in the
+ * JSON array format, which the viewers accept even before stop() closes the
+ * array. A span that finds its ring full is dropped and counted.
+ *
+ * While tracing is off a span costs one relaxed atomic load.
+ */
+namespace Tracer {
+
+inline constexpr int ringCapacity = 2048; // spans per thread
+inline constexpr int flushIntervalMs = 250;
+
+namespace detail {
+extern std::atomic<bool> enabled;
+}
+
+[[nodiscard]] inline bool isEnabled()
+{
+    return detail::enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Starts writing to @p path, replacing the file. Returns false and sets
+ * @p error if it can't be opened or tracing already runs.
+ */
+bool start(const QString &path, QString *error);
+// Writes what the rings still hold, closes the JSON array and the file.
+void stop();
+[[nodiscard]] QString path();
+[[nodiscard]] uint64_t dropped();
+
+// TRUELINK_TRACE: empty if unset, otherwise a file path ("1" picks one in /tmp).
+[[nodiscard]] QString environmentPath();
+
+/**
+ * Records a span that began at @p startNs (Profiler::nowNs() clock).
+ * @p name and @p category must be string literals; only the pointers are kept.
+ */
+void complete(const char *name, const char *category, uint64_t startNs, uint64_t durationNs);
+
+/**
+ * Records the lifetime of the scope as a span if tracing was on when it began.
+ */
+class Scope
+{
+public:
+    Scope(const char *name, const char *category)
+        : m_name(name)
+        , m_category(category)
+        , m_start(isEnabled() ? Profiler::nowNs() : 0)
+    {
+    }
+
+    ~Scope()
+    {
+        if (m_start != 0) {
+            complete(m_name, m_category, m_start, Profiler::nowNs() - m_start);
+        }
+    }
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+private:
+    const char *m_name;
+    const char *m_category;
+    uint64_t m_start;
+};
+
+} // namespace Tracer
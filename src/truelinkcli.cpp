@@ -0,0 +1,729 @@
+#include "nl80211helper.h"
+#include "profiler.h"
+#include "samplecodec.h"
+#include "stationtable.h"
+#include "statsbackend.h"
+#include "statsengine.h"
+#include "syntheticstation.h"
+#include "tracer.h"
+#include "wiphycapabilities.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
+
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+constexpr int minIntervalMs = 10;
+constexpr int defaultIntervalMs = 1000;
+
+// Binary stream layout (little-endian): a 8-byte header ("TLNK", u16 version,
+// u16 record size) followed by fixed-size records, see writeBinaryRecord().
+constexpr char binaryMagic[4] = {'T', 'L', 'N', 'K'};
+constexpr quint16 binaryVersion = 1;
+constexpr quint16 binaryRecordSize = 96;
+
+// Compact stream: "TLNC", u16 version, then SampleCodec records back to back.
+constexpr char compactMagic[4] = {'T', 'L', 'N', 'C'};
+constexpr quint16 compactVersion = 3; // 2: guard interval and DCM fields, 3: MLO links
+
+std::atomic_bool stopRequested{false};
+
+void requestStop(int)
+{
+    stopRequested.store(true, std::memory_order_relaxed);
+}
+
+QString findWirelessInterface()
+{
+    const QDir netDir(QStringLiteral("/sys/class/net"));
+    const QStringList interfaces = netDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+    for (const QString &iface : interfaces) {
+        if (QFileInfo::exists(netDir.filePath(iface + QStringLiteral("/wireless")))) {
+            return iface;
+        }
+    }
+    return {};
+}
+
+QJsonObject sampleToJson(qint64 timestampNs, const Nl80211StationInfo &info, const StatsEngine &engine, const QString &error)
+{
+    QJsonObject obj;
+    obj[QStringLiteral("t")] = timestampNs / 1000; // microseconds since start
+    obj[QStringLiteral("valid")] = info.valid;
+    if (!info.valid) {
+        obj[QStringLiteral("error")] = error;
+        return obj;
+    }
+
+    obj[QStringLiteral("signal")] = info.signalDbm;
+    obj[QStringLiteral("signalAvg")] = info.signalAvgDbm;
+    obj[QStringLiteral("signalFiltered")] = engine.filteredSignalDbm();
+    QJsonArray chains;
+    for (int i = 0; i < info.chainCount; ++i) {
+        chains.append(StatsEngine::chainSignalDbm(info, i));
+    }
+    obj[QStringLiteral("chains")] = chains;
+
+    obj[QStringLiteral("rxRate")] = info.rxBitrate / 10.0;
+    obj[QStringLiteral("txRate")] = info.txBitrate / 10.0;
+    obj[QStringLiteral("rxRateSmoothed")] = engine.smoothedRxRate();
+    obj[QStringLiteral("txRateSmoothed")] = engine.smoothedTxRate();
+    obj[QStringLiteral("rxMode")] = QLatin1String(Nl80211Helper::wifiModeToString(info.rxMode));
+    obj[QStringLiteral("txMode")] = QLatin1String(Nl80211Helper::wifiModeToString(info.txMode));
+    obj[QStringLiteral("rxMcs")] = info.rxMcs;
+    obj[QStringLiteral("txMcs")] = info.txMcs;
+    obj[QStringLiteral("rxNss")] = info.rxNss;
+    obj[QStringLiteral("txNss")] = info.txNss;
+    obj[QStringLiteral("rxWidth")] = Nl80211Helper::channelWidthToMhz(info.rxChannelWidth);
+    obj[QStringLiteral("txWidth")] = Nl80211Helper::channelWidthToMhz(info.txChannelWidth);
+    obj[QStringLiteral("rxGi")] = QLatin1String(Nl80211Helper::guardIntervalToString(info.rxGuardInterval));
+    obj[QStringLiteral("txGi")] = QLatin1String(Nl80211Helper::guardIntervalToString(info.txGuardInterval));
+    obj[QStringLiteral("rxDcm")] = info.rxDcm;
+    obj[QStringLiteral("txDcm")] = info.txDcm;
+    obj[QStringLiteral("rxMaxRate")] = engine.rxMaxRate() / 10.0;
+    obj[QStringLiteral("txMaxRate")] = engine.txMaxRate() / 10.0;
+    obj[QStringLiteral("rxEfficiency")] = engine.rxEfficiency();
+    obj[QStringLiteral("txEfficiency")] = engine.txEfficiency();
+    obj[QStringLiteral("belowCapability")] = engine.belowCapability();
+
+    obj[QStringLiteral("rxBytes")] = static_cast<qint64>(info.rxBytes);
+    obj[QStringLiteral("txBytes")] = static_cast<qint64>(info.txBytes);
+    obj[QStringLiteral("rxPackets")] = static_cast<qint64>(info.rxPackets);
+    obj[QStringLiteral("txPackets")] = static_cast<qint64>(info.txPackets);
+    obj[QStringLiteral("txRetries")] = static_cast<qint64>(info.txRetries);
+    obj[QStringLiteral("txFailed")] = static_cast<qint64>(info.txFailed);
+    obj[QStringLiteral("rxDropped")] = static_cast<qint64>(info.rxDropMisc);
+    obj[QStringLiteral("beaconLoss")] = static_cast<qint64>(info.beaconLoss);
+    obj[QStringLiteral("beaconRx")] = static_cast<qint64>(info.beaconRx);
+    obj[QStringLiteral("beaconSignalAvg")] = info.beaconSignalAvg;
+    obj[QStringLiteral("fcsErrors")] = static_cast<qint64>(info.fcsErrorCount);
+    obj[QStringLiteral("connectedTime")] = static_cast<qint64>(info.connectedTime);
+    obj[QStringLiteral("inactiveTime")] = static_cast<qint64>(info.inactiveTime);
+    obj[QStringLiteral("expectedThroughput")] = static_cast<qint64>(info.expectedThroughput);
+    if (info.hasAckSignal) {
+        obj[QStringLiteral("ackSignal")] = info.ackSignal;
+        obj[QStringLiteral("ackSignalAvg")] = info.ackSignalAvg;
+    }
+    obj[QStringLiteral("rxDuration")] = static_cast<qint64>(info.rxDuration);
+    obj[QStringLiteral("txDuration")] = static_cast<qint64>(info.txDuration);
+
+    if (info.linkCount > 0) {
+        QJsonArray links;
+        for (int i = 0; i < info.linkCount; ++i) {
+            const Nl80211StationInfo::Link &link = info.links[i];
+            QJsonObject linkObj;
+            linkObj[QStringLiteral("id")] = link.linkId;
+            linkObj[QStringLiteral("bssid")] = StationTable::macToString(StationTable::packMac(link.address));
+            linkObj[QStringLiteral("freq")] = static_cast<qint64>(link.frequencyMhz);
+            linkObj[QStringLiteral("signal")] = link.signalDbm;
+            linkObj[QStringLiteral("rxRate")] = link.rxBitrate / 10.0;
+            linkObj[QStringLiteral("txRate")] = link.txBitrate / 10.0;
+            linkObj[QStringLiteral("rxMode")] = QLatin1String(Nl80211Helper::wifiModeToString(link.rxMode));
+            linkObj[QStringLiteral("rxMcs")] = link.rxMcs;
+            linkObj[QStringLiteral("rxNss")] = link.rxNss;
+            linkObj[QStringLiteral("rxWidth")] = Nl80211Helper::channelWidthToMhz(link.rxChannelWidth);
+            linkObj[QStringLiteral("rxBytes")] = static_cast<qint64>(link.rxBytes);
+            linkObj[QStringLiteral("txBytes")] = static_cast<qint64>(link.txBytes);
+            linkObj[QStringLiteral("txRetries")] = static_cast<qint64>(link.txRetries);
+            linkObj[QStringLiteral("txFailed")] = static_cast<qint64>(link.txFailed);
+            links.append(linkObj);
+        }
+        obj[QStringLiteral("links")] = links;
+    }
+
+    if (engine.lastEventCount() > 0) {
+        QJsonArray events;
+        for (int i = 0; i < engine.lastEventCount(); ++i) {
+            const LinkDetector::Event &event = engine.lastEvent(i);
+            QJsonObject eventObj;
+            eventObj[QStringLiteral("metric")] = QLatin1String(LinkDetector::metricName(event.metric));
+            eventObj[QStringLiteral("degraded")] = event.kind == LinkDetector::EventKind::Degraded;
+            eventObj[QStringLiteral("value")] = event.value;
+            eventObj[QStringLiteral("baseline")] = event.baseline;
+            events.append(eventObj);
+        }
+        obj[QStringLiteral("events")] = events;
+    }
+    return obj;
+}
+
+void writeBinaryHeader(QDataStream &out)
+{
+    out.writeRawData(binaryMagic, sizeof(binaryMagic));
+    out << binaryVersion << binaryRecordSize;
+}
+
+// 96 bytes per record; keep binaryRecordSize in sync when adding fields.
+void writeBinaryRecord(QDataStream &out, qint64 timestampNs, const Nl80211StationInfo &info)
+{
+    out << static_cast<quint64>(timestampNs);                                     // 8
+    out << static_cast<quint8>(info.valid) << static_cast<quint8>(info.chainCount)  // 2
+        << static_cast<quint8>(info.rxMode) << static_cast<quint8>(info.txMode);    // 2
+    out << static_cast<qint8>(info.signalDbm) << static_cast<qint8>(info.signalAvgDbm)
+        << static_cast<qint8>(info.beaconSignalAvg) << static_cast<qint8>(info.ackSignal); // 4
+    for (int i = 0; i < Nl80211StationInfo::maxChains; ++i) {
+        out << static_cast<qint8>(StatsEngine::chainSignalDbm(info, i));         // 4
+    }
+    out << info.rxMcs << info.txMcs << info.rxNss << info.txNss                   // 4
+        << info.rxChannelWidth << info.txChannelWidth                             // 2
+        << static_cast<quint8>(info.hasAckSignal) << static_cast<quint8>(0);       // 2
+    out << info.rxBitrate << info.txBitrate;                                      // 8
+    out << static_cast<quint64>(info.rxBytes) << static_cast<quint64>(info.txBytes); // 16
+    out << info.rxPackets << info.txPackets << info.txRetries << info.txFailed     // 16
+        << info.rxDropMisc << info.beaconLoss << info.fcsErrorCount               // 12
+        << info.connectedTime << info.expectedThroughput;                          // 8
+    out << static_cast<quint64>(info.beaconRx);                                   // 8
+}
+
+// Encodes a synthetic 1 Hz stream, decodes it back and reports size and
+// throughput. Correctness is covered by the codec autotest.
+int benchCodec(qint64 samples)
+{
+    SyntheticStation station;
+    std::vector<Nl80211StationInfo> input;
+    input.reserve(static_cast<size_t>(samples));
+    for (qint64 i = 0; i < samples; ++i) {
+        input.push_back(station.next(1000));
+    }
+
+    std::vector<uint8_t> encoded(static_cast<size_t>(samples) * SampleCodec::maxRecordSize);
+    SampleCodec::Encoder encoder;
+
+    QElapsedTimer timer;
+    timer.start();
+    size_t encodedSize = 0;
+    for (qint64 i = 0; i < samples; ++i) {
+        encodedSize += encoder.encode(static_cast<uint64_t>(i) * 1000000, input[i], encoded.data() + encodedSize);
+    }
+    const qint64 encodeNs = timer.nsecsElapsed();
+
+    SampleCodec::Decoder decoder;
+    std::vector<Nl80211StationInfo> output(static_cast<size_t>(samples));
+    timer.restart();
+    size_t offset = 0;
+    for (qint64 i = 0; i < samples; ++i) {
+        uint64_t timestampUs = 0;
+        const size_t used = decoder.decode(encoded.data() + offset, encodedSize - offset, timestampUs, output[i]);
+        if (used == 0) {
+            std::fprintf(stderr, "decode failed at sample %lld\n", static_cast<long long>(i));
+            return 1;
+        }
+        offset += used;
+    }
+    const qint64 decodeNs = timer.nsecsElapsed();
+
+    std::fprintf(stderr,
+                 "samples: %lld  raw: %zu bytes/sample  encoded: %.1f bytes/sample\n"
+                 "encode: %.2f Msamples/s  decode: %.2f Msamples/s\n",
+                 static_cast<long long>(samples),
+                 sizeof(Nl80211StationInfo),
+                 static_cast<double>(encodedSize) / samples,
+                 samples * 1000.0 / qMax<qint64>(encodeNs, 1),
+                 samples * 1000.0 / qMax<qint64>(decodeNs, 1));
+    return 0;
+}
+
+QJsonObject stationsToJson(qint64 timestampNs, const StationTable &table)
+{
+    QJsonArray stations;
+    for (int i = 0; i < table.size(); ++i) {
+        const StationTable::Entry &entry = table.at(i);
+        const Nl80211StationInfo &info = entry.info;
+        QJsonObject station;
+        station[QStringLiteral("mac")] = StationTable::macToString(entry.key);
+        station[QStringLiteral("signal")] = info.signalDbm;
+        station[QStringLiteral("rxRate")] = info.rxBitrate / 10.0;
+        station[QStringLiteral("txRate")] = info.txBitrate / 10.0;
+        station[QStringLiteral("rxMode")] = QLatin1String(Nl80211Helper::wifiModeToString(info.rxMode));
+        station[QStringLiteral("rxMcs")] = info.rxMcs;
+        station[QStringLiteral("rxNss")] = info.rxNss;
+        station[QStringLiteral("rxBytes")] = static_cast<qint64>(info.rxBytes);
+        station[QStringLiteral("txBytes")] = static_cast<qint64>(info.txBytes);
+        station[QStringLiteral("inactiveMs")] = static_cast<qint64>(info.inactiveTime);
+        stations.append(station);
+    }
+
+    QJsonObject obj;
+    obj[QStringLiteral("t")] = timestampNs / 1000;
+    obj[QStringLiteral("stations")] = stations;
+    return obj;
+}
+
+// Refreshes a table of @p stations synthetic peers per tick, with a few
+// joining and leaving each time, and reports the per-tick cost.
+int benchStations(int stations)
+{
+    constexpr int ticks = 10000;
+    constexpr int churnPercent = 5;
+
+    StationTable table;
+    std::vector<uint64_t> population(static_cast<size_t>(stations) * 2);
+    for (size_t i = 0; i < population.size(); ++i) {
+        population[i] = 0x02005e000000ULL | (i * 2654435761ULL & 0xffffff);
+    }
+
+    uint64_t rng = 0x2545F4914F6CDD1DULL;
+    const auto next = [&rng]() {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        return rng;
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+    qint64 upserts = 0;
+    qint64 evictions = 0;
+    for (int tick = 0; tick < ticks; ++tick) {
+        // Swap a few members of the active window for idle ones.
+        for (int c = 0; c < stations * churnPercent / 100; ++c) {
+            std::swap(population[next() % stations], population[stations + next() % stations]);
+        }
+        table.beginUpdate();
+        for (int i = 0; i < stations; ++i) {
+            uint8_t mac[6];
+            for (int b = 0; b < 6; ++b) {
+                mac[b] = static_cast<uint8_t>(population[i] >> (8 * (5 - b)));
+            }
+            Nl80211StationInfo &info = table.upsert(mac);
+            info.valid = true;
+            info.signalDbm = -40 - static_cast<int32_t>(next() % 50);
+        }
+        evictions += table.endUpdate();
+        upserts += stations;
+    }
+    const qint64 elapsedNs = timer.nsecsElapsed();
+
+    if (table.size() != stations) {
+        std::fprintf(stderr, "table holds %d stations, expected %d\n", table.size(), stations);
+        return 1;
+    }
+    std::fprintf(stderr,
+                 "stations: %d  ticks: %d  evicted: %lld\n"
+                 "per tick: %.1f us  per station: %.1f ns\n",
+                 stations,
+                 ticks,
+                 static_cast<long long>(evictions),
+                 elapsedNs / 1000.0 / ticks,
+                 static_cast<double>(elapsedNs) / qMax<qint64>(upserts, 1));
+    return 0;
+}
+
+QByteArray fieldNames(uint32_t fields)
+{
+    static constexpr struct {
+        StatsBackend::Field field;
+        const char *name;
+    } names[] = {
+        {StatsBackend::Signal, "signal"},
+        {StatsBackend::Counters, "counters"},
+        {StatsBackend::Rates, "rates"},
+        {StatsBackend::Extended, "extended"},
+    };
+    QByteArray list;
+    for (const auto &entry : names) {
+        if (fields & entry.field) {
+            list += (list.isEmpty() ? "" : ",") + QByteArray(entry.name);
+        }
+    }
+    return list;
+}
+
+// Per-sample cost of every backend against the same interface, back to back.
+int benchBackends(const QByteArray &ifname, const uint8_t *bssid, int samples)
+{
+    Nl80211Helper nl80211;
+    const bool haveNl80211 = nl80211.init();
+    ProcWirelessBackend proc;
+    SysfsBackend sysfs;
+    Nl80211Backend nl80211Backend(nl80211);
+    StatsBackend *const backends[] = {&proc, &sysfs, &nl80211Backend};
+
+    std::fprintf(stderr, "interface: %s  samples: %d\n", ifname.constData(), samples);
+    std::fprintf(stderr, "%-8s %-28s %8s %10s %10s %10s\n", "backend", "fields", "failures", "mean(us)", "p50(us)", "p99(us)");
+
+    std::vector<qint64> latenciesNs;
+    latenciesNs.reserve(static_cast<size_t>(samples));
+    for (StatsBackend *backend : backends) {
+        if (backend == &nl80211Backend && !haveNl80211) {
+            std::fprintf(stderr, "%-8s unavailable: %s\n", backend->name(), qPrintable(nl80211.lastError()));
+            continue;
+        }
+
+        // Warm-up: opens descriptors and faults in the code paths.
+        (void)backend->sample(ifname.constData(), bssid);
+
+        latenciesNs.clear();
+        int failures = 0;
+        QElapsedTimer timer;
+        for (int i = 0; i < samples; ++i) {
+            timer.start();
+            const Nl80211StationInfo info = backend->sample(ifname.constData(), bssid);
+            latenciesNs.push_back(timer.nsecsElapsed());
+            failures += info.valid ? 0 : 1;
+        }
+        std::sort(latenciesNs.begin(), latenciesNs.end());
+        double sum = 0.0;
+        for (qint64 v : latenciesNs) {
+            sum += v;
+        }
+        std::fprintf(stderr, "%-8s %-28s %8d %10.2f %10.2f %10.2f\n",
+                     backend->name(),
+                     fieldNames(backend->fields()).constData(),
+                     failures,
+                     sum / samples / 1000.0,
+                     latenciesNs[latenciesNs.size() / 2] / 1000.0,
+                     latenciesNs[std::min(latenciesNs.size() - 1, latenciesNs.size() * 99 / 100)] / 1000.0);
+        if (failures > 0) {
+            std::fprintf(stderr, "         last error: %s\n", qPrintable(backend->lastError()));
+        }
+    }
+    return 0;
+}
+
+void printLatencySummary(std::vector<qint64> &latenciesNs, int failures)
+{
+    if (latenciesNs.empty()) {
+        std::fprintf(stderr, "no samples taken\n");
+        return;
+    }
+    std::sort(latenciesNs.begin(), latenciesNs.end());
+    const auto percentile = [&latenciesNs](double p) {
+        const size_t index = std::min(latenciesNs.size() - 1, static_cast<size_t>(p * latenciesNs.size()));
+        return latenciesNs[index] / 1000.0;
+    };
+    double sum = 0.0;
+    for (qint64 v : latenciesNs) {
+        sum += v;
+    }
+    std::fprintf(stderr,
+                 "samples: %zu  failures: %d\n"
+                 "sample latency (us): min %.1f  mean %.1f  p50 %.1f  p99 %.1f  max %.1f\n",
+                 latenciesNs.size(),
+                 failures,
+                 latenciesNs.front() / 1000.0,
+                 sum / latenciesNs.size() / 1000.0,
+                 percentile(0.50),
+                 percentile(0.99),
+                 latenciesNs.back() / 1000.0);
+}
+
+QJsonObject wiphyToJson(const WiphyCapabilities &caps)
+{
+    QJsonObject obj;
+    obj[QStringLiteral("wiphy")] = caps.wiphyIndex;
+    obj[QStringLiteral("name")] = caps.name;
+    QJsonArray bands;
+    for (int i = 0; i < WiphyBand::count; ++i) {
+        const WiphyBand &band = caps.bands[i];
+        if (!band.present) {
+            continue;
+        }
+        QJsonObject bandObj;
+        bandObj[QStringLiteral("band")] = QLatin1String(WiphyCapabilities::bandName(static_cast<WiphyBand::Id>(i)));
+        bandObj[QStringLiteral("mode")] = QLatin1String(Nl80211Helper::wifiModeToString(band.bestMode()));
+        bandObj[QStringLiteral("maxNss")] = band.maxNss;
+        bandObj[QStringLiteral("maxWidth")] = band.maxWidthMhz;
+        QJsonArray channels;
+        for (uint32_t mhz : band.frequencies) {
+            channels.append(Nl80211Helper::frequencyToChannel(mhz));
+        }
+        bandObj[QStringLiteral("channels")] = channels;
+        bands.append(bandObj);
+    }
+    obj[QStringLiteral("bands")] = bands;
+    return obj;
+}
+
+void printProfile()
+{
+    std::fprintf(stderr, "%-10s %8s %10s %10s %10s %10s\n", "stage", "count", "mean(us)", "p50(us)", "p99(us)", "max(us)");
+    for (int i = 0; i < Profiler::stageCount; ++i) {
+        const auto stage = static_cast<Profiler::Stage>(i);
+        const Profiler::Histogram h = Profiler::histogram(stage);
+        if (h.count == 0) {
+            continue;
+        }
+        std::fprintf(stderr, "%-10s %8llu %10.1f %10.1f %10.1f %10.1f\n",
+                     Profiler::stageName(stage),
+                     static_cast<unsigned long long>(h.count),
+                     h.meanNs() / 1000.0,
+                     h.percentileNs(0.5) / 1000.0,
+                     h.percentileNs(0.99) / 1000.0,
+                     h.maxNs / 1000.0);
+    }
+    for (int i = 0; i < Profiler::counterCount; ++i) {
+        const auto counter = static_cast<Profiler::Counter>(i);
+        std::fprintf(stderr, "%s: %llu\n", Profiler::counterName(counter),
+                     static_cast<unsigned long long>(Profiler::counter(counter)));
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("truelink-cli"));
+    QCoreApplication::setApplicationVersion(QStringLiteral(PROJECT_VERSION));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Headless nl80211 station sampler for TrueLink Monitor"));
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    const QCommandLineOption interfaceOption({QStringLiteral("i"), QStringLiteral("interface")},
+                                             QStringLiteral("Wireless interface to sample (default: first wireless interface)."),
+                                             QStringLiteral("ifname"));
+    const QCommandLineOption bssidOption({QStringLiteral("b"), QStringLiteral("bssid")},
+                                         QStringLiteral("Station MAC address to query (default: dump the interface's stations)."),
+                                         QStringLiteral("mac"));
+    const QCommandLineOption intervalOption({QStringLiteral("r"), QStringLiteral("interval")},
+                                            QStringLiteral("Sampling interval in milliseconds (minimum %1).").arg(minIntervalMs),
+                                            QStringLiteral("ms"),
+                                            QString::number(defaultIntervalMs));
+    const QCommandLineOption countOption({QStringLiteral("n"), QStringLiteral("count")},
+                                         QStringLiteral("Stop after this many samples (0 = run until interrupted)."),
+                                         QStringLiteral("samples"),
+                                         QStringLiteral("0"));
+    const QCommandLineOption formatOption({QStringLiteral("f"), QStringLiteral("format")},
+                                          QStringLiteral("Output format: json (one object per line), binary or compact."),
+                                          QStringLiteral("format"),
+                                          QStringLiteral("json"));
+    const QCommandLineOption benchOption(QStringLiteral("bench"),
+                                         QStringLiteral("Discard samples and print a sampling latency summary on exit."));
+    const QCommandLineOption benchCodecOption(QStringLiteral("bench-codec"),
+                                              QStringLiteral("Time encoding and decoding --count synthetic samples (default 100000) with the compact codec and exit."));
+    const QCommandLineOption profileOption(QStringLiteral("profile"),
+                                           QStringLiteral("Print per-stage timing histograms and error counters on exit."));
+    const QCommandLineOption stationsOption(QStringLiteral("stations"),
+                                            QStringLiteral("Dump all stations of an AP/mesh/P2P-GO interface per sample (JSON only)."));
+    const QCommandLineOption benchStationsOption(QStringLiteral("bench-stations"),
+                                                 QStringLiteral("Refresh a table of --count synthetic stations (default 500) and exit."));
+    const QCommandLineOption benchBackendsOption(QStringLiteral("bench-backends"),
+                                                 QStringLiteral("Time --count samples (default 2000) from each stats backend (nl80211, proc, sysfs) and exit."));
+    const QCommandLineOption signalFilterOption(QStringLiteral("signal-filter"),
+                                                QStringLiteral("Signal filter pipeline, e.g. median:3,ewma:0.5,hysteresis:2 (default: %1).").arg(QLatin1String(StatsEngine::defaultSignalFilter)),
+                                                QStringLiteral("spec"));
+    const QCommandLineOption rateFilterOption(QStringLiteral("rate-filter"),
+                                              QStringLiteral("PHY rate filter pipeline for the smoothed rates (default: %1).").arg(QLatin1String(StatsEngine::defaultRateFilter)),
+                                              QStringLiteral("spec"));
+    const QCommandLineOption wiphyOption(QStringLiteral("wiphy"),
+                                         QStringLiteral("Print the radio capabilities of the interface as JSON and exit."));
+    parser.addOptions({interfaceOption, bssidOption, intervalOption, countOption, formatOption, benchOption, benchCodecOption, profileOption, wiphyOption, stationsOption, benchStationsOption, benchBackendsOption, signalFilterOption, rateFilterOption});
+    parser.process(app);
+
+    if (parser.isSet(benchCodecOption)) {
+        const qint64 samples = parser.value(countOption).toLongLong();
+        return benchCodec(samples > 0 ? samples : 100000);
+    }
+    if (parser.isSet(benchStationsOption)) {
+        const int stations = parser.value(countOption).toInt();
+        return benchStations(stations > 0 ? stations : 500);
+    }
+    const QString interfaceName = parser.isSet(interfaceOption) ? parser.value(interfaceOption) : findWirelessInterface();
+    if (interfaceName.isEmpty()) {
+        std::fprintf(stderr, "No wireless interface found, use --interface\n");
+        return 1;
+    }
+
+    QByteArray bssidBytes;
+    if (parser.isSet(bssidOption)) {
+        bssidBytes = Nl80211Helper::parseMacAddress(parser.value(bssidOption));
+        if (bssidBytes.size() != 6) {
+            std::fprintf(stderr, "Invalid BSSID: %s\n", qPrintable(parser.value(bssidOption)));
+            return 1;
+        }
+    }
+
+    if (parser.isSet(benchBackendsOption)) {
+        const int samples = parser.value(countOption).toInt();
+        return benchBackends(interfaceName.toUtf8(),
+                             bssidBytes.size() == 6 ? reinterpret_cast<const uint8_t *>(bssidBytes.constData()) : nullptr,
+                             samples > 0 ? samples : 2000);
+    }
+
+    bool ok = false;
+    const int intervalMs = parser.value(intervalOption).toInt(&ok);
+    if (!ok || intervalMs < minIntervalMs) {
+        std::fprintf(stderr, "Interval must be an integer >= %d ms\n", minIntervalMs);
+        return 1;
+    }
+
+    const qint64 maxSamples = parser.value(countOption).toLongLong(&ok);
+    if (!ok || maxSamples < 0) {
+        std::fprintf(stderr, "Invalid sample count\n");
+        return 1;
+    }
+
+    const QString format = parser.value(formatOption);
+    const bool binary = format == QLatin1String("binary");
+    const bool compact = format == QLatin1String("compact");
+    if (!binary && !compact && format != QLatin1String("json")) {
+        std::fprintf(stderr, "Unknown format: %s\n", qPrintable(format));
+        return 1;
+    }
+    const bool bench = parser.isSet(benchOption);
+    const bool dumpStations = parser.isSet(stationsOption);
+    if (dumpStations && (binary || compact)) {
+        std::fprintf(stderr, "--stations only supports the json format\n");
+        return 1;
+    }
+
+    Nl80211Helper nl80211;
+    if (!nl80211.init()) {
+        std::fprintf(stderr, "Failed to initialize nl80211\n");
+        return 1;
+    }
+
+    if (parser.isSet(wiphyOption)) {
+        WiphyCapabilities caps;
+        const int index = nl80211.getWiphyIndex(interfaceName.toUtf8().constData());
+        if (index < 0 || !nl80211.getWiphyCapabilities(index, caps)) {
+            std::fprintf(stderr, "Failed to read wiphy capabilities of %s\n", qPrintable(interfaceName));
+            return 1;
+        }
+        std::fputs(QJsonDocument(wiphyToJson(caps)).toJson(QJsonDocument::Indented).constData(), stdout);
+        return 0;
+    }
+
+    QFile out;
+    if (!out.open(stdout, QIODevice::WriteOnly)) {
+        std::fprintf(stderr, "Failed to open stdout\n");
+        return 1;
+    }
+    QDataStream binaryOut(&out);
+    binaryOut.setByteOrder(QDataStream::LittleEndian);
+    if (binary && !bench) {
+        writeBinaryHeader(binaryOut);
+    } else if (compact && !bench) {
+        binaryOut.writeRawData(compactMagic, sizeof(compactMagic));
+        binaryOut << compactVersion;
+    }
+    SampleCodec::Encoder encoder;
+    uint8_t record[SampleCodec::maxRecordSize];
+
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+
+    const QByteArray ifname = interfaceName.toUtf8();
+    const uint8_t *bssidPtr = bssidBytes.size() == 6 ? reinterpret_cast<const uint8_t *>(bssidBytes.constData()) : nullptr;
+
+    StatsEngine engine;
+    QString filterError;
+    if ((parser.isSet(signalFilterOption) && !engine.setSignalFilter(parser.value(signalFilterOption), &filterError))
+        || (parser.isSet(rateFilterOption) && !engine.setRateFilter(parser.value(rateFilterOption), &filterError))) {
+        std::fprintf(stderr, "Invalid filter: %s\n", qPrintable(filterError));
+        return 1;
+    }
+    StationTable stationTable;
+    std::vector<qint64> latenciesNs;
+    if (bench && maxSamples > 0) {
+        latenciesNs.reserve(static_cast<size_t>(maxSamples));
+    }
+    int failures = 0;
+    qint64 samples = 0;
+
+    QElapsedTimer clock;
+    clock.start();
+
+    QTimer timer;
+    timer.setTimerType(Qt::PreciseTimer);
+    timer.setInterval(intervalMs);
+
+    const auto sampleOnce = [&]() {
+        if (stopRequested.load(std::memory_order_relaxed)) {
+            app.quit();
+            return;
+        }
+
+        const Tracer::Scope trace("tick", "timer");
+        Profiler::recordTick(Profiler::nowNs(), static_cast<uint64_t>(intervalMs) * 1000000);
+        const qint64 startNs = clock.nsecsElapsed();
+        if (dumpStations) {
+            const bool dumped = nl80211.dumpStations(ifname.constData(), stationTable);
+            const qint64 endNs = clock.nsecsElapsed();
+            if (!dumped) {
+                ++failures;
+            }
+            if (bench) {
+                latenciesNs.push_back(endNs - startNs);
+            } else {
+                out.write(QJsonDocument(stationsToJson(startNs, stationTable)).toJson(QJsonDocument::Compact));
+                out.write("\n", 1);
+                out.flush();
+            }
+            if (maxSamples > 0 && ++samples >= maxSamples) {
+                app.quit();
+            }
+            return;
+        }
+
+        const Nl80211StationInfo info = nl80211.getStationInfo(ifname.constData(), bssidPtr);
+        const qint64 endNs = clock.nsecsElapsed();
+
+        if (info.valid) {
+            engine.addSample(info, startNs / 1000000);
+        } else {
+            ++failures;
+        }
+
+        if (bench) {
+            latenciesNs.push_back(endNs - startNs);
+        } else if (binary) {
+            writeBinaryRecord(binaryOut, startNs, info);
+            out.flush();
+        } else if (compact) {
+            const size_t size = encoder.encode(static_cast<uint64_t>(startNs / 1000), info, record);
+            out.write(reinterpret_cast<const char *>(record), static_cast<qint64>(size));
+            out.flush();
+        } else {
+            out.write(QJsonDocument(sampleToJson(startNs, info, engine, nl80211.lastError())).toJson(QJsonDocument::Compact));
+            out.write("\n", 1);
+            out.flush();
+        }
+
+        if (maxSamples > 0 && ++samples >= maxSamples) {
+            app.quit();
+        }
+    };
+
+    const QString tracePath = Tracer::environmentPath();
+    if (!tracePath.isEmpty()) {
+        QString error;
+        if (!Tracer::start(tracePath, &error)) {
+            std::fprintf(stderr, "Cannot write trace %s: %s\n", qPrintable(tracePath), qPrintable(error));
+            return 1;
+        }
+    }
+
+    QObject::connect(&timer, &QTimer::timeout, &app, sampleOnce);
+    timer.start();
+    QTimer::singleShot(0, &app, sampleOnce);
+
+    const int ret = app.exec();
+    Tracer::stop();
+
+    if (bench) {
+        printLatencySummary(latenciesNs, failures);
+    }
+    if (parser.isSet(profileOption)) {
+        printProfile();
+    }
+    return ret;
+}
@@ -13,7 +13,13 @@ public:
         if (QLatin1String(uri) != QLatin1String("org.kde.plasma.private.truelinkmonitor")) {
             return;
         }
-        
+
+        qRegisterMetaType<WifiSnapshot>();
+        qmlRegisterUncreatableType<StationModel>(uri, 1, 0, "StationModel",
+                                                 QStringLiteral("StationModel is provided by WifiMonitor.stations"));
+        qmlRegisterUncreatableType<MloLinkModel>(uri, 1, 0, "MloLinkModel",
+                                                 QStringLiteral("MloLinkModel is provided by WifiMonitor.mloLinks"));
+
         qmlRegisterSingletonType<WifiMonitor>(uri, 1, 0, "WifiMonitor",
             [](QQmlEngine *engine, QJSEngine *) -> QObject * {
                 // Parent to the engine so the singleton gets cleaned up when the QML engine is destroyed
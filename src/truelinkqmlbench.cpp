@@ -0,0 +1,355 @@
+#include "statsbackend.h"
+#include "wifimonitor.h"
+
+#include <KLocalizedContext>
+
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QGuiApplication>
+#include <QMetaMethod>
+#include <QQmlContext>
+#include <QQmlEngine>
+#include <QQmlPropertyMap>
+#include <QQuickView>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <QXmlStreamReader>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <sys/resource.h>
+#include <vector>
+
+namespace {
+
+constexpr char monitorUri[] = "org.kde.plasma.private.truelinkmonitor";
+constexpr char packageSubdir[] = "plasma/plasmoids/org.kde.plasma.truelinkmonitor/contents";
+
+// Stand-in for org.kde.plasma.plasmoid: outside plasmashell there is no
+// applet to attach to, so Plasmoid.configuration comes from the bench.
+constexpr char shimQmldir[] =
+    "module org.kde.plasma.plasmoid\n"
+    "singleton Plasmoid 1.0 Plasmoid.qml\n";
+constexpr char shimPlasmoid[] =
+    "pragma Singleton\n"
+    "import QtQml\n"
+    "QtObject {\n"
+    "    readonly property QtObject configuration: benchConfiguration\n"
+    "}\n";
+
+/**
+ * The monitor the popup binds to, fed by a SyntheticBackend.
+ */
+class BenchMonitor : public WifiMonitor
+{
+public:
+    using WifiMonitor::WifiMonitor;
+
+    // Connections to @p signal; for the NOTIFY signals these are mostly QML
+    // bindings, i.e. what one emission re-evaluates.
+    int receiverCount(const QMetaMethod &signal) const
+    {
+        const QByteArray signature = QByteArray::number(QSIGNAL_CODE) + signal.methodSignature();
+        return receivers(signature.constData());
+    }
+};
+
+/**
+ * Counts emissions of one WifiMonitor signal.
+ */
+class SignalCounter : public QObject
+{
+    Q_OBJECT
+
+public:
+    using QObject::QObject;
+
+    qint64 count = 0;
+
+public Q_SLOTS:
+    void hit()
+    {
+        ++count;
+    }
+};
+
+double cpuSeconds()
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec
+        + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+// Fills @p config with the defaults from the package's main.xml.
+bool loadConfigDefaults(const QString &path, QQmlPropertyMap *config, bool allSections)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QXmlStreamReader xml(&file);
+    QString name;
+    QString type;
+    while (!xml.atEnd()) {
+        xml.readNext();
+        if (!xml.isStartElement()) {
+            continue;
+        }
+        if (xml.name() == QLatin1String("entry")) {
+            name = xml.attributes().value(QLatin1String("name")).toString();
+            type = xml.attributes().value(QLatin1String("type")).toString();
+        } else if (xml.name() == QLatin1String("default") && !name.isEmpty()) {
+            const QString value = xml.readElementText();
+            if (type == QLatin1String("Bool")) {
+                const bool show = allSections && name.startsWith(QLatin1String("show"));
+                config->insert(name, show || value == QLatin1String("true"));
+            } else if (type == QLatin1String("Int")) {
+                config->insert(name, value.toInt());
+            } else {
+                config->insert(name, value);
+            }
+        }
+    }
+    return !xml.hasError();
+}
+
+void printDistribution(const char *label, std::vector<double> &values, const char *unit)
+{
+    if (values.empty()) {
+        std::fprintf(stderr, "%-18s none\n", label);
+        return;
+    }
+    std::sort(values.begin(), values.end());
+    double sum = 0.0;
+    for (double v : values) {
+        sum += v;
+    }
+    std::fprintf(stderr, "%-18s n %-6zu mean %.3f  p50 %.3f  p99 %.3f  max %.3f %s\n",
+                 label,
+                 values.size(),
+                 sum / values.size(),
+                 values[values.size() / 2],
+                 values[std::min(values.size() - 1, values.size() * 99 / 100)],
+                 values.back(),
+                 unit);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    // Deterministic, GPU-independent numbers unless the caller chose otherwise.
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+        if (qEnvironmentVariableIsEmpty("QT_QUICK_BACKEND")) {
+            qputenv("QT_QUICK_BACKEND", "software");
+        }
+    }
+    // Keep rendering on this thread so frame timing and CPU use line up.
+    qputenv("QSG_RENDER_LOOP", "basic");
+
+    QGuiApplication app(argc, argv);
+    QGuiApplication::setApplicationName(QStringLiteral("truelink-qmlbench"));
+    QGuiApplication::setApplicationVersion(QStringLiteral(PROJECT_VERSION));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Renders the TrueLink popup offscreen against a synthetic feed and reports frame and update costs"));
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    const QCommandLineOption rateOption(QStringLiteral("rate"),
+                                        QStringLiteral("Synthetic samples per second, 1-100."),
+                                        QStringLiteral("hz"), QStringLiteral("10"));
+    const QCommandLineOption historyOption(QStringLiteral("history"),
+                                           QStringLiteral("Seconds of long-term history to pre-fill (up to one week)."),
+                                           QStringLiteral("seconds"), QStringLiteral("3600"));
+    const QCommandLineOption durationOption(QStringLiteral("duration"),
+                                            QStringLiteral("Measurement length in seconds, after one second of warm-up."),
+                                            QStringLiteral("seconds"), QStringLiteral("10"));
+    const QCommandLineOption windowOption(QStringLiteral("chart-window"),
+                                          QStringLiteral("Chart span: minute, hour or day."),
+                                          QStringLiteral("span"), QStringLiteral("minute"));
+    const QCommandLineOption allOption(QStringLiteral("all-sections"),
+                                       QStringLiteral("Enable every optional section of the popup."));
+    const QCommandLineOption packageOption(QStringLiteral("package"),
+                                           QStringLiteral("Plasmoid package contents directory (default: the installed one)."),
+                                           QStringLiteral("dir"));
+    const QCommandLineOption importOption(QStringLiteral("import"),
+                                          QStringLiteral("Extra QML import path."),
+                                          QStringLiteral("dir"));
+    const QCommandLineOption sizeOption(QStringLiteral("size"),
+                                        QStringLiteral("Popup size in pixels."),
+                                        QStringLiteral("WxH"), QStringLiteral("360x440"));
+    parser.addOptions({rateOption, historyOption, durationOption, windowOption, allOption, packageOption, importOption, sizeOption});
+    parser.process(app);
+
+    const int rateHz = parser.value(rateOption).toInt();
+    if (rateHz < 1 || rateHz > 100) {
+        std::fprintf(stderr, "Rate must be between 1 and 100 Hz\n");
+        return 1;
+    }
+    const int durationS = qMax(1, parser.value(durationOption).toInt());
+    const QStringList size = parser.value(sizeOption).split(QLatin1Char('x'));
+    if (size.size() != 2 || size[0].toInt() <= 0 || size[1].toInt() <= 0) {
+        std::fprintf(stderr, "Invalid size: %s\n", qPrintable(parser.value(sizeOption)));
+        return 1;
+    }
+
+    const QString window = parser.value(windowOption);
+    int chartWindow = 0;
+    if (window == QLatin1String("hour")) {
+        chartWindow = 1;
+    } else if (window == QLatin1String("day")) {
+        chartWindow = 2;
+    } else if (window != QLatin1String("minute")) {
+        std::fprintf(stderr, "Unknown chart window: %s\n", qPrintable(window));
+        return 1;
+    }
+
+    const QString packageDir = parser.isSet(packageOption)
+        ? parser.value(packageOption)
+        : QStandardPaths::locate(QStandardPaths::GenericDataLocation, QLatin1String(packageSubdir), QStandardPaths::LocateDirectory);
+    const QString qmlPath = QDir(packageDir).filePath(QStringLiteral("ui/FullRepresentation.qml"));
+    if (packageDir.isEmpty() || !QFile::exists(qmlPath)) {
+        std::fprintf(stderr, "FullRepresentation.qml not found, use --package\n");
+        return 1;
+    }
+
+    // Registered in place of the plugin, so the popup binds to this instance.
+    const int intervalMs = qMax(1, 1000 / rateHz);
+    BenchMonitor monitor(std::make_unique<SyntheticBackend>(intervalMs), intervalMs, parser.value(historyOption).toInt());
+    qRegisterMetaType<WifiSnapshot>();
+    qmlRegisterUncreatableType<StationModel>(monitorUri, 1, 0, "StationModel",
+                                             QStringLiteral("StationModel is provided by WifiMonitor.stations"));
+    qmlRegisterUncreatableType<MloLinkModel>(monitorUri, 1, 0, "MloLinkModel",
+                                             QStringLiteral("MloLinkModel is provided by WifiMonitor.mloLinks"));
+    qmlRegisterSingletonInstance<WifiMonitor>(monitorUri, 1, 0, "WifiMonitor", &monitor);
+
+    QTemporaryDir shimDir;
+    const QString shimModule = shimDir.filePath(QStringLiteral("org/kde/plasma/plasmoid"));
+    if (!shimDir.isValid() || !QDir().mkpath(shimModule)) {
+        std::fprintf(stderr, "Cannot create the Plasmoid stand-in module\n");
+        return 1;
+    }
+    for (const auto &[name, contents] : {std::pair{"qmldir", shimQmldir}, std::pair{"Plasmoid.qml", shimPlasmoid}}) {
+        QFile file(QDir(shimModule).filePath(QLatin1String(name)));
+        if (!file.open(QIODevice::WriteOnly) || file.write(contents) < 0) {
+            std::fprintf(stderr, "Cannot write %s\n", qPrintable(file.fileName()));
+            return 1;
+        }
+    }
+
+    QQuickView view;
+    QQmlEngine *engine = view.engine();
+    engine->addImportPath(shimDir.path());
+    for (const QString &path : parser.values(importOption)) {
+        engine->addImportPath(path);
+    }
+
+    auto *config = new QQmlPropertyMap(engine);
+    if (!loadConfigDefaults(QDir(packageDir).filePath(QStringLiteral("config/main.xml")), config, parser.isSet(allOption))) {
+        std::fprintf(stderr, "Cannot read config/main.xml from %s\n", qPrintable(packageDir));
+        return 1;
+    }
+    config->insert(QStringLiteral("chartWindow"), chartWindow);
+    engine->rootContext()->setContextProperty(QStringLiteral("benchConfiguration"), config);
+    engine->rootContext()->setContextObject(new KLocalizedContext(engine));
+
+    view.setResizeMode(QQuickView::SizeRootObjectToView);
+    view.resize(size[0].toInt(), size[1].toInt());
+    view.setSource(QUrl::fromLocalFile(qmlPath));
+    if (view.status() != QQuickView::Ready) {
+        for (const QQmlError &error : view.errors()) {
+            std::fprintf(stderr, "%s\n", qPrintable(error.toString()));
+        }
+        return 1;
+    }
+    view.show();
+
+    // One counter per WifiMonitor signal, to weigh emissions by their receivers.
+    std::vector<std::pair<QMetaMethod, SignalCounter *>> counters;
+    const QMetaObject &meta = WifiMonitor::staticMetaObject;
+    const QMetaMethod hit = SignalCounter::staticMetaObject.method(SignalCounter::staticMetaObject.indexOfSlot("hit()"));
+    for (int i = meta.methodOffset(); i < meta.methodCount(); ++i) {
+        const QMetaMethod method = meta.method(i);
+        if (method.methodType() == QMetaMethod::Signal) {
+            auto *counter = new SignalCounter(&app);
+            QObject::connect(&monitor, method, counter, hit);
+            counters.emplace_back(method, counter);
+        }
+    }
+
+    std::vector<double> frameMs;
+    QElapsedTimer frameTimer;
+    bool measuring = false;
+    QObject::connect(&view, &QQuickWindow::beforeFrameBegin, &app, [&]() {
+        frameTimer.start();
+    }, Qt::DirectConnection);
+    QObject::connect(&view, &QQuickWindow::afterFrameEnd, &app, [&]() {
+        if (measuring && frameTimer.isValid()) {
+            frameMs.push_back(frameTimer.nsecsElapsed() / 1e6);
+        }
+    }, Qt::DirectConnection);
+
+    double cpuStart = 0.0;
+    QElapsedTimer wall;
+    const auto startMeasuring = [&]() {
+        for (auto &entry : counters) {
+            entry.second->count = 0;
+        }
+        frameMs.clear();
+        cpuStart = cpuSeconds();
+        wall.start();
+        measuring = true;
+    };
+    QTimer::singleShot(1000, &app, startMeasuring);
+    QTimer::singleShot(1000 + durationS * 1000, &app, &QCoreApplication::quit);
+
+    app.exec();
+
+    const double cpu = cpuSeconds() - cpuStart;
+    const double elapsedS = wall.nsecsElapsed() / 1e9;
+
+    qint64 updates = 0;
+    qint64 bindingUpdates = 0;
+    for (const auto &[method, counter] : counters) {
+        const QString name = QString::fromLatin1(method.name());
+        if (name == QLatin1String("statsUpdated")) {
+            updates = counter->count;
+        }
+        // Less the counter's own connection.
+        bindingUpdates += counter->count * qMax(0, monitor.receiverCount(method) - 1);
+    }
+
+    std::fprintf(stderr, "rate: %d Hz  history: %s s  chart: %s  size: %s  sections: %s\n",
+                 rateHz, qPrintable(parser.value(historyOption)), qPrintable(window),
+                 qPrintable(parser.value(sizeOption)), parser.isSet(allOption) ? "all" : "defaults");
+    std::fprintf(stderr, "updates: %lld in %.1f s  frames: %zu (%.1f fps)\n",
+                 static_cast<long long>(updates), elapsedS, frameMs.size(), frameMs.size() / elapsedS);
+    printDistribution("frame time", frameMs, "ms");
+    if (updates > 0) {
+        std::fprintf(stderr, "bindings/update    %.1f (NOTIFY emissions weighted by their connections)\n",
+                     static_cast<double>(bindingUpdates) / updates);
+        std::fprintf(stderr, "cpu/update         %.3f ms (process total, including rendering)\n",
+                     cpu * 1000.0 / updates);
+    }
+    std::fprintf(stderr, "cpu                %.1f%% of one core\n", 100.0 * cpu / elapsedS);
+
+    // Time spent inside the statsUpdated/snapshotChanged emissions, i.e. the bindings themselves.
+    const QVariantMap stages = monitor.profile().value(QStringLiteral("stages")).toMap();
+    const QVariantMap emitStage = stages.value(QStringLiteral("emit")).toMap();
+    if (!emitStage.isEmpty()) {
+        std::fprintf(stderr, "emit stage         mean %.1f  p50 %.1f  p99 %.1f us\n",
+                     emitStage.value(QStringLiteral("meanUs")).toDouble(),
+                     emitStage.value(QStringLiteral("p50Us")).toDouble(),
+                     emitStage.value(QStringLiteral("p99Us")).toDouble());
+    }
+    return 0;
+}
+
+#include "truelinkqmlbench.moc"
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Rolling count of timer wakeups over the last hour
+ *
+ * One counter per minute in a ring, so recording a wakeup and reading the
+ * hourly total are both O(60) worst case and never allocate. Timestamps come
+ * from a monotonic clock supplied by the caller.
+ */
+class WakeupCounter
+{
+public:
+    static constexpr int bucketCount = 60;
+    static constexpr int64_t bucketMs = 60 * 1000;
+
+    void record(int64_t nowMs)
+    {
+        advance(nowMs);
+        ++m_buckets[m_head];
+    }
+
+    // Wakeups recorded in the hour up to @p nowMs.
+    [[nodiscard]] int perHour(int64_t nowMs) const
+    {
+        if (m_headMinute < 0) {
+            return 0;
+        }
+        // Buckets older than an hour at nowMs have not been cleared yet; skip them.
+        const int64_t elapsed = nowMs / bucketMs - m_headMinute;
+        const int64_t live = bucketCount - (elapsed > 0 ? elapsed : 0);
+        int total = 0;
+        for (int64_t k = 0; k < live; ++k) {
+            total += static_cast<int>(m_buckets[(m_head - k + bucketCount) % bucketCount]);
+        }
+        return total;
+    }
+
+    void reset()
+    {
+        for (uint32_t &count : m_buckets) {
+            count = 0;
+        }
+        m_head = 0;
+        m_headMinute = -1;
+    }
+
+private:
+    // Clears the buckets of every minute that passed since the last call.
+    void advance(int64_t nowMs)
+    {
+        const int64_t minute = nowMs / bucketMs;
+        if (m_headMinute < 0) {
+            m_headMinute = minute;
+            return;
+        }
+        int64_t elapsed = minute - m_headMinute;
+        if (elapsed <= 0) {
+            return;
+        }
+        if (elapsed > bucketCount) {
+            elapsed = bucketCount;
+        }
+        for (int64_t i = 0; i < elapsed; ++i) {
+            m_head = (m_head + 1) % bucketCount;
+            m_buckets[m_head] = 0;
+        }
+        m_headMinute = minute;
+    }
+
+    uint32_t m_buckets[bucketCount] = {};
+    int m_head = 0;
+    int64_t m_headMinute = -1;
+};
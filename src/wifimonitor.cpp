@@ -1,46 +1,60 @@
 #include "wifimonitor.h"
+#include "burstadaptor.h"
+#include "columnreducer.h"
+#include "eventtimeline.h"
+#include "historyexport.h"
+#include "nl80211events.h"
 #include "nl80211helper.h"
+#include "nl80211session.h"
+#include "phyrates.h"
+#include "powermonitor.h"
+#include "profiler.h"
+#include "rateoccupancy.h"
+#include "statsbackend.h"
+#include "stationtable.h"
+#include "tieredhistory.h"
+#include "tracer.h"
+#include "statsengine.h"
+#include "wakeupcounter.h"
+#include "wiphycapabilities.h"
 
 #include <KLocalizedString>
 #include <QByteArray>
+#include <QDateTime>
+#include <QDBusConnection>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QStandardPaths>
+#include <QThreadPool>
 #include <QTimer>
-#include <QVector>
 #include <QtGlobal>
-#include <QStringList>
 #include <NetworkManagerQt/Manager>
 #include <NetworkManagerQt/WirelessDevice>
 #include <NetworkManagerQt/AccessPoint>
 #include <NetworkManagerQt/ActiveConnection>
 #include <NetworkManagerQt/IpConfig>
 
-namespace {
-QByteArray parseBssidBytes(const QString &bssidText)
-{
-    if (bssidText.isEmpty()) {
-        return {};
-    }
-
-    const QStringList parts = bssidText.split(QLatin1Char(':'));
-    if (parts.size() != 6) {
-        return {};
-    }
+#include <net/if.h>
 
-    QByteArray out;
-    out.reserve(6);
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <memory>
 
-    for (const QString &part : parts) {
-        bool ok = false;
-        const int value = part.toInt(&ok, 16);
-        if (!ok || value < 0 || value > 255) {
-            return {};
-        }
+namespace {
 
-        const quint8 byte = static_cast<quint8>(value);
-        out.append(static_cast<char>(byte));
+// File name for an export in the user's download folder, e.g. truelink-20250101-120000.csv.
+QString exportPath(const QString &stem, const char *extension) {
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::DownloadLocation);
+    if (dir.isEmpty()) {
+        dir = QDir::homePath();
     }
-
-    return out;
+    return QDir(dir).filePath(QStringLiteral("%1-%2.%3")
+        .arg(stem,
+             QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd-HHmmss")),
+             QLatin1String(extension)));
 }
+
 } // namespace
 
 class WifiMonitor::Private {
@@ -50,10 +64,95 @@ public:
     NetworkManager::ActiveConnection::Ptr activeConnection;
     
     Nl80211Helper nl80211;
-    Nl80211StationInfo stationInfo;
+    StatsEngine stats;
+
+    // Cheapest first, see StatsBackend::select(). With only the signal on
+    // screen a sample is one pread() of /proc/net/wireless instead of a
+    // GET_STATION round trip.
+    ProcWirelessBackend procBackend;
+    SysfsBackend sysfsBackend;
+    Nl80211Backend nl80211Backend{nl80211};
+    StatsBackend *const backends[3] = {&procBackend, &sysfsBackend, &nl80211Backend};
+    StatsBackend *backend = &nl80211Backend; // the one that took the last sample
+    bool signalOnly = false;
+
+    // Set by the bench constructor: every sample comes from it and
+    // NetworkManager and nl80211 are never touched.
+    std::unique_ptr<StatsBackend> injectedBackend;
+
+    // Owns the nl80211 socket's lifecycle and the event listener; null with
+    // an injected backend. Nothing queries nl80211 unless it is ready.
+    Nl80211Session* session = nullptr;
+    // The failure last reported through errorOccurred, so a session that
+    // keeps backing off for the same reason does not repeat itself.
+    Nl80211Session::Failure reportedFailure = Nl80211Session::Failure::None;
+
+    // Radio capabilities come from a large GET_WIPHY dump, so they are fetched
+    // once and only refreshed when the kernel announces a wiphy change.
+    WiphyCapabilities wiphy;
+    bool wiphyStale = true;
+    int interfaceType = -1;
+    // What notifications are matched against; set with the capabilities.
+    int wiphyIndex = -1;
+    int ifindex = 0;
+
+    // Filled from a station dump instead of a single-BSSID query when the
+    // interface is an AP, mesh point or P2P group owner.
+    StationTable stationTable;
+    StationModel* stationModel = nullptr;
+    MloLinkModel* linkModel = nullptr;
     
     QTimer* statsTimer = nullptr;
     QString interfaceName;
+
+    // What the sampling tick passes to the backends, re-encoded only when
+    // the interface or the AP changes so a steady-state tick never allocates.
+    QString sampledInterface;
+    QByteArray sampledInterfaceUtf8;
+    QString sampledBssid;
+    QByteArray sampledBssidBytes;
+
+    // Raw high-rate capture next to the regular tick; see BurstCapture.
+    BurstCapture burst;
+    QTimer* burstTimer = nullptr;
+    int burstIntervalMs = BurstCapture::defaultIntervalMs;
+    int burstDurationMs = BurstCapture::defaultDurationMs;
+    bool burstOnDegradation = false;
+    // burstChanged is emitted about once a second while a burst runs.
+    int burstTicksSinceNotify = 0;
+    // A flapping link would otherwise keep the radio busy with bursts.
+    uint64_t lastAutoBurstNs = 0;
+    static constexpr uint64_t autoBurstCooldownNs = 5ull * 60 * 1000 * 1000 * 1000;
+
+    void refreshSampledTarget() {
+        if (sampledBssid != cachedBssid) {
+            sampledBssid = cachedBssid;
+            sampledBssidBytes = Nl80211Helper::parseMacAddress(cachedBssid);
+        }
+        if (sampledInterface != interfaceName) {
+            sampledInterface = interfaceName;
+            sampledInterfaceUtf8 = interfaceName.toUtf8();
+        }
+    }
+
+    // Sampling slows down or stops with the session so an idle or locked
+    // desktop does not pay for a 1 Hz wakeup nobody is looking at.
+    enum class SamplingMode {
+        Stopped = 0,  // not connected
+        Active,       // 1 Hz, coarse timer
+        Battery,      // 1 Hz, very coarse timer so the kernel can batch wakeups
+        Idle,         // slow poll while the session is idle
+        Paused,       // screen locked
+    };
+    PowerMonitor* power = nullptr;
+    bool samplingRequested = false;
+    SamplingMode samplingMode = SamplingMode::Stopped;
+    WakeupCounter wakeups;
+    QElapsedTimer uptime;
+
+    // Profile summary goes to the log category once a minute at 1 Hz.
+    static constexpr int profileLogInterval = 60;
+    int ticksSinceProfileLog = 0;
     
     bool isConnected = false;
     bool isAvailable = false;
@@ -67,37 +166,76 @@ public:
     QString cachedGateway;
 
     QString lastError;
-    
-    double smoothedTxRate = 0.0;
-    double smoothedRxRate = 0.0;
-    static constexpr double smoothingFactor = 0.3;
 
-    static constexpr int updateIntervalMs = 1000;
-    
-    static constexpr int historySize = 60;
-    QVector<double> rxHistoryBuffer;
-    QVector<double> txHistoryBuffer;
-    double maxRate = 100.0;
-    
-    void addToHistory(double rx, double tx) {
-        rxHistoryBuffer.append(rx);
-        txHistoryBuffer.append(tx);
-        if (rxHistoryBuffer.size() > historySize) {
-            rxHistoryBuffer.removeFirst();
-            txHistoryBuffer.removeFirst();
+    WifiSnapshot snapshot;
+
+    // Translated labels, built on first use and then shared by every snapshot.
+    QString qualityLabels[5];
+    QString generationLabels[5]; // by WifiMode
+    QString unknownGenerationLabel;
+    QString guardIntervalLabels[4];
+
+    const QString &generationLabel(Nl80211StationInfo::WifiMode mode) {
+        QString &label = generationLabels[static_cast<int>(mode)];
+        if (label.isNull()) {
+            switch (mode) {
+                case Nl80211StationInfo::WifiMode::HT:  label = i18nc("WiFi generation", "WiFi 4"); break;
+                case Nl80211StationInfo::WifiMode::VHT: label = i18nc("WiFi generation", "WiFi 5"); break;
+                case Nl80211StationInfo::WifiMode::HE:  label = i18nc("WiFi generation", "WiFi 6"); break;
+                case Nl80211StationInfo::WifiMode::EHT: label = i18nc("WiFi generation", "WiFi 7"); break;
+                default:                                label = i18nc("WiFi generation", "Legacy"); break;
+            }
         }
-        maxRate = 100.0;
-        for (double v : rxHistoryBuffer) maxRate = qMax(maxRate, v);
-        for (double v : txHistoryBuffer) maxRate = qMax(maxRate, v);
+        return label;
     }
 
+    // Per-connection rate occupancy, reset with stats.
+    RateOccupancy occupancy;
+    qint64 lastOccupancyMs = 0;
+    qint64 occupancyNotifiedMs = 0;
+    static constexpr int occupancyNotifyMs = 2000;
+
+    // Long-term history. Unlike stats it survives reconnects, so the hour
+    // and day views still show the link before a roam or a dropout.
+    TieredHistory tiers;
+
+    // Chart series reduced to the plot width; see ColumnReducer.
+    ColumnReducer rxChart;
+    ColumnReducer txChart;
+    // What rxChart()/txChart() hand out, refilled in place on each read.
+    QList<qreal> rxChartPoints;
+    QList<qreal> txChartPoints;
+    int chartColumns = StatsEngine::historySize;
+    WifiMonitor::ChartWindow chartWindow = WifiMonitor::ChartMinute;
+
+    QVariantList linkEvents;
+    static constexpr int maxLinkEvents = 50;
+
+    // Exports run here, one at a time. Destroying the pool waits for a
+    // running export, so its queued result never outlives the monitor.
+    QThreadPool exportPool;
+    bool exporting = false;
+
+    // Started from TRUELINK_TRACE; the tracing setting doesn't stop it.
+    bool traceFromEnvironment = false;
+
+    // EventTimeline::recorded() when the timeline was last scanned, and
+    // when timelineChanged was last emitted. Sample markers alone refresh
+    // the list at most every timelineSampleRefreshNs.
+    uint64_t timelineScanned = 0;
+    uint64_t timelineNotifiedNs = 0;
+    static constexpr int timelineRows = 100;
+    static constexpr int timelineScanBatch = 16;
+    static constexpr uint64_t timelineSampleRefreshNs = 30000000000ULL;
+    
+    static constexpr int updateIntervalMs = 1000;
+    static constexpr int idleIntervalMs = 10000;
+
     void resetStats() {
-        stationInfo = Nl80211StationInfo{};
-        smoothedTxRate = 0.0;
-        smoothedRxRate = 0.0;
-        rxHistoryBuffer.clear();
-        txHistoryBuffer.clear();
-        maxRate = 100.0;
+        stats.reset();
+        occupancy.reset();
+        lastOccupancyMs = 0;
+        linkModel->clear();
         lastError.clear();
     }
 };
@@ -106,11 +244,92 @@ WifiMonitor::WifiMonitor(QObject *parent)
     : QObject(parent)
     , d(new Private)
 {
+    d->uptime.start();
+    rebuildChart();
+    d->power = new PowerMonitor(this);
+    connect(d->power, &PowerMonitor::stateChanged, this, &WifiMonitor::applySamplingPolicy);
+
+    d->stationModel = new StationModel(this);
+    d->linkModel = new MloLinkModel(this);
+
+    const QString tracePath = Tracer::environmentPath();
+    if (!tracePath.isEmpty()) {
+        QString error;
+        d->traceFromEnvironment = Tracer::start(tracePath, &error);
+        if (!d->traceFromEnvironment) {
+            qCWarning(TRUELINK_PROFILE, "Cannot write trace %s: %s", qPrintable(tracePath), qPrintable(error));
+        }
+    }
+
+    d->session = new Nl80211Session(d->nl80211, this);
+    connect(d->session->events(), &Nl80211Events::wiphyChanged, this, &WifiMonitor::onWiphyChanged);
+    connect(d->session->events(), &Nl80211Events::interfaceChanged, this, &WifiMonitor::onInterfaceChanged);
+    connect(d->session, &Nl80211Session::resyncRequired, this, &WifiMonitor::invalidateWiphy);
+    connect(d->session, &Nl80211Session::stateChanged, this, &WifiMonitor::onSessionStateChanged);
+    // Before NetworkManager, whose first connection callback reads the wiphy.
+    d->session->start();
+
+    // Lets scripts start a burst right when they reproduce a problem. A
+    // second applet instance finds the path taken, which is harmless.
+    new BurstAdaptor(this);
+    QDBusConnection::sessionBus().registerObject(QStringLiteral("/org/kde/plasma/truelinkmonitor"), this);
+
     initNetworkManager();
-    initNl80211();
 }
 
-WifiMonitor::~WifiMonitor() = default;
+#ifdef TRUELINK_BENCH
+WifiMonitor::WifiMonitor(std::unique_ptr<StatsBackend> backend, int intervalMs, int historySeconds, QObject *parent)
+    : QObject(parent)
+    , d(new Private)
+{
+    d->uptime.start();
+    d->power = new PowerMonitor(this);
+    d->stationModel = new StationModel(this);
+    d->linkModel = new MloLinkModel(this);
+    d->injectedBackend = std::move(backend);
+
+    d->interfaceName = QStringLiteral("synthetic0");
+    d->isAvailable = true;
+    d->isConnected = true;
+    d->cachedSsid = QStringLiteral("Synthetic");
+    d->cachedBssid = QStringLiteral("02:00:00:00:00:01");
+    d->cachedFrequency = 5180;
+    d->cachedChannelWidth = 80;
+    d->cachedSecurity = QStringLiteral("WPA2/WPA3");
+    d->cachedIpAddress = QStringLiteral("192.0.2.10");
+    d->cachedGateway = QStringLiteral("192.0.2.1");
+
+    // Back-fill the long-term tiers so the hour and day charts have data.
+    SyntheticStation past(2);
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    for (int i = qBound(0, historySeconds, 7 * 24 * 3600); i > 0; --i) {
+        const Nl80211StationInfo info = past.next(1000);
+        const float values[TieredHistory::metricCount] = {
+            static_cast<float>(info.rxBitrate / 10.0),
+            static_cast<float>(info.txBitrate / 10.0),
+            static_cast<float>(info.signalDbm),
+        };
+        d->tiers.addSample(nowMs - qint64(i) * 1000, values);
+    }
+    rebuildChart();
+
+    d->samplingMode = Private::SamplingMode::Active;
+    d->statsTimer = new QTimer(this);
+    d->statsTimer->setTimerType(Qt::PreciseTimer);
+    d->statsTimer->setInterval(qMax(1, intervalMs));
+    connect(d->statsTimer, &QTimer::timeout, this, &WifiMonitor::updateNl80211Stats);
+    d->statsTimer->start();
+}
+
+void WifiMonitor::sampleNow() {
+    updateNl80211Stats();
+}
+#endif
+
+WifiMonitor::~WifiMonitor() {
+    // Closes the JSON array; the flusher must not outlive the process's statics.
+    Tracer::stop();
+}
 
 void WifiMonitor::initNetworkManager() {
     connect(NetworkManager::notifier(), &NetworkManager::Notifier::primaryConnectionChanged,
@@ -135,32 +354,166 @@ void WifiMonitor::initNetworkManager() {
     onActiveConnectionChanged();
 }
 
-void WifiMonitor::initNl80211() {
-    if (!d->nl80211.init()) {
-        d->lastError = i18n("Failed to initialize nl80211");
+void WifiMonitor::onSessionStateChanged() {
+    const Nl80211Session &session = *d->session;
+    if (session.state() == Nl80211Session::State::Backoff) {
+        const QString error = i18n("nl80211 unavailable (%1), retrying in %2 s",
+                                   QLatin1String(Nl80211Session::failureName(session.failure())),
+                                   qMax(1, (session.retryInMs() + 999) / 1000));
+        const bool newFailure = session.failure() != d->reportedFailure;
+        d->reportedFailure = session.failure();
+        d->lastError = error;
+        Q_EMIT lastErrorChanged();
+        if (newFailure) {
+            EventTimeline::record(EventTimeline::Kind::Error, error);
+            Q_EMIT errorOccurred(error);
+        }
+    } else if (d->reportedFailure != Nl80211Session::Failure::None) {
+        d->reportedFailure = Nl80211Session::Failure::None;
+        d->lastError.clear();
         Q_EMIT lastErrorChanged();
-        Q_EMIT errorOccurred(d->lastError);
+    }
+    Q_EMIT nl80211SessionChanged();
+}
+
+void WifiMonitor::refreshWiphy() {
+    if (!d->session || !d->session->isReady()) {
+        // Stays stale; the session's resync after recovery comes back here.
+        return;
+    }
+    d->wiphyStale = false;
+    const QByteArray ifname = d->interfaceName.toUtf8();
+    d->wiphyIndex = ifname.isEmpty() ? -1 : d->nl80211.getWiphyIndex(ifname.constData(), &d->interfaceType);
+    d->ifindex = ifname.isEmpty() ? 0 : static_cast<int>(if_nametoindex(ifname.constData()));
+    if (d->wiphyIndex < 0 || !d->nl80211.getWiphyCapabilities(d->wiphyIndex, d->wiphy)) {
+        d->wiphy = WiphyCapabilities{};
+    }
+}
+
+void WifiMonitor::invalidateWiphy() {
+    const Tracer::Scope trace("nl80211Notification", "nl80211");
+    d->wiphyStale = true;
+    if (d->isConnected || hostingStations()) {
+        // Also catches an interface switching between station and AP/mesh mode.
+        onActiveConnectionChanged();
+    }
+}
+
+void WifiMonitor::onWiphyChanged(int wiphyIndex) {
+    // Another radio coming or going changes nothing about this one.
+    if (wiphyIndex < 0 || d->wiphyIndex < 0 || wiphyIndex == d->wiphyIndex) {
+        invalidateWiphy();
+    }
+}
+
+void WifiMonitor::onInterfaceChanged(int ifindex, int wiphyIndex) {
+    if (ifindex < 0 || d->ifindex == 0 || ifindex == d->ifindex) {
+        invalidateWiphy();
+    } else if (wiphyIndex < 0 || wiphyIndex == d->wiphyIndex) {
+        // A virtual interface next to ours, e.g. a P2P device: the radio's
+        // interface combinations may have changed, the connection has not.
+        d->wiphyStale = true;
     }
 }
 
 void WifiMonitor::startStatsTimer() {
     if (!d->statsTimer) {
         d->statsTimer = new QTimer(this);
-        d->statsTimer->setInterval(Private::updateIntervalMs);
-        connect(d->statsTimer, &QTimer::timeout, this, &WifiMonitor::updateNl80211Stats);
+        connect(d->statsTimer, &QTimer::timeout, this, &WifiMonitor::onStatsTimerTimeout);
+    }
+    d->samplingRequested = true;
+    applySamplingPolicy();
+    if (d->samplingMode != Private::SamplingMode::Paused) {
+        updateNl80211Stats();
     }
-    d->statsTimer->start();
-    updateNl80211Stats();
 }
 
 void WifiMonitor::stopStatsTimer() {
+    d->samplingRequested = false;
+    applySamplingPolicy();
+}
+
+void WifiMonitor::applySamplingPolicy() {
+    const Tracer::Scope trace("powerStateChanged", "dbus");
+    using Mode = Private::SamplingMode;
+
+    Mode mode = Mode::Stopped;
+    if (d->samplingRequested) {
+        if (d->power->screenLocked()) {
+            mode = Mode::Paused;
+        } else if (d->power->idle()) {
+            mode = Mode::Idle;
+        } else if (d->power->onBattery()) {
+            mode = Mode::Battery;
+        } else {
+            mode = Mode::Active;
+        }
+    }
+
+    const Mode previous = d->samplingMode;
+    if (mode == previous) {
+        return;
+    }
+    d->samplingMode = mode;
+
+    Profiler::restartTicks();
     if (d->statsTimer) {
+        // Timer type only applies on the next start().
         d->statsTimer->stop();
+        switch (mode) {
+        case Mode::Active:
+            d->statsTimer->setTimerType(Qt::CoarseTimer);
+            d->statsTimer->setInterval(Private::updateIntervalMs);
+            d->statsTimer->start();
+            break;
+        case Mode::Battery:
+            d->statsTimer->setTimerType(Qt::VeryCoarseTimer);
+            d->statsTimer->setInterval(Private::updateIntervalMs);
+            d->statsTimer->start();
+            break;
+        case Mode::Idle:
+            d->statsTimer->setTimerType(Qt::VeryCoarseTimer);
+            d->statsTimer->setInterval(Private::idleIntervalMs);
+            d->statsTimer->start();
+            break;
+        case Mode::Paused:
+        case Mode::Stopped:
+            break;
+        }
+    }
+
+    // One catch-up sample on resume so the popup is current straight away
+    // instead of showing pre-lock values until the next tick.
+    const bool wasSleeping = previous == Mode::Paused || previous == Mode::Idle;
+    const bool isAwake = mode == Mode::Active || mode == Mode::Battery;
+    if (wasSleeping && isAwake) {
+        updateNl80211Stats();
+    }
+
+    EventTimeline::record(EventTimeline::Kind::SamplingMode, samplingMode());
+    Q_EMIT samplingModeChanged();
+    notifyTimeline();
+}
+
+void WifiMonitor::onStatsTimerTimeout() {
+    const Tracer::Scope trace("statsTimer", "timer");
+    d->wakeups.record(d->uptime.elapsed());
+    Profiler::recordTick(Profiler::nowNs(), static_cast<uint64_t>(d->statsTimer->interval()) * 1000000);
+    updateNl80211Stats();
+
+    if (++d->ticksSinceProfileLog >= Private::profileLogInterval) {
+        d->ticksSinceProfileLog = 0;
+        Profiler::logSummary();
     }
 }
 
 void WifiMonitor::onActiveConnectionChanged() {
+    const Tracer::Scope trace("activeConnectionChanged", "dbus");
+    const bool wasConnected = d->isConnected;
     if (!d->wirelessDevice) {
+        if (wasConnected) {
+            EventTimeline::record(EventTimeline::Kind::Disconnected);
+        }
         d->isConnected = false;
         d->cachedSsid.clear();
         d->cachedBssid.clear();
@@ -171,17 +524,23 @@ void WifiMonitor::onActiveConnectionChanged() {
         d->cachedGateway.clear();
         const bool hadError = !d->lastError.isEmpty();
         d->resetStats();
+        rebuildChart();
         if (hadError) {
             Q_EMIT lastErrorChanged();
         }
         stopStatsTimer();
+        updateSnapshot();
         Q_EMIT connectionChanged();
+        notifyTimeline();
         return;
     }
     
     d->accessPoint = d->wirelessDevice->activeAccessPoint();
     
     if (!d->accessPoint) {
+        if (wasConnected) {
+            EventTimeline::record(EventTimeline::Kind::Disconnected);
+        }
         d->isConnected = false;
         d->cachedSsid.clear();
         d->cachedBssid.clear();
@@ -192,18 +551,37 @@ void WifiMonitor::onActiveConnectionChanged() {
         d->cachedGateway.clear();
         const bool hadError = !d->lastError.isEmpty();
         d->resetStats();
+        rebuildChart();
         if (hadError) {
             Q_EMIT lastErrorChanged();
         }
-        stopStatsTimer();
+        // Mesh points have no access point but still have peers to list.
+        if (d->wiphyStale) {
+            refreshWiphy();
+        }
+        if (hostingStations()) {
+            startStatsTimer();
+        } else {
+            d->stationTable.clear();
+            d->stationModel->update(d->stationTable);
+            stopStatsTimer();
+        }
+        updateSnapshot();
         Q_EMIT connectionChanged();
+        notifyTimeline();
         return;
     }
     
+    const QString previousBssid = d->cachedBssid;
     d->isConnected = true;
     d->cachedSsid = d->accessPoint->ssid();
     d->cachedBssid = d->accessPoint->hardwareAddress();
     d->cachedFrequency = d->accessPoint->frequency();
+    if (!wasConnected) {
+        EventTimeline::record(EventTimeline::Kind::Connected, d->cachedBssid, d->cachedFrequency);
+    } else if (d->cachedBssid != previousBssid) {
+        EventTimeline::record(EventTimeline::Kind::Roamed, d->cachedBssid, d->cachedFrequency);
+    }
     d->cachedChannelWidth = d->accessPoint->bandwidth();
     
     auto flags = d->accessPoint->rsnFlags();
@@ -235,15 +613,22 @@ void WifiMonitor::onActiveConnectionChanged() {
         }
     }
     
+    if (d->wiphyStale) {
+        refreshWiphy();
+    }
+
     startStatsTimer();
     Q_EMIT connectionChanged();
+    notifyTimeline();
 }
 
 void WifiMonitor::onDeviceStateChanged() {
+    const Tracer::Scope trace("deviceStateChanged", "dbus");
     bool wasAvailable = d->isAvailable;
     d->isAvailable = d->wirelessDevice && NetworkManager::isWirelessEnabled();
     
     if (wasAvailable != d->isAvailable) {
+        EventTimeline::record(EventTimeline::Kind::Availability, d->isAvailable ? 1 : 0);
         Q_EMIT availabilityChanged();
     }
     
@@ -251,15 +636,30 @@ void WifiMonitor::onDeviceStateChanged() {
 }
 
 void WifiMonitor::updateNl80211Stats() {
-    if (!d->isConnected || d->interfaceName.isEmpty()) {
+    const Tracer::Scope trace("updateStats", "monitor");
+    if (d->interfaceName.isEmpty()) {
+        return;
+    }
+    if (hostingStations()) {
+        updateStations();
+        notifyTimeline();
+        return;
+    }
+    if (!d->stationTable.isEmpty()) {
+        d->stationTable.clear();
+        d->stationModel->update(d->stationTable);
+    }
+    if (!d->isConnected) {
         return;
     }
     
-    const QByteArray bssidBytes = parseBssidBytes(d->cachedBssid);
+    d->refreshSampledTarget();
+    const QByteArray &bssidBytes = d->sampledBssidBytes;
     if (!d->cachedBssid.isEmpty() && bssidBytes.isEmpty()) {
         const QString error = i18n("Invalid BSSID format: %1", d->cachedBssid);
         if (error != d->lastError) {
             d->lastError = error;
+            EventTimeline::record(EventTimeline::Kind::Error, error);
             Q_EMIT lastErrorChanged();
             Q_EMIT errorOccurred(error);
         }
@@ -270,105 +670,326 @@ void WifiMonitor::updateNl80211Stats() {
         ? reinterpret_cast<const uint8_t*>(bssidBytes.constData()) 
         : nullptr;
     
-    Nl80211StationInfo newInfo = d->nl80211.getStationInfo(d->interfaceName.toUtf8().constData(), bssidPtr);
-    
-    if (newInfo.valid) {
+    const QByteArray &ifname = d->sampledInterfaceUtf8;
+    const uint32_t required = d->signalOnly ? StatsBackend::Signal : StatsBackend::AllFields;
+    // While the session backs off, the backends ahead of nl80211 keep the
+    // signal current; the rate history waits for nl80211 to come back.
+    const bool sessionDown = d->session && !d->session->isReady();
+    StatsBackend *backend = d->injectedBackend
+        ? d->injectedBackend.get()
+        : sessionDown ? StatsBackend::select(d->backends, 2, StatsBackend::Signal)
+                      : StatsBackend::select(d->backends, std::size(d->backends), required);
+    if (!backend) {
+        return;
+    }
+    d->backend = backend;
+    Nl80211StationInfo newInfo = d->backend->sample(ifname.constData(), bssidPtr);
+    if (!newInfo.valid && d->backend->fields() != StatsBackend::AllFields && !sessionDown) {
+        // E.g. a driver without wireless extensions; nl80211 covers everything.
+        d->backend = &d->nl80211Backend;
+        newInfo = d->backend->sample(ifname.constData(), bssidPtr);
+    }
+    if (d->backend == &d->nl80211Backend && d->session) {
+        d->session->reportResult(newInfo.valid);
+    }
+
+    bool chartMoved = false;
+    if (newInfo.valid && d->backend->fields() != StatsBackend::AllFields) {
+        if (!d->lastError.isEmpty() && !sessionDown) {
+            d->lastError.clear();
+            Q_EMIT lastErrorChanged();
+        }
+        // Partial sample: the signal goes into its history tier and its
+        // detector; the rate history and the other detectors are left alone
+        // rather than fed zeros.
+        const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+        d->stats.updateSignal(newInfo.signalDbm, nowMs);
+        d->linkModel->update(d->stats.stationInfo());
+        EventTimeline::record(EventTimeline::Kind::Sample, newInfo.signalDbm);
+
+        const float tierValues[TieredHistory::metricCount] = {0.0f, 0.0f, static_cast<float>(newInfo.signalDbm)};
+        const int committed = d->tiers.addSample(nowMs, tierValues, 1u << static_cast<int>(TieredHistory::Metric::Signal));
+        if (d->chartWindow != ChartMinute) {
+            // The hour and day views get a gap; the minute view shows
+            // smoothed rates, which have not moved.
+            chartMoved = appendToChart(committed);
+        }
+        publishLinkEvents();
+    } else if (newInfo.valid) {
         if (!d->lastError.isEmpty()) {
             d->lastError.clear();
             Q_EMIT lastErrorChanged();
         }
 
-        d->stationInfo = newInfo;
-        
-        double newTx = newInfo.txBitrate / 10.0;
-        double newRx = newInfo.rxBitrate / 10.0;
-        
-        if (d->smoothedTxRate == 0.0) {
-            d->smoothedTxRate = newTx;
-            d->smoothedRxRate = newRx;
-        } else {
-            d->smoothedTxRate = d->smoothingFactor * newTx + (1.0 - d->smoothingFactor) * d->smoothedTxRate;
-            d->smoothedRxRate = d->smoothingFactor * newRx + (1.0 - d->smoothingFactor) * d->smoothedRxRate;
+        // Still the previous full sample here; signal-only ones carry no counters.
+        const Nl80211StationInfo &previous = d->stats.lastFullSample();
+        const uint32_t retries = previous.valid && newInfo.txRetries >= previous.txRetries
+            ? newInfo.txRetries - previous.txRetries
+            : 0;
+        EventTimeline::record(EventTimeline::Kind::Sample, newInfo.signalDbm, static_cast<int32_t>(retries));
+
+        const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+        d->stats.addSample(newInfo, nowMs);
+        d->linkModel->update(newInfo);
+
+        // A sample stands for the time since the previous one, but not for a
+        // suspend or a paused timer in between.
+        const qint64 maxGapMs = 2 * qint64(d->statsTimer ? d->statsTimer->interval() : Private::updateIntervalMs);
+        const qint64 elapsedMs = d->lastOccupancyMs > 0 ? qBound<qint64>(0, nowMs - d->lastOccupancyMs, maxGapMs)
+                                                        : maxGapMs / 2;
+        d->lastOccupancyMs = nowMs;
+        d->occupancy.add(newInfo, static_cast<uint32_t>(elapsedMs));
+        if (nowMs - d->occupancyNotifiedMs >= Private::occupancyNotifyMs) {
+            d->occupancyNotifiedMs = nowMs;
+            Q_EMIT rateOccupancyChanged();
         }
-        d->addToHistory(d->smoothedRxRate, d->smoothedTxRate);
-    } else {
-        const QString error = d->nl80211.lastError();
+
+        const float tierValues[TieredHistory::metricCount] = {
+            static_cast<float>(newInfo.rxBitrate / 10.0),
+            static_cast<float>(newInfo.txBitrate / 10.0),
+            static_cast<float>(newInfo.signalDbm),
+        };
+        const int committed = d->tiers.addSample(nowMs, tierValues);
+        chartMoved = appendToChart(committed);
+
+        publishLinkEvents();
+    } else if (!d->session || d->session->isReady()) {
+        // Otherwise onSessionStateChanged() has already reported why.
+        const QString error = d->backend->lastError();
         if (error != d->lastError) {
             d->lastError = error;
             Q_EMIT lastErrorChanged();
 
             if (!error.isEmpty()) {
+                EventTimeline::record(EventTimeline::Kind::Error, error);
                 Q_EMIT errorOccurred(error);
             }
         }
     }
     
+    const Profiler::Scope profile(Profiler::Stage::Emit);
+    updateSnapshot();
     Q_EMIT statsUpdated();
+    if (chartMoved) {
+        Q_EMIT chartChanged();
+    }
+    notifyTimeline();
+}
+
+void WifiMonitor::publishLinkEvents() {
+    for (int i = 0; i < d->stats.lastEventCount(); ++i) {
+        const LinkDetector::Event &event = d->stats.lastEvent(i);
+        EventTimeline::record(EventTimeline::Kind::LinkEvent, event.kind == LinkDetector::EventKind::Degraded ? 1 : 0, 0,
+                              LinkDetector::metricName(event.metric));
+        const QVariantMap entry{
+            {QStringLiteral("timestamp"), static_cast<qint64>(event.timestampMs)},
+            {QStringLiteral("metric"), QLatin1String(LinkDetector::metricName(event.metric))},
+            {QStringLiteral("degraded"), event.kind == LinkDetector::EventKind::Degraded},
+            {QStringLiteral("value"), event.value},
+            {QStringLiteral("baseline"), event.baseline},
+        };
+        d->linkEvents.prepend(entry);
+        if (d->linkEvents.size() > Private::maxLinkEvents) {
+            d->linkEvents.removeLast();
+        }
+        Q_EMIT linkEvent(entry);
+    }
+    if (d->stats.lastEventCount() > 0) {
+        Q_EMIT linkEventsChanged();
+    }
+    if (d->burstOnDegradation && d->stats.lastEventCount() > 0 && !d->burst.isActive()) {
+        bool degraded = false;
+        for (int i = 0; i < d->stats.lastEventCount(); ++i) {
+            degraded |= d->stats.lastEvent(i).kind == LinkDetector::EventKind::Degraded;
+        }
+        const uint64_t now = Profiler::nowNs();
+        if (degraded && (d->lastAutoBurstNs == 0 || now - d->lastAutoBurstNs >= Private::autoBurstCooldownNs)
+            && startBurstCapture(0, 0, BurstCapture::Trigger::Degradation)) {
+            d->lastAutoBurstNs = now;
+        }
+    }
+}
+
+void WifiMonitor::updateStations() {
+    if (!d->session || !d->session->isReady()) {
+        return;
+    }
+    d->refreshSampledTarget();
+    const bool ok = d->nl80211.dumpStations(d->sampledInterfaceUtf8.constData(), d->stationTable);
+    d->session->reportResult(ok);
+    if (!ok) {
+        if (!d->session->isReady()) {
+            // onSessionStateChanged() has reported it.
+            return;
+        }
+        const QString error = d->nl80211.lastError();
+        if (error != d->lastError) {
+            d->lastError = error;
+            EventTimeline::record(EventTimeline::Kind::Error, error);
+            Q_EMIT lastErrorChanged();
+            Q_EMIT errorOccurred(error);
+        }
+        return;
+    }
+    if (!d->lastError.isEmpty()) {
+        d->lastError.clear();
+        Q_EMIT lastErrorChanged();
+    }
+
+    const Profiler::Scope profile(Profiler::Stage::Emit);
+    d->stationModel->update(d->stationTable);
 }
 
+void WifiMonitor::updateSnapshot() {
+    const Nl80211StationInfo &info = d->stats.stationInfo();
+    // Updated in place: the strings are shared labels and the chain list is
+    // only resized when the chain count changes, so unless QML still holds
+    // the previous snapshot this does not allocate.
+    WifiSnapshot &snap = d->snapshot;
+    ++snap.sequence;
+    snap.timestampMs = QDateTime::currentMSecsSinceEpoch();
+    snap.valid = info.valid;
+
+    snap.signalDbm = signalDbm();
+    snap.signalDbmRaw = signalDbmRaw();
+    snap.signalPercent = signalPercent();
+    snap.signalQuality = signalQuality();
+    snap.statusColor = statusColor();
+
+    snap.rxRate = rxRate();
+    snap.txRate = txRate();
+    snap.rxRateSmoothed = d->stats.smoothedRxRate();
+    snap.txRateSmoothed = d->stats.smoothedTxRate();
+    snap.maxHistoryRate = maxHistoryRate();
+
+    snap.wifiGeneration = wifiGeneration();
+    snap.mcsIndex = mcsIndex();
+    snap.mimoStreams = mimoStreams();
+    snap.channelWidth = channelWidth();
+    snap.guardInterval = guardInterval();
+    snap.dcm = dcm();
+
+    snap.rxMaxRate = rxMaxRate();
+    snap.txMaxRate = txMaxRate();
+    snap.linkEfficiency = linkEfficiency();
+    snap.belowCapability = belowCapability();
+
+    snap.rxBytes = info.rxBytes;
+    snap.txBytes = info.txBytes;
+    snap.rxPackets = info.rxPackets;
+    snap.txPackets = info.txPackets;
+
+    snap.txRetries = info.txRetries;
+    snap.txFailed = info.txFailed;
+    snap.rxDropped = info.rxDropMisc;
+    snap.beaconLoss = info.beaconLoss;
+    snap.beaconRx = info.beaconRx;
+    snap.beaconSignalAvg = info.beaconSignalAvg;
+
+    snap.connectedTime = info.connectedTime;
+    snap.inactiveTime = info.inactiveTime;
+    snap.expectedThroughput = info.expectedThroughput;
+
+    snap.ackSignal = info.ackSignal;
+    snap.ackSignalAvg = info.ackSignalAvg;
+    snap.hasAckSignal = info.hasAckSignal;
+
+    snap.rxDuration = info.rxDuration;
+    snap.txDuration = info.txDuration;
+
+    snap.chainSignals.resize(info.chainCount);
+    for (int i = 0; i < info.chainCount; ++i) {
+        snap.chainSignals[i] = StatsEngine::chainSignalDbm(info, i);
+    }
+    snap.chainImbalance = chainImbalance();
+    snap.chainImbalanced = chainImbalanced();
+
+    snap.linkDegraded = linkDegraded();
+
+    Q_EMIT snapshotChanged();
+}
+
+WifiSnapshot WifiMonitor::snapshot() const { return d->snapshot; }
+
 bool WifiMonitor::connected() const { return d->isConnected; }
 bool WifiMonitor::available() const { return d->isAvailable; }
 QString WifiMonitor::ssid() const { return d->cachedSsid; }
 QString WifiMonitor::bssid() const { return d->cachedBssid; }
 
+bool WifiMonitor::hostingStations() const {
+    return Nl80211Helper::isMultiStationInterface(d->interfaceType);
+}
+
+StationModel *WifiMonitor::stations() const { return d->stationModel; }
+MloLinkModel *WifiMonitor::mloLinks() const { return d->linkModel; }
+
 int WifiMonitor::signalDbm() const {
-    return d->stationInfo.signalDbm;
+    const double filtered = d->stats.filteredSignalDbm();
+    // A hysteresis stage only emits values that round into its band.
+    return filtered != 0.0 ? static_cast<int>(std::lround(filtered)) : d->stats.stationInfo().signalDbm;
+}
+
+int WifiMonitor::signalDbmRaw() const {
+    return d->stats.stationInfo().signalDbm;
 }
 
 int WifiMonitor::signalPercent() const {
-    if (!d->stationInfo.valid) return 0;
-    int dbm = d->stationInfo.signalDbm;
+    if (!d->stats.stationInfo().valid) return 0;
+    int dbm = signalDbm();
     if (dbm >= -50) return 100;
     if (dbm <= -100) return 0;
     return 2 * (dbm + 100);
 }
 
 QString WifiMonitor::signalQuality() const {
-    int dbm = signalDbm();
-    if (dbm >= -50) return i18nc("WiFi signal quality", "Excellent");
-    if (dbm >= -60) return i18nc("WiFi signal quality", "Good");
-    if (dbm >= -70) return i18nc("WiFi signal quality", "Fair");
-    if (dbm >= -80) return i18nc("WiFi signal quality", "Weak");
-    return i18nc("WiFi signal quality", "Poor");
+    const int dbm = signalDbm();
+    const int level = dbm >= -50 ? 0 : dbm >= -60 ? 1 : dbm >= -70 ? 2 : dbm >= -80 ? 3 : 4;
+    QString &label = d->qualityLabels[level];
+    if (label.isNull()) {
+        switch (level) {
+            case 0:  label = i18nc("WiFi signal quality", "Excellent"); break;
+            case 1:  label = i18nc("WiFi signal quality", "Good"); break;
+            case 2:  label = i18nc("WiFi signal quality", "Fair"); break;
+            case 3:  label = i18nc("WiFi signal quality", "Weak"); break;
+            default: label = i18nc("WiFi signal quality", "Poor"); break;
+        }
+    }
+    return label;
 }
 
 double WifiMonitor::txRate() const {
-    return d->stationInfo.txBitrate / 10.0;
+    return d->stats.stationInfo().txBitrate / 10.0;
 }
 
 double WifiMonitor::rxRate() const {
-    return d->stationInfo.rxBitrate / 10.0;
+    return d->stats.stationInfo().rxBitrate / 10.0;
 }
 
 QString WifiMonitor::wifiGeneration() const {
-    if (!d->stationInfo.valid) {
-        return i18nc("WiFi generation", "Unknown");
+    if (!d->stats.stationInfo().valid) {
+        if (d->unknownGenerationLabel.isNull()) {
+            d->unknownGenerationLabel = i18nc("WiFi generation", "Unknown");
+        }
+        return d->unknownGenerationLabel;
     }
 
-    const auto mode = d->stationInfo.rxMode != Nl80211StationInfo::WifiMode::Unknown
-        ? d->stationInfo.rxMode
-        : d->stationInfo.txMode;
-
-    switch (mode) {
-        case Nl80211StationInfo::WifiMode::HT:  return i18nc("WiFi generation", "WiFi 4");
-        case Nl80211StationInfo::WifiMode::VHT: return i18nc("WiFi generation", "WiFi 5");
-        case Nl80211StationInfo::WifiMode::HE:  return i18nc("WiFi generation", "WiFi 6");
-        case Nl80211StationInfo::WifiMode::EHT: return i18nc("WiFi generation", "WiFi 7");
-        default:                                return i18nc("WiFi generation", "Legacy");
-    }
+    const auto mode = d->stats.stationInfo().rxMode != Nl80211StationInfo::WifiMode::Unknown
+        ? d->stats.stationInfo().rxMode
+        : d->stats.stationInfo().txMode;
+    return d->generationLabel(mode);
 }
 
 int WifiMonitor::mcsIndex() const {
-    return d->stationInfo.valid ? d->stationInfo.rxMcs : 0;
+    return d->stats.stationInfo().valid ? d->stats.stationInfo().rxMcs : 0;
 }
 
 int WifiMonitor::mimoStreams() const {
-    return d->stationInfo.valid ? d->stationInfo.rxNss : 0;
+    return d->stats.stationInfo().valid ? d->stats.stationInfo().rxNss : 0;
 }
 
 int WifiMonitor::channelWidth() const {
-    if (d->stationInfo.valid && d->stationInfo.rxChannelWidth > 0) {
-        return Nl80211Helper::channelWidthToMhz(d->stationInfo.rxChannelWidth);
+    if (d->stats.stationInfo().valid && d->stats.stationInfo().rxChannelWidth > 0) {
+        return Nl80211Helper::channelWidthToMhz(d->stats.stationInfo().rxChannelWidth);
     }
     return d->cachedChannelWidth;
 }
@@ -376,18 +997,59 @@ int WifiMonitor::channelWidth() const {
 int WifiMonitor::frequency() const { return d->cachedFrequency; }
 
 int WifiMonitor::channel() const {
-    int freq = d->cachedFrequency;
-    if (freq >= 2412 && freq <= 2484) {
-        if (freq == 2484) return 14;
-        return (freq - 2412) / 5 + 1;
+    return d->cachedFrequency > 0 ? Nl80211Helper::frequencyToChannel(static_cast<uint32_t>(d->cachedFrequency)) : 0;
+}
+
+QString WifiMonitor::band() const {
+    WiphyBand::Id id;
+    if (d->cachedFrequency <= 0 || !d->wiphy.bandForFrequency(static_cast<uint32_t>(d->cachedFrequency), id)) {
+        return QString();
     }
-    if (freq >= 5170 && freq <= 5825) {
-        return (freq - 5170) / 5 + 34;
+    return QString::fromLatin1(WiphyCapabilities::bandName(id));
+}
+
+const WiphyBand* WifiMonitor::currentBand() const {
+    WiphyBand::Id id;
+    if (!d->wiphy.valid || d->cachedFrequency <= 0
+        || !d->wiphy.bandForFrequency(static_cast<uint32_t>(d->cachedFrequency), id)) {
+        return nullptr;
     }
-    if (freq >= 5955 && freq <= 7115) {
-        return (freq - 5955) / 5 + 1;
+    const WiphyBand& band = d->wiphy.band(id);
+    return band.present ? &band : nullptr;
+}
+
+QString WifiMonitor::clientMaxGeneration() const {
+    const WiphyBand* band = currentBand();
+    if (!band) {
+        return QString();
     }
-    return 0;
+    return d->generationLabel(band->bestMode());
+}
+
+int WifiMonitor::clientMaxNss() const {
+    const WiphyBand* band = currentBand();
+    return band ? band->maxNss : 0;
+}
+
+int WifiMonitor::clientMaxWidth() const {
+    const WiphyBand* band = currentBand();
+    return band ? band->maxWidthMhz : 0;
+}
+
+double WifiMonitor::clientMaxRate() const {
+    const WiphyBand* band = currentBand();
+    if (!band) {
+        return 0.0;
+    }
+    uint8_t widthCode = 0;
+    switch (band->maxWidthMhz) {
+        case 40:  widthCode = 1; break;
+        case 80:  widthCode = 2; break;
+        case 160: widthCode = 3; break;
+        case 320: widthCode = 5; break;
+        default:  widthCode = 0; break;
+    }
+    return PhyRates::maxRate(band->bestMode(), widthCode, band->maxNss) / 10.0;
 }
 
 QString WifiMonitor::security() const { return d->cachedSecurity; }
@@ -404,28 +1066,530 @@ QString WifiMonitor::statusColor() const {
     return QStringLiteral("#F44336");                  // Poor
 }
 
-QVariantList WifiMonitor::rxHistory() const {
-    QVariantList list;
-    for (double v : d->rxHistoryBuffer) {
-        list.append(v);
+QList<qreal> WifiMonitor::rxHistory() const {
+    return d->stats.rxHistory();
+}
+
+QList<qreal> WifiMonitor::txHistory() const {
+    return d->stats.txHistory();
+}
+
+double WifiMonitor::maxHistoryRate() const {
+    return d->stats.maxHistoryRate();
+}
+
+int WifiMonitor::chartColumns() const {
+    return d->chartColumns;
+}
+
+void WifiMonitor::setChartColumns(int columns) {
+    columns = qMax(1, columns);
+    if (columns == d->chartColumns) {
+        return;
     }
-    return list;
+    d->chartColumns = columns;
+    rebuildChart();
+    Q_EMIT chartColumnsChanged();
+    Q_EMIT chartChanged();
+}
+
+WifiMonitor::ChartWindow WifiMonitor::chartWindow() const {
+    return d->chartWindow;
+}
+
+void WifiMonitor::setChartWindow(ChartWindow window) {
+    if (window == d->chartWindow) {
+        return;
+    }
+    d->chartWindow = window;
+    rebuildChart();
+    Q_EMIT chartWindowChanged();
+    Q_EMIT chartChanged();
+}
+
+double WifiMonitor::chartMaxRate() const {
+    return qMax(d->rxChart.maxValue(100.0), d->txChart.maxValue(100.0));
+}
+
+void WifiMonitor::rebuildChart() {
+    // Column boundaries depend on the width and the window, so replay the retained history.
+    if (d->chartWindow == ChartBurst) {
+        d->rxChart.configure(d->burst.expectedSamples(), d->chartColumns);
+        d->txChart.configure(d->burst.expectedSamples(), d->chartColumns);
+        for (int i = 0; i < d->burst.size(); ++i) {
+            const BurstCapture::Sample &sample = d->burst.at(i);
+            d->rxChart.add(sample.rxBitrate / 10.0);
+            d->txChart.add(sample.txBitrate / 10.0);
+        }
+        return;
+    }
+    if (d->chartWindow == ChartMinute) {
+        d->rxChart.configure(StatsEngine::historySize, d->chartColumns);
+        d->txChart.configure(StatsEngine::historySize, d->chartColumns);
+        for (double v : d->stats.rxHistory()) {
+            d->rxChart.add(v);
+        }
+        for (double v : d->stats.txHistory()) {
+            d->txChart.add(v);
+        }
+        return;
+    }
+
+    const TieredHistory::Tier tier = d->chartWindow == ChartHour ? TieredHistory::Tier::Seconds : TieredHistory::Tier::Minutes;
+    d->rxChart.configure(TieredHistory::capacity(tier), d->chartColumns);
+    d->txChart.configure(TieredHistory::capacity(tier), d->chartColumns);
+    for (int i = 0; i < d->tiers.size(tier); ++i) {
+        const TieredHistory::Bucket &rx = d->tiers.bucket(tier, TieredHistory::Metric::RxRate, i);
+        const TieredHistory::Bucket &tx = d->tiers.bucket(tier, TieredHistory::Metric::TxRate, i);
+        d->rxChart.add(rx.min, rx.max);
+        d->txChart.add(tx.min, tx.max);
+    }
+}
+
+bool WifiMonitor::appendToChart(int committedTiers) {
+    if (d->chartWindow == ChartBurst) {
+        // Fed by onBurstTick() instead.
+        return false;
+    }
+    if (d->chartWindow == ChartMinute) {
+        // The one-minute view keeps showing the smoothed rates, like the history it replaces.
+        d->rxChart.add(d->stats.smoothedRxRate());
+        d->txChart.add(d->stats.smoothedTxRate());
+        return true;
+    }
+
+    const TieredHistory::Tier tier = d->chartWindow == ChartHour ? TieredHistory::Tier::Seconds : TieredHistory::Tier::Minutes;
+    if (!(committedTiers & (1 << static_cast<int>(tier)))) {
+        // The bucket is still filling; the chart only moves when it closes.
+        return false;
+    }
+    const int newest = d->tiers.size(tier) - 1;
+    const TieredHistory::Bucket &rx = d->tiers.bucket(tier, TieredHistory::Metric::RxRate, newest);
+    const TieredHistory::Bucket &tx = d->tiers.bucket(tier, TieredHistory::Metric::TxRate, newest);
+    d->rxChart.add(rx.min, rx.max);
+    d->txChart.add(tx.min, tx.max);
+    return true;
+}
+
+QList<qreal> WifiMonitor::rxChart() const {
+    d->rxChart.points(d->rxChartPoints);
+    return d->rxChartPoints;
+}
+
+QList<qreal> WifiMonitor::txChart() const {
+    d->txChart.points(d->txChartPoints);
+    return d->txChartPoints;
+}
+
+bool WifiMonitor::signalOnly() const {
+    return d->signalOnly;
+}
+
+void WifiMonitor::setSignalOnly(bool signalOnly) {
+    if (d->signalOnly == signalOnly) {
+        return;
+    }
+    d->signalOnly = signalOnly;
+    Q_EMIT signalOnlyChanged();
+    // Bring rates and counters up to date straight away when the popup opens.
+    if (!signalOnly && d->statsTimer && d->statsTimer->isActive()) {
+        updateNl80211Stats();
+    }
+}
+
+QString WifiMonitor::statsBackend() const {
+    return QLatin1String(d->backend->name());
+}
+
+QVariantMap WifiMonitor::rateOccupancy() const {
+    const auto rows = [this](RateOccupancy::Direction direction) {
+        const double total = static_cast<double>(d->occupancy.totalMs(direction));
+        QVariantList list;
+        if (total <= 0.0) {
+            return list;
+        }
+        for (int row = 0; row < RateOccupancy::rowCount; ++row) {
+            const uint64_t rowMs = d->occupancy.rowMs(direction, row);
+            if (rowMs == 0) {
+                continue;
+            }
+            const uint32_t *cells = d->occupancy.row(direction, row);
+            QVariantList shares;
+            shares.reserve(RateOccupancy::mcsCount);
+            for (int mcs = 0; mcs < RateOccupancy::mcsCount; ++mcs) {
+                shares.append(cells[mcs] / total);
+            }
+            list.append(QVariantMap{
+                {QStringLiteral("mode"), d->generationLabel(RateOccupancy::rowMode(row))},
+                {QStringLiteral("width"), RateOccupancy::rowWidthMhz(row)},
+                {QStringLiteral("nss"), RateOccupancy::rowNss(row)},
+                {QStringLiteral("share"), rowMs / total},
+                {QStringLiteral("cells"), shares},
+            });
+        }
+        return list;
+    };
+    return QVariantMap{
+        {QStringLiteral("rx"), rows(RateOccupancy::Direction::Rx)},
+        {QStringLiteral("tx"), rows(RateOccupancy::Direction::Tx)},
+        {QStringLiteral("rxTotalMs"), static_cast<qint64>(d->occupancy.totalMs(RateOccupancy::Direction::Rx))},
+        {QStringLiteral("txTotalMs"), static_cast<qint64>(d->occupancy.totalMs(RateOccupancy::Direction::Tx))},
+    };
+}
+
+void WifiMonitor::resetRateOccupancy() {
+    d->occupancy.reset();
+    d->lastOccupancyMs = 0;
+    Q_EMIT rateOccupancyChanged();
+}
+
+bool WifiMonitor::exporting() const {
+    return d->exporting;
+}
+
+void WifiMonitor::exportHistory(int minutes, const QString &format) {
+    if (d->exporting) {
+        return;
+    }
+
+    const HistoryExport::Format fileFormat = format == QLatin1String("npz")
+        ? HistoryExport::Format::Npz
+        : HistoryExport::Format::Csv;
+
+    const QString path = exportPath(QStringLiteral("truelink"), HistoryExport::fileExtension(fileFormat));
+
+    // The copy is bounded by the tier capacity; the file itself is streamed.
+    HistoryExport::Window window = HistoryExport::capture(d->tiers, qint64(qMax(minutes, 1)) * 60 * 1000);
+
+    d->exporting = true;
+    Q_EMIT exportingChanged();
+
+    d->exportPool.start([this, path, fileFormat, window = std::move(window)]() {
+        QString error;
+        if (window.rows() == 0) {
+            error = i18n("No history recorded yet");
+        } else {
+            HistoryExport::write(path, fileFormat, window, &error);
+        }
+        QMetaObject::invokeMethod(this, [this, path, error]() {
+            d->exporting = false;
+            Q_EMIT exportingChanged();
+            Q_EMIT historyExported(error.isEmpty() ? path : QString(), error);
+        }, Qt::QueuedConnection);
+    });
+}
+
+QVariantMap WifiMonitor::burst() const {
+    return QVariantMap{
+        {QStringLiteral("active"), d->burst.isActive()},
+        {QStringLiteral("trigger"), QLatin1String(BurstCapture::triggerName(d->burst.trigger()))},
+        {QStringLiteral("samples"), d->burst.size()},
+        {QStringLiteral("intervalMs"), d->burst.intervalMs()},
+        {QStringLiteral("durationMs"), d->burst.durationMs()},
+        {QStringLiteral("progress"), d->burst.progress(Profiler::nowNs())},
+        {QStringLiteral("startedAt"), static_cast<qint64>(d->burst.startWallClockMs())},
+    };
+}
+
+int WifiMonitor::burstIntervalMs() const {
+    return d->burstIntervalMs;
+}
+
+void WifiMonitor::setBurstIntervalMs(int intervalMs) {
+    intervalMs = qBound(BurstCapture::minIntervalMs, intervalMs, BurstCapture::maxIntervalMs);
+    if (intervalMs == d->burstIntervalMs) {
+        return;
+    }
+    d->burstIntervalMs = intervalMs;
+    Q_EMIT burstSettingsChanged();
+}
+
+int WifiMonitor::burstDurationMs() const {
+    return d->burstDurationMs;
+}
+
+void WifiMonitor::setBurstDurationMs(int durationMs) {
+    durationMs = qBound(BurstCapture::minDurationMs, durationMs, BurstCapture::maxDurationMs);
+    if (durationMs == d->burstDurationMs) {
+        return;
+    }
+    d->burstDurationMs = durationMs;
+    Q_EMIT burstSettingsChanged();
+}
+
+bool WifiMonitor::burstOnDegradation() const {
+    return d->burstOnDegradation;
+}
+
+void WifiMonitor::setBurstOnDegradation(bool enabled) {
+    if (enabled == d->burstOnDegradation) {
+        return;
+    }
+    d->burstOnDegradation = enabled;
+    Q_EMIT burstSettingsChanged();
+}
+
+bool WifiMonitor::startBurstCapture() {
+    return startBurstCapture(d->burstDurationMs, d->burstIntervalMs, BurstCapture::Trigger::Manual);
+}
+
+bool WifiMonitor::startBurstCapture(int durationMs, int intervalMs, BurstCapture::Trigger trigger) {
+    if (!d->isConnected || (d->session && !d->session->isReady())) {
+        return false;
+    }
+    // 0 picks the configured value.
+    if (!d->burst.start(intervalMs > 0 ? intervalMs : d->burstIntervalMs,
+                        durationMs > 0 ? durationMs : d->burstDurationMs,
+                        trigger, Profiler::nowNs(), QDateTime::currentMSecsSinceEpoch())) {
+        return false;
+    }
+    d->refreshSampledTarget();
+    if (!d->burstTimer) {
+        d->burstTimer = new QTimer(this);
+        d->burstTimer->setTimerType(Qt::PreciseTimer);
+        connect(d->burstTimer, &QTimer::timeout, this, &WifiMonitor::onBurstTick);
+    }
+    d->burstTimer->setInterval(d->burst.intervalMs());
+    d->burstTimer->start();
+    d->burstTicksSinceNotify = 0;
+
+    EventTimeline::record(EventTimeline::Kind::Burst, 1, d->burst.intervalMs(), BurstCapture::triggerName(trigger));
+    if (d->chartWindow == ChartBurst) {
+        rebuildChart();
+        Q_EMIT chartChanged();
+    }
+    Q_EMIT burstChanged();
+    notifyTimeline();
+    return true;
+}
+
+void WifiMonitor::stopBurstCapture() {
+    if (d->burst.isActive()) {
+        finishBurst();
+    }
+}
+
+void WifiMonitor::onBurstTick() {
+    const Tracer::Scope trace("burstTimer", "timer");
+    if (!d->isConnected) {
+        finishBurst();
+        return;
+    }
+    const QByteArray &bssidBytes = d->sampledBssidBytes;
+    const uint8_t *bssidPtr = bssidBytes.size() == 6
+        ? reinterpret_cast<const uint8_t*>(bssidBytes.constData())
+        : nullptr;
+
+    // Always the full-field backend: the point of a burst is the rates and counters.
+    Nl80211StationInfo info;
+    if (d->injectedBackend) {
+        info = d->injectedBackend->sample(d->sampledInterfaceUtf8.constData(), bssidPtr);
+    } else if (d->session && d->session->isReady()) {
+        info = d->nl80211Backend.sample(d->sampledInterfaceUtf8.constData(), bssidPtr);
+        d->session->reportResult(info.valid);
+    }
+
+    const bool running = d->burst.append(Profiler::nowNs(), info);
+    if (d->chartWindow == ChartBurst) {
+        d->rxChart.add(info.valid ? info.rxBitrate / 10.0 : 0.0);
+        d->txChart.add(info.valid ? info.txBitrate / 10.0 : 0.0);
+        Q_EMIT chartChanged();
+    }
+    if (!running) {
+        finishBurst();
+    } else if (++d->burstTicksSinceNotify * d->burst.intervalMs() >= 1000) {
+        d->burstTicksSinceNotify = 0;
+        Q_EMIT burstChanged();
+    }
+}
+
+void WifiMonitor::finishBurst() {
+    d->burstTimer->stop();
+    d->burst.finish();
+    EventTimeline::record(EventTimeline::Kind::Burst, 0, d->burst.size(), BurstCapture::triggerName(d->burst.trigger()));
+    Q_EMIT burstChanged();
+    notifyTimeline();
+}
+
+void WifiMonitor::exportBurst(const QString &format) {
+    if (d->exporting) {
+        return;
+    }
+    if (d->burst.isActive()) {
+        // Copying the buffer now would make the next burst tick detach and
+        // reallocate the whole window.
+        Q_EMIT historyExported(QString(), i18n("A burst capture is still running"));
+        return;
+    }
+
+    const HistoryExport::Format fileFormat = format == QLatin1String("npz")
+        ? HistoryExport::Format::Npz
+        : HistoryExport::Format::Csv;
+
+    const QString path = exportPath(QStringLiteral("truelink-burst"), HistoryExport::fileExtension(fileFormat));
+
+    d->exporting = true;
+    Q_EMIT exportingChanged();
+
+    // At most one full window of samples, shared with d->burst until the next one starts.
+    d->exportPool.start([this, path, fileFormat, capture = d->burst]() {
+        QString error;
+        if (capture.size() == 0) {
+            error = i18n("No burst captured yet");
+        } else {
+            HistoryExport::write(path, fileFormat, capture, &error);
+        }
+        QMetaObject::invokeMethod(this, [this, path, error]() {
+            d->exporting = false;
+            Q_EMIT exportingChanged();
+            Q_EMIT historyExported(error.isEmpty() ? path : QString(), error);
+        }, Qt::QueuedConnection);
+    });
+}
+
+QString WifiMonitor::signalFilter() const {
+    return d->stats.signalFilter();
+}
+
+void WifiMonitor::setSignalFilter(const QString &spec) {
+    if (spec == d->stats.signalFilter()) {
+        return;
+    }
+    QString error;
+    if (!d->stats.setSignalFilter(spec, &error)) {
+        Q_EMIT errorOccurred(i18n("Invalid signal filter: %1", error));
+        return;
+    }
+    Q_EMIT filtersChanged();
+}
+
+QString WifiMonitor::rateFilter() const {
+    return d->stats.rateFilter();
+}
+
+void WifiMonitor::setRateFilter(const QString &spec) {
+    if (spec == d->stats.rateFilter()) {
+        return;
+    }
+    QString error;
+    if (!d->stats.setRateFilter(spec, &error)) {
+        Q_EMIT errorOccurred(i18n("Invalid rate filter: %1", error));
+        return;
+    }
+    Q_EMIT filtersChanged();
+}
+
+QString WifiMonitor::efficiencyFilter() const {
+    return d->stats.efficiencyFilter();
+}
+
+void WifiMonitor::setEfficiencyFilter(const QString &spec) {
+    if (spec == d->stats.efficiencyFilter()) {
+        return;
+    }
+    QString error;
+    if (!d->stats.setEfficiencyFilter(spec, &error)) {
+        Q_EMIT errorOccurred(i18n("Invalid efficiency filter: %1", error));
+        return;
+    }
+    Q_EMIT filtersChanged();
+}
+
+bool WifiMonitor::tracing() const {
+    return Tracer::isEnabled();
 }
 
-QVariantList WifiMonitor::txHistory() const {
+void WifiMonitor::setTracing(bool enabled) {
+    if (enabled == Tracer::isEnabled() || (!enabled && d->traceFromEnvironment)) {
+        return;
+    }
+    if (enabled) {
+        QString error;
+        if (!Tracer::start(exportPath(QStringLiteral("truelink-trace"), "json"), &error)) {
+            Q_EMIT errorOccurred(error);
+            return;
+        }
+    } else {
+        const QString path = Tracer::path();
+        Tracer::stop();
+        Q_EMIT historyExported(path, QString());
+    }
+    Q_EMIT tracingChanged();
+}
+
+QString WifiMonitor::tracePath() const {
+    return Tracer::path();
+}
+
+QVariantList WifiMonitor::timeline() const {
+    EventTimeline::Event events[Private::timelineRows];
+    uint64_t sequences[Private::timelineRows];
+    const int count = EventTimeline::read(events, sequences, Private::timelineRows);
+
     QVariantList list;
-    for (double v : d->txHistoryBuffer) {
-        list.append(v);
+    list.reserve(count);
+    for (int i = count - 1; i >= 0; --i) {
+        const EventTimeline::Event &event = events[i];
+        list.append(QVariantMap{
+            {QStringLiteral("sequence"), static_cast<qulonglong>(sequences[i])},
+            {QStringLiteral("timestamp"), static_cast<qint64>(EventTimeline::wallClockMs(event.timestampNs))},
+            {QStringLiteral("kind"), QLatin1String(EventTimeline::kindName(event.kind))},
+            {QStringLiteral("value"), event.value},
+            {QStringLiteral("value2"), event.value2},
+            {QStringLiteral("detail"), QString::fromUtf8(event.detail)},
+        });
     }
     return list;
 }
 
-double WifiMonitor::maxHistoryRate() const {
-    return d->maxRate;
+void WifiMonitor::exportTimeline() {
+    if (d->exporting) {
+        return;
+    }
+    const QString path = exportPath(QStringLiteral("truelink-events"), "jsonl");
+
+    d->exporting = true;
+    Q_EMIT exportingChanged();
+
+    d->exportPool.start([this, path]() {
+        QString error;
+        EventTimeline::writeJsonLines(path, &error);
+        QMetaObject::invokeMethod(this, [this, path, error]() {
+            d->exporting = false;
+            Q_EMIT exportingChanged();
+            Q_EMIT historyExported(error.isEmpty() ? path : QString(), error);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void WifiMonitor::notifyTimeline() {
+    const uint64_t recorded = EventTimeline::recorded();
+    if (recorded == d->timelineScanned) {
+        return;
+    }
+
+    // A sample marker lands every tick; re-publishing the list for each one
+    // would rebuild every row of the view once a second. Any other event is
+    // shown at once, a run of markers only every timelineSampleRefreshNs.
+    bool changed = recorded - d->timelineScanned > uint64_t(Private::timelineScanBatch);
+    if (!changed) {
+        EventTimeline::Event events[Private::timelineScanBatch];
+        const int count = EventTimeline::read(events, nullptr, Private::timelineScanBatch, d->timelineScanned);
+        changed = std::any_of(events, events + count, [](const EventTimeline::Event &event) {
+            return event.kind != EventTimeline::Kind::Sample;
+        });
+    }
+    d->timelineScanned = recorded;
+
+    const uint64_t now = Profiler::nowNs();
+    if (changed || now - d->timelineNotifiedNs >= Private::timelineSampleRefreshNs) {
+        d->timelineNotifiedNs = now;
+        Q_EMIT timelineChanged();
+    }
 }
 
 int WifiMonitor::historySize() const {
-    return Private::historySize;
+    return StatsEngine::historySize;
 }
 
 int WifiMonitor::updateIntervalMs() const {
@@ -437,73 +1601,197 @@ QString WifiMonitor::lastError() const {
 }
 
 qulonglong WifiMonitor::rxBytes() const {
-    return d->stationInfo.rxBytes;
+    return d->stats.stationInfo().rxBytes;
 }
 
 qulonglong WifiMonitor::txBytes() const {
-    return d->stationInfo.txBytes;
+    return d->stats.stationInfo().txBytes;
 }
 
 quint32 WifiMonitor::rxPackets() const {
-    return d->stationInfo.rxPackets;
+    return d->stats.stationInfo().rxPackets;
 }
 
 quint32 WifiMonitor::txPackets() const {
-    return d->stationInfo.txPackets;
+    return d->stats.stationInfo().txPackets;
 }
 
 quint32 WifiMonitor::txRetries() const {
-    return d->stationInfo.txRetries;
+    return d->stats.stationInfo().txRetries;
 }
 
 quint32 WifiMonitor::txFailed() const {
-    return d->stationInfo.txFailed;
+    return d->stats.stationInfo().txFailed;
 }
 
 quint32 WifiMonitor::rxDropped() const {
-    return d->stationInfo.rxDropMisc;
+    return d->stats.stationInfo().rxDropMisc;
 }
 
 quint32 WifiMonitor::beaconLoss() const {
-    return d->stationInfo.beaconLoss;
+    return d->stats.stationInfo().beaconLoss;
 }
 
 qulonglong WifiMonitor::beaconRx() const {
-    return d->stationInfo.beaconRx;
+    return d->stats.stationInfo().beaconRx;
 }
 
 int WifiMonitor::beaconSignalAvg() const {
-    return d->stationInfo.beaconSignalAvg;
+    return d->stats.stationInfo().beaconSignalAvg;
 }
 
 quint32 WifiMonitor::connectedTime() const {
-    return d->stationInfo.connectedTime;
+    return d->stats.stationInfo().connectedTime;
 }
 
 quint32 WifiMonitor::inactiveTime() const {
-    return d->stationInfo.inactiveTime;
+    return d->stats.stationInfo().inactiveTime;
 }
 
 quint32 WifiMonitor::expectedThroughput() const {
-    return d->stationInfo.expectedThroughput;
+    return d->stats.stationInfo().expectedThroughput;
 }
 
 int WifiMonitor::ackSignal() const {
-    return d->stationInfo.ackSignal;
+    return d->stats.stationInfo().ackSignal;
 }
 
 int WifiMonitor::ackSignalAvg() const {
-    return d->stationInfo.ackSignalAvg;
+    return d->stats.stationInfo().ackSignalAvg;
 }
 
 bool WifiMonitor::hasAckSignal() const {
-    return d->stationInfo.hasAckSignal;
+    return d->stats.stationInfo().hasAckSignal;
 }
 
 qulonglong WifiMonitor::rxDuration() const {
-    return d->stationInfo.rxDuration;
+    return d->stats.stationInfo().rxDuration;
 }
 
 qulonglong WifiMonitor::txDuration() const {
-    return d->stationInfo.txDuration;
+    return d->stats.stationInfo().txDuration;
+}
+
+QVariantList WifiMonitor::chainSignals() const {
+    QVariantList list;
+    const Nl80211StationInfo &info = d->stats.stationInfo();
+    for (int i = 0; i < info.chainCount; ++i) {
+        list.append(StatsEngine::chainSignalDbm(info, i));
+    }
+    return list;
+}
+
+double WifiMonitor::chainImbalance() const {
+    return d->stats.chainImbalanceDb();
+}
+
+bool WifiMonitor::chainImbalanced() const {
+    return d->stats.chainImbalanced();
+}
+
+QVariantList WifiMonitor::chainHistory(int chain) const {
+    QVariantList list;
+    if (chain < 0 || chain >= Nl80211StationInfo::maxChains) {
+        return list;
+    }
+    for (double v : d->stats.chainHistory(chain)) {
+        list.append(v);
+    }
+    return list;
+}
+
+QVariantList WifiMonitor::linkEvents() const {
+    return d->linkEvents;
+}
+
+double WifiMonitor::rxMaxRate() const {
+    return d->stats.rxMaxRate() / 10.0;
+}
+
+double WifiMonitor::txMaxRate() const {
+    return d->stats.txMaxRate() / 10.0;
+}
+
+double WifiMonitor::linkEfficiency() const {
+    return d->stats.smoothedEfficiency();
+}
+
+bool WifiMonitor::belowCapability() const {
+    return d->stats.belowCapability();
+}
+
+QString WifiMonitor::guardInterval() const {
+    const auto &info = d->stats.stationInfo();
+    if (!info.valid || info.rxMode == Nl80211StationInfo::WifiMode::Unknown) {
+        return QString();
+    }
+    QString &label = d->guardIntervalLabels[static_cast<int>(info.rxGuardInterval)];
+    if (label.isNull()) {
+        label = QString::fromLatin1(Nl80211Helper::guardIntervalToString(info.rxGuardInterval));
+    }
+    return label;
+}
+
+bool WifiMonitor::dcm() const {
+    return d->stats.stationInfo().valid && d->stats.stationInfo().rxDcm;
+}
+
+QString WifiMonitor::samplingMode() const {
+    switch (d->samplingMode) {
+    case Private::SamplingMode::Active:  return QStringLiteral("active");
+    case Private::SamplingMode::Battery: return QStringLiteral("battery");
+    case Private::SamplingMode::Idle:    return QStringLiteral("idle");
+    case Private::SamplingMode::Paused:  return QStringLiteral("paused");
+    case Private::SamplingMode::Stopped: break;
+    }
+    return QStringLiteral("stopped");
+}
+
+int WifiMonitor::wakeupsPerHour() const {
+    return d->wakeups.perHour(d->uptime.elapsed());
+}
+
+QVariantMap WifiMonitor::nl80211Session() const {
+    if (!d->session) {
+        return {};
+    }
+    const Nl80211Session &session = *d->session;
+    return QVariantMap{
+        {QStringLiteral("state"), QLatin1String(Nl80211Session::stateName(session.state()))},
+        {QStringLiteral("failure"), QLatin1String(Nl80211Session::failureName(session.failure()))},
+        {QStringLiteral("attempts"), session.attempts()},
+        {QStringLiteral("retryInMs"), session.retryInMs()},
+        {QStringLiteral("overruns"), static_cast<qulonglong>(session.overruns())},
+        {QStringLiteral("recoveries"), static_cast<qulonglong>(session.recoveries())},
+    };
+}
+
+QVariantMap WifiMonitor::profile() const {
+    QVariantMap stages;
+    for (int i = 0; i < Profiler::stageCount; ++i) {
+        const auto stage = static_cast<Profiler::Stage>(i);
+        const Profiler::Histogram h = Profiler::histogram(stage);
+        stages.insert(QLatin1String(Profiler::stageName(stage)), QVariantMap{
+            {QStringLiteral("count"), static_cast<qulonglong>(h.count)},
+            {QStringLiteral("meanUs"), h.meanNs() / 1000.0},
+            {QStringLiteral("p50Us"), h.percentileNs(0.5) / 1000.0},
+            {QStringLiteral("p99Us"), h.percentileNs(0.99) / 1000.0},
+            {QStringLiteral("maxUs"), h.maxNs / 1000.0},
+        });
+    }
+
+    QVariantMap counters;
+    for (int i = 0; i < Profiler::counterCount; ++i) {
+        const auto counter = static_cast<Profiler::Counter>(i);
+        counters.insert(QLatin1String(Profiler::counterName(counter)), static_cast<qulonglong>(Profiler::counter(counter)));
+    }
+
+    return QVariantMap{
+        {QStringLiteral("stages"), stages},
+        {QStringLiteral("counters"), counters},
+    };
+}
+
+bool WifiMonitor::linkDegraded() const {
+    return d->stats.linkDegraded();
 }
@@ -1,9 +1,21 @@
 #pragma once
 
+#include <QList>
 #include <QObject>
 #include <QQmlEngine>
 #include <QString>
 #include <QVariantList>
+#include <QVariantMap>
+
+#include <memory>
+
+#include "burstcapture.h"
+#include "mlolinkmodel.h"
+#include "stationmodel.h"
+#include "wifisnapshot.h"
+
+class StatsBackend;
+struct WiphyBand;
 
 /**
  * @brief WiFi physical layer data exposed to QML
@@ -17,14 +29,19 @@ class WifiMonitor : public QObject
     QML_ELEMENT
     QML_SINGLETON
 
+    // All per-tick statistics as one consistent value; prefer it over the properties below.
+    Q_PROPERTY(WifiSnapshot snapshot READ snapshot NOTIFY snapshotChanged)
+
     // Connection state
     Q_PROPERTY(bool connected READ connected NOTIFY connectionChanged)
     Q_PROPERTY(bool available READ available NOTIFY availabilityChanged)
     Q_PROPERTY(QString ssid READ ssid NOTIFY connectionChanged)
     Q_PROPERTY(QString bssid READ bssid NOTIFY connectionChanged)
 
-    // Signal strength
+    // Signal strength. signalDbm, and everything derived from it, has been
+    // through signalFilter; signalDbmRaw is the last sample as reported.
     Q_PROPERTY(int signalDbm READ signalDbm NOTIFY statsUpdated)
+    Q_PROPERTY(int signalDbmRaw READ signalDbmRaw NOTIFY statsUpdated)
     Q_PROPERTY(int signalPercent READ signalPercent NOTIFY statsUpdated)
     Q_PROPERTY(QString signalQuality READ signalQuality NOTIFY statsUpdated)
 
@@ -41,6 +58,21 @@ class WifiMonitor : public QObject
     // Frequency/Channel
     Q_PROPERTY(int frequency READ frequency NOTIFY connectionChanged)
     Q_PROPERTY(int channel READ channel NOTIFY connectionChanged)
+    Q_PROPERTY(QString band READ band NOTIFY connectionChanged)
+
+    // Best the local radio can do on the current band, from the cached wiphy capabilities.
+    Q_PROPERTY(QString clientMaxGeneration READ clientMaxGeneration NOTIFY connectionChanged)
+    Q_PROPERTY(int clientMaxNss READ clientMaxNss NOTIFY connectionChanged)
+    Q_PROPERTY(int clientMaxWidth READ clientMaxWidth NOTIFY connectionChanged)
+    Q_PROPERTY(double clientMaxRate READ clientMaxRate NOTIFY connectionChanged)
+
+    // AP, mesh and P2P-GO interfaces: one row per associated peer.
+    Q_PROPERTY(bool hostingStations READ hostingStations NOTIFY connectionChanged)
+    Q_PROPERTY(StationModel *stations READ stations CONSTANT)
+
+    // Wi-Fi 7 MLO: one row per affiliated link, empty for single-link associations.
+    // txRate/rxRate are then the sum over the links.
+    Q_PROPERTY(MloLinkModel *mloLinks READ mloLinks CONSTANT)
 
     // Security
     Q_PROPERTY(QString security READ security NOTIFY connectionChanged)
@@ -51,10 +83,62 @@ class WifiMonitor : public QObject
 
     Q_PROPERTY(QString statusColor READ statusColor NOTIFY statsUpdated)
 
-    Q_PROPERTY(QVariantList rxHistory READ rxHistory NOTIFY statsUpdated)
-    Q_PROPERTY(QVariantList txHistory READ txHistory NOTIFY statsUpdated)
+    Q_PROPERTY(QList<qreal> rxHistory READ rxHistory NOTIFY statsUpdated)
+    Q_PROPERTY(QList<qreal> txHistory READ txHistory NOTIFY statsUpdated)
     Q_PROPERTY(double maxHistoryRate READ maxHistoryRate NOTIFY statsUpdated)
 
+    // Chart-ready history: at most two (x, rate) pairs per column, flattened as
+    // [x0, y0, x1, y1, ...] with x in 0..1. Set chartColumns to the plot width in pixels.
+    // The lists share storage that is refilled in place on every read, so a
+    // reader that drops its copy before the next one costs no allocation.
+    Q_PROPERTY(int chartColumns READ chartColumns WRITE setChartColumns NOTIFY chartColumnsChanged)
+    // Time span the chart covers: last minute (smoothed), last hour (per-second min/max), last day
+    // (per-minute min/max) or the last burst capture (raw samples).
+    Q_PROPERTY(ChartWindow chartWindow READ chartWindow WRITE setChartWindow NOTIFY chartWindowChanged)
+    Q_PROPERTY(QList<qreal> rxChart READ rxChart NOTIFY chartChanged)
+    Q_PROPERTY(QList<qreal> txChart READ txChart NOTIFY chartChanged)
+    Q_PROPERTY(double chartMaxRate READ chartMaxRate NOTIFY chartChanged)
+
+    // Set by the UI while nothing but the signal level is on screen (popup
+    // closed, panel label without rate). Sampling then uses the cheapest
+    // backend that reports the signal and leaves the rate history alone.
+    Q_PROPERTY(bool signalOnly READ signalOnly WRITE setSignalOnly NOTIFY signalOnlyChanged)
+    // Backend that took the last sample: nl80211, proc or sysfs.
+    Q_PROPERTY(QString statsBackend READ statsBackend NOTIFY statsUpdated)
+
+    // Time share of each rate since the connection came up, see RateOccupancy:
+    // {rx, tx, rxTotalMs, txTotalMs}. rx and tx list the occupied rows as
+    // {mode, width, nss, share, cells}, cells being the share per MCS 0-15.
+    // Notified every few seconds rather than per sample.
+    Q_PROPERTY(QVariantMap rateOccupancy READ rateOccupancy NOTIFY rateOccupancyChanged)
+
+    // True while exportHistory() or exportTimeline() is writing a file in the background.
+    Q_PROPERTY(bool exporting READ exporting NOTIFY exportingChanged)
+
+    // Burst capture: {active, trigger, samples, intervalMs, durationMs, progress, startedAt}.
+    Q_PROPERTY(QVariantMap burst READ burst NOTIFY burstChanged)
+    // Parameters for startBurstCapture() and for bursts the degradation detector starts.
+    Q_PROPERTY(int burstIntervalMs READ burstIntervalMs WRITE setBurstIntervalMs NOTIFY burstSettingsChanged)
+    Q_PROPERTY(int burstDurationMs READ burstDurationMs WRITE setBurstDurationMs NOTIFY burstSettingsChanged)
+    Q_PROPERTY(bool burstOnDegradation READ burstOnDegradation WRITE setBurstOnDegradation NOTIFY burstSettingsChanged)
+
+    // SignalFilter specs for the signal, for the PHY rates (history, chart,
+    // smoothed rates) and for the link efficiency behind belowCapability.
+    // An invalid spec is reported through errorOccurred() and the previous
+    // one kept.
+    Q_PROPERTY(QString signalFilter READ signalFilter WRITE setSignalFilter NOTIFY filtersChanged)
+    Q_PROPERTY(QString rateFilter READ rateFilter WRITE setRateFilter NOTIFY filtersChanged)
+    Q_PROPERTY(QString efficiencyFilter READ efficiencyFilter WRITE setEfficiencyFilter NOTIFY filtersChanged)
+
+    // Chrome trace-event spans of the sampling pipeline, see Tracer. Turning
+    // it on starts a new file in the download folder; TRUELINK_TRACE=<path>
+    // (or 1) starts one at launch that stays on until plasmashell exits.
+    Q_PROPERTY(bool tracing READ tracing WRITE setTracing NOTIFY tracingChanged)
+    Q_PROPERTY(QString tracePath READ tracePath NOTIFY tracingChanged)
+
+    // Newest EventTimeline entries first: {sequence, timestamp, kind, value, value2, detail}.
+    Q_PROPERTY(QVariantList timeline READ timeline NOTIFY timelineChanged)
+
     // Constants used by the UI.
     Q_PROPERTY(int historySize READ historySize CONSTANT)
     Q_PROPERTY(int updateIntervalMs READ updateIntervalMs CONSTANT)
@@ -85,10 +169,54 @@ class WifiMonitor : public QObject
     Q_PROPERTY(qulonglong rxDuration READ rxDuration NOTIFY statsUpdated)
     Q_PROPERTY(qulonglong txDuration READ txDuration NOTIFY statsUpdated)
 
+    // Per-antenna chain signal (dBm) and the spread between chains over the history window.
+    Q_PROPERTY(QVariantList chainSignals READ chainSignals NOTIFY statsUpdated)
+    Q_PROPERTY(double chainImbalance READ chainImbalance NOTIFY statsUpdated)
+    Q_PROPERTY(bool chainImbalanced READ chainImbalanced NOTIFY statsUpdated)
+
+    // Theoretical best rate for the negotiated mode/width/NSS (Mbps) and how much of it is used.
+    Q_PROPERTY(double rxMaxRate READ rxMaxRate NOTIFY statsUpdated)
+    Q_PROPERTY(double txMaxRate READ txMaxRate NOTIFY statsUpdated)
+    Q_PROPERTY(double linkEfficiency READ linkEfficiency NOTIFY statsUpdated)
+    Q_PROPERTY(bool belowCapability READ belowCapability NOTIFY statsUpdated)
+    Q_PROPERTY(QString guardInterval READ guardInterval NOTIFY statsUpdated)
+    Q_PROPERTY(bool dcm READ dcm NOTIFY statsUpdated)
+
+    // Sampling scheduler state (active, battery, idle, paused, stopped) and its timer wakeups over the last hour.
+    Q_PROPERTY(QString samplingMode READ samplingMode NOTIFY samplingModeChanged)
+    Q_PROPERTY(int wakeupsPerHour READ wakeupsPerHour NOTIFY statsUpdated)
+
+    // Debug block: per-stage timings {count, meanUs, p50Us, p99Us, maxUs} and error counters.
+    Q_PROPERTY(QVariantMap profile READ profile NOTIFY statsUpdated)
+    // nl80211 session health: state, failure, attempts, retryInMs, overruns, recoveries.
+    Q_PROPERTY(QVariantMap nl80211Session READ nl80211Session NOTIFY nl80211SessionChanged)
+
+    // Degradation/recovery events from the change-point detector, newest first.
+    Q_PROPERTY(QVariantList linkEvents READ linkEvents NOTIFY linkEventsChanged)
+    Q_PROPERTY(bool linkDegraded READ linkDegraded NOTIFY statsUpdated)
+
 public:
+    enum ChartWindow {
+        ChartMinute = 0,
+        ChartHour,
+        ChartDay,
+        ChartBurst,
+    };
+    Q_ENUM(ChartWindow)
+
     explicit WifiMonitor(QObject *parent = nullptr);
+#ifdef TRUELINK_BENCH
+    // Samples @p backend every @p intervalMs instead of asking NetworkManager
+    // and nl80211, with @p historySeconds of synthetic long-term history
+    // back-filled. Only in the benchmark and test builds.
+    WifiMonitor(std::unique_ptr<StatsBackend> backend, int intervalMs, int historySeconds, QObject *parent = nullptr);
+    // Runs one sampling tick now, exactly as the timer does.
+    void sampleNow();
+#endif
     ~WifiMonitor() override;
 
+    [[nodiscard]] WifiSnapshot snapshot() const;
+
     // Connection state
     [[nodiscard]] bool connected() const;
     [[nodiscard]] bool available() const;
@@ -97,6 +225,7 @@ public:
 
     // Signal
     [[nodiscard]] int signalDbm() const;
+    [[nodiscard]] int signalDbmRaw() const;
     [[nodiscard]] int signalPercent() const;
     [[nodiscard]] QString signalQuality() const;
 
@@ -113,6 +242,16 @@ public:
     // Frequency
     [[nodiscard]] int frequency() const;
     [[nodiscard]] int channel() const;
+    [[nodiscard]] QString band() const;
+
+    [[nodiscard]] QString clientMaxGeneration() const;
+    [[nodiscard]] int clientMaxNss() const;
+    [[nodiscard]] int clientMaxWidth() const;
+    [[nodiscard]] double clientMaxRate() const;
+
+    [[nodiscard]] bool hostingStations() const;
+    [[nodiscard]] StationModel *stations() const;
+    [[nodiscard]] MloLinkModel *mloLinks() const;
 
     // Security & IP
     [[nodiscard]] QString security() const;
@@ -122,10 +261,68 @@ public:
     // UI Helper
     [[nodiscard]] QString statusColor() const;
 
-    [[nodiscard]] QVariantList rxHistory() const;
-    [[nodiscard]] QVariantList txHistory() const;
+    [[nodiscard]] QList<qreal> rxHistory() const;
+    [[nodiscard]] QList<qreal> txHistory() const;
     [[nodiscard]] double maxHistoryRate() const;
 
+    [[nodiscard]] int chartColumns() const;
+    void setChartColumns(int columns);
+    [[nodiscard]] ChartWindow chartWindow() const;
+    void setChartWindow(ChartWindow window);
+    [[nodiscard]] double chartMaxRate() const;
+    [[nodiscard]] QList<qreal> rxChart() const;
+    [[nodiscard]] QList<qreal> txChart() const;
+
+    [[nodiscard]] bool signalOnly() const;
+    void setSignalOnly(bool signalOnly);
+    [[nodiscard]] QString statsBackend() const;
+
+    [[nodiscard]] QVariantMap rateOccupancy() const;
+    Q_INVOKABLE void resetRateOccupancy();
+
+    [[nodiscard]] bool exporting() const;
+    /**
+     * Writes the last @p minutes of history to the download folder as
+     * @p format ("csv" or "npz") on a worker thread, then emits historyExported().
+     */
+    Q_INVOKABLE void exportHistory(int minutes, const QString &format);
+
+    [[nodiscard]] QVariantMap burst() const;
+    [[nodiscard]] int burstIntervalMs() const;
+    void setBurstIntervalMs(int intervalMs);
+    [[nodiscard]] int burstDurationMs() const;
+    void setBurstDurationMs(int durationMs);
+    [[nodiscard]] bool burstOnDegradation() const;
+    void setBurstOnDegradation(bool enabled);
+    /**
+     * Samples every burstIntervalMs, unsmoothed, for burstDurationMs into a
+     * preallocated buffer, alongside the regular tick. Returns false if a
+     * burst is already running or there is no link to sample.
+     */
+    Q_INVOKABLE bool startBurstCapture();
+    // Zero @p durationMs or @p intervalMs means the configured value.
+    bool startBurstCapture(int durationMs, int intervalMs, BurstCapture::Trigger trigger);
+    Q_INVOKABLE void stopBurstCapture();
+    // Writes the last burst to the download folder as @p format ("csv" or "npz"), then emits historyExported().
+    // Refused while a burst is still running.
+    Q_INVOKABLE void exportBurst(const QString &format);
+
+    [[nodiscard]] QString signalFilter() const;
+    void setSignalFilter(const QString &spec);
+    [[nodiscard]] QString rateFilter() const;
+    void setRateFilter(const QString &spec);
+    [[nodiscard]] QString efficiencyFilter() const;
+    void setEfficiencyFilter(const QString &spec);
+
+    [[nodiscard]] bool tracing() const;
+    // Stopping reports the finished file through historyExported().
+    void setTracing(bool enabled);
+    [[nodiscard]] QString tracePath() const;
+
+    [[nodiscard]] QVariantList timeline() const;
+    // Writes the whole event timeline to the download folder as JSON lines, then emits historyExported().
+    Q_INVOKABLE void exportTimeline();
+
     [[nodiscard]] int historySize() const;
     [[nodiscard]] int updateIntervalMs() const;
     [[nodiscard]] QString lastError() const;
@@ -153,23 +350,85 @@ public:
     [[nodiscard]] qulonglong rxDuration() const;
     [[nodiscard]] qulonglong txDuration() const;
 
+    [[nodiscard]] QVariantList chainSignals() const;
+    [[nodiscard]] double chainImbalance() const;
+    [[nodiscard]] bool chainImbalanced() const;
+    Q_INVOKABLE QVariantList chainHistory(int chain) const;
+
+    [[nodiscard]] double rxMaxRate() const;
+    [[nodiscard]] double txMaxRate() const;
+    [[nodiscard]] double linkEfficiency() const;
+    [[nodiscard]] bool belowCapability() const;
+    [[nodiscard]] QString guardInterval() const;
+    [[nodiscard]] bool dcm() const;
+
+    [[nodiscard]] QString samplingMode() const;
+    [[nodiscard]] int wakeupsPerHour() const;
+
+    [[nodiscard]] QVariantMap profile() const;
+    [[nodiscard]] QVariantMap nl80211Session() const;
+
+    [[nodiscard]] QVariantList linkEvents() const;
+    [[nodiscard]] bool linkDegraded() const;
+
 Q_SIGNALS:
     void connectionChanged();
     void availabilityChanged();
     void statsUpdated();
+    void snapshotChanged();
     void errorOccurred(const QString &message);
     void lastErrorChanged();
+    void linkEventsChanged();
+    void samplingModeChanged();
+    void chartColumnsChanged();
+    void chartWindowChanged();
+    void chartChanged();
+    void signalOnlyChanged();
+    void rateOccupancyChanged();
+    void exportingChanged();
+    void burstChanged();
+    void burstSettingsChanged();
+    // @p error is empty on success.
+    void historyExported(const QString &path, const QString &error);
+    void timelineChanged();
+    void tracingChanged();
+    void filtersChanged();
+    void nl80211SessionChanged();
+
+    /**
+     * Emitted when a metric (signal, retryRatio, beaconLoss, ackSignal) degrades or recovers.
+     * @p event holds timestamp (ms since epoch), metric, degraded, value and baseline.
+     */
+    void linkEvent(const QVariantMap &event);
 
 private Q_SLOTS:
     void onActiveConnectionChanged();
     void onDeviceStateChanged();
     void updateNl80211Stats();
+    void onStatsTimerTimeout();
+    void applySamplingPolicy();
+    void invalidateWiphy();
+    void onWiphyChanged(int wiphyIndex);
+    void onInterfaceChanged(int ifindex, int wiphyIndex);
+    void onSessionStateChanged();
+    void onBurstTick();
 
 private:
     void initNetworkManager();
-    void initNl80211();
     void startStatsTimer();
+    void finishBurst();
     void stopStatsTimer();
+    void updateSnapshot();
+    void refreshWiphy();
+    void updateStations();
+    void rebuildChart();
+    // Whether the chart got a new point and QML has to redraw it.
+    bool appendToChart(int committedTiers);
+    // Reports the detector's events of the last sample and starts a burst
+    // on a degradation if that is enabled.
+    void publishLinkEvents();
+    void notifyTimeline();
+    [[nodiscard]] const WiphyBand* currentBand() const;
 
     class Private;
     QScopedPointer<Private> d;
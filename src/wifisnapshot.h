@@ -0,0 +1,136 @@
+#pragma once
+
+#include <QMetaType>
+#include <QString>
+#include <QVariantList>
+#include <QtGlobal>
+
+/**
+ * @brief One consistent copy of the per-tick link statistics
+ *
+ * Built once per sample by WifiMonitor and handed to QML by value, so every
+ * field a view reads comes from the same tick. Bindings read plain struct
+ * members instead of going through a metacall per value, and the copy stays
+ * valid even if the next sample is produced on another thread.
+ */
+class WifiSnapshot
+{
+    Q_GADGET
+
+    Q_PROPERTY(quint64 sequence MEMBER sequence CONSTANT)
+    Q_PROPERTY(qint64 timestampMs MEMBER timestampMs CONSTANT)
+    Q_PROPERTY(bool valid MEMBER valid CONSTANT)
+
+    Q_PROPERTY(int signalDbm MEMBER signalDbm CONSTANT)
+    Q_PROPERTY(int signalDbmRaw MEMBER signalDbmRaw CONSTANT)
+    Q_PROPERTY(int signalPercent MEMBER signalPercent CONSTANT)
+    Q_PROPERTY(QString signalQuality MEMBER signalQuality CONSTANT)
+    Q_PROPERTY(QString statusColor MEMBER statusColor CONSTANT)
+
+    Q_PROPERTY(double rxRate MEMBER rxRate CONSTANT)
+    Q_PROPERTY(double txRate MEMBER txRate CONSTANT)
+    Q_PROPERTY(double rxRateSmoothed MEMBER rxRateSmoothed CONSTANT)
+    Q_PROPERTY(double txRateSmoothed MEMBER txRateSmoothed CONSTANT)
+    Q_PROPERTY(double maxHistoryRate MEMBER maxHistoryRate CONSTANT)
+
+    Q_PROPERTY(QString wifiGeneration MEMBER wifiGeneration CONSTANT)
+    Q_PROPERTY(int mcsIndex MEMBER mcsIndex CONSTANT)
+    Q_PROPERTY(int mimoStreams MEMBER mimoStreams CONSTANT)
+    Q_PROPERTY(int channelWidth MEMBER channelWidth CONSTANT)
+    Q_PROPERTY(QString guardInterval MEMBER guardInterval CONSTANT)
+    Q_PROPERTY(bool dcm MEMBER dcm CONSTANT)
+
+    Q_PROPERTY(double rxMaxRate MEMBER rxMaxRate CONSTANT)
+    Q_PROPERTY(double txMaxRate MEMBER txMaxRate CONSTANT)
+    Q_PROPERTY(double linkEfficiency MEMBER linkEfficiency CONSTANT)
+    Q_PROPERTY(bool belowCapability MEMBER belowCapability CONSTANT)
+
+    Q_PROPERTY(qulonglong rxBytes MEMBER rxBytes CONSTANT)
+    Q_PROPERTY(qulonglong txBytes MEMBER txBytes CONSTANT)
+    Q_PROPERTY(quint32 rxPackets MEMBER rxPackets CONSTANT)
+    Q_PROPERTY(quint32 txPackets MEMBER txPackets CONSTANT)
+
+    Q_PROPERTY(quint32 txRetries MEMBER txRetries CONSTANT)
+    Q_PROPERTY(quint32 txFailed MEMBER txFailed CONSTANT)
+    Q_PROPERTY(quint32 rxDropped MEMBER rxDropped CONSTANT)
+    Q_PROPERTY(quint32 beaconLoss MEMBER beaconLoss CONSTANT)
+    Q_PROPERTY(qulonglong beaconRx MEMBER beaconRx CONSTANT)
+    Q_PROPERTY(int beaconSignalAvg MEMBER beaconSignalAvg CONSTANT)
+
+    Q_PROPERTY(quint32 connectedTime MEMBER connectedTime CONSTANT)
+    Q_PROPERTY(quint32 inactiveTime MEMBER inactiveTime CONSTANT)
+    Q_PROPERTY(quint32 expectedThroughput MEMBER expectedThroughput CONSTANT)
+
+    Q_PROPERTY(int ackSignal MEMBER ackSignal CONSTANT)
+    Q_PROPERTY(int ackSignalAvg MEMBER ackSignalAvg CONSTANT)
+    Q_PROPERTY(bool hasAckSignal MEMBER hasAckSignal CONSTANT)
+
+    Q_PROPERTY(qulonglong rxDuration MEMBER rxDuration CONSTANT)
+    Q_PROPERTY(qulonglong txDuration MEMBER txDuration CONSTANT)
+
+    Q_PROPERTY(QVariantList chainSignals MEMBER chainSignals CONSTANT)
+    Q_PROPERTY(double chainImbalance MEMBER chainImbalance CONSTANT)
+    Q_PROPERTY(bool chainImbalanced MEMBER chainImbalanced CONSTANT)
+
+    Q_PROPERTY(bool linkDegraded MEMBER linkDegraded CONSTANT)
+
+public:
+    quint64 sequence = 0;   // increments once per published snapshot
+    qint64 timestampMs = 0; // sample time, ms since epoch
+    bool valid = false;
+
+    int signalDbm = 0;    // filtered
+    int signalDbmRaw = 0;
+    int signalPercent = 0;
+    QString signalQuality;
+    QString statusColor;
+
+    double rxRate = 0.0;
+    double txRate = 0.0;
+    double rxRateSmoothed = 0.0;
+    double txRateSmoothed = 0.0;
+    double maxHistoryRate = 0.0;
+
+    QString wifiGeneration;
+    int mcsIndex = 0;
+    int mimoStreams = 0;
+    int channelWidth = 0;
+    QString guardInterval;
+    bool dcm = false;
+
+    double rxMaxRate = 0.0;
+    double txMaxRate = 0.0;
+    double linkEfficiency = 0.0;
+    bool belowCapability = false;
+
+    qulonglong rxBytes = 0;
+    qulonglong txBytes = 0;
+    quint32 rxPackets = 0;
+    quint32 txPackets = 0;
+
+    quint32 txRetries = 0;
+    quint32 txFailed = 0;
+    quint32 rxDropped = 0;
+    quint32 beaconLoss = 0;
+    qulonglong beaconRx = 0;
+    int beaconSignalAvg = 0;
+
+    quint32 connectedTime = 0;
+    quint32 inactiveTime = 0;
+    quint32 expectedThroughput = 0;
+
+    int ackSignal = 0;
+    int ackSignalAvg = 0;
+    bool hasAckSignal = false;
+
+    qulonglong rxDuration = 0;
+    qulonglong txDuration = 0;
+
+    QVariantList chainSignals;
+    double chainImbalance = 0.0;
+    bool chainImbalanced = false;
+
+    bool linkDegraded = false;
+};
+
+Q_DECLARE_METATYPE(WifiSnapshot)
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "nl80211helper.h"
+
+#include <QString>
+#include <QVector>
+
+#include <cstdint>
+
+/**
+ * @brief What the local radio supports, per band
+ *
+ * Filled once from an NL80211_CMD_GET_WIPHY split dump and cached until the
+ * kernel reports a wiphy change. Nothing here is read per tick except
+ * through the cached values.
+ */
+struct WiphyBand {
+    // Matches enum nl80211_band.
+    enum class Id : uint8_t {
+        Band2GHz = 0,
+        Band5GHz,
+        Band60GHz,
+        Band6GHz,
+        BandS1GHz,
+    };
+    static constexpr int count = 5;
+
+    bool present = false;
+
+    bool ht = false;
+    bool vht = false;
+    bool he = false;
+    bool eht = false;
+
+    // Highest receive NSS over all supported modes.
+    uint8_t maxNss = 0;
+
+    // Widest channel the station side supports, in MHz.
+    int maxWidthMhz = 20;
+
+    // Enabled (not regulatory-disabled) channel centre frequencies, MHz.
+    QVector<uint32_t> frequencies;
+
+    // Best PHY mode the band supports, Unknown for legacy-only bands.
+    [[nodiscard]] Nl80211StationInfo::WifiMode bestMode() const
+    {
+        if (eht) return Nl80211StationInfo::WifiMode::EHT;
+        if (he) return Nl80211StationInfo::WifiMode::HE;
+        if (vht) return Nl80211StationInfo::WifiMode::VHT;
+        if (ht) return Nl80211StationInfo::WifiMode::HT;
+        return Nl80211StationInfo::WifiMode::Unknown;
+    }
+};
+
+struct WiphyCapabilities {
+    bool valid = false;
+    int wiphyIndex = -1;
+    QString name;
+
+    WiphyBand bands[WiphyBand::count];
+
+    [[nodiscard]] const WiphyBand &band(WiphyBand::Id id) const
+    {
+        return bands[static_cast<int>(id)];
+    }
+
+    // Band that lists @p frequencyMhz, or the band implied by the frequency
+    // range when the radio does not advertise it. Returns false if neither applies.
+    [[nodiscard]] bool bandForFrequency(uint32_t frequencyMhz, WiphyBand::Id &id) const
+    {
+        for (int i = 0; i < WiphyBand::count; ++i) {
+            if (bands[i].frequencies.contains(frequencyMhz)) {
+                id = static_cast<WiphyBand::Id>(i);
+                return true;
+            }
+        }
+        return bandFromRange(frequencyMhz, id);
+    }
+
+    static bool bandFromRange(uint32_t frequencyMhz, WiphyBand::Id &id)
+    {
+        if (frequencyMhz >= 2400 && frequencyMhz <= 2500) {
+            id = WiphyBand::Id::Band2GHz;
+        } else if (frequencyMhz >= 4900 && frequencyMhz < 5925) {
+            id = WiphyBand::Id::Band5GHz;
+        } else if (frequencyMhz >= 5925 && frequencyMhz <= 7125) {
+            id = WiphyBand::Id::Band6GHz;
+        } else if (frequencyMhz >= 57000 && frequencyMhz <= 71000) {
+            id = WiphyBand::Id::Band60GHz;
+        } else if (frequencyMhz < 1000) {
+            id = WiphyBand::Id::BandS1GHz;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    static const char *bandName(WiphyBand::Id id)
+    {
+        switch (id) {
+            case WiphyBand::Id::Band2GHz:  return "2.4 GHz";
+            case WiphyBand::Id::Band5GHz:  return "5 GHz";
+            case WiphyBand::Id::Band60GHz: return "60 GHz";
+            case WiphyBand::Id::Band6GHz:  return "6 GHz";
+            case WiphyBand::Id::BandS1GHz: return "Sub-1 GHz";
+        }
+        return "";
+    }
+};